@@ -0,0 +1,81 @@
+"""Comparisons, count and index on a DoublyLinkedList next to a list.
+
+Equality is timed against another DoublyLinkedList, a list, a tuple and a generic iterable, with
+equal lengths and with lengths that differ. Ordering is timed for each of <, <=, > and >= with the
+lists differing only in the last item. Every case runs for lists of ints, floats, strs and of
+objects without a fast path.
+
+Run with: python benchmarks/bench_compare.py
+"""
+import functools
+import timeit
+
+from py_doubly_linked_list import DoublyLinkedList
+
+N = 100_000
+REPEAT = 5
+
+
+@functools.total_ordering
+class Item:
+    __slots__ = ("value",)
+
+    def __init__(self, value):
+        self.value = value
+
+    def __eq__(self, other):
+        return self.value == other.value
+
+    def __lt__(self, other):
+        return self.value < other.value
+
+    def __hash__(self):
+        return hash(self.value)
+
+
+KINDS = {
+    "int": lambda i: i,
+    "float": lambda i: i + 0.5,
+    "str": lambda i: f"item{i}",
+    "object": Item,
+}
+
+
+def make_items(kind):
+    # Equal but distinct items, so identity checks don't decide the comparisons
+    convert = KINDS[kind]
+    return [convert(i) for i in range(N)], [convert(i) for i in range(N)]
+
+
+def main():
+    for kind in KINDS:
+        items, other_items = make_items(kind)
+        convert = KINDS[kind]
+        greater = other_items[:-1] + [convert(N)]
+        dll_other = DoublyLinkedList(other_items)
+        tuple_other = tuple(other_items)
+        shorter = other_items[:-1]
+        for name, seq in (("list", list(items)), ("dll", DoublyLinkedList(items))):
+            benches = [
+                ("== DoublyLinkedList", lambda: seq == dll_other),
+                ("== list", lambda: seq == other_items),
+                ("== tuple", lambda: seq == tuple_other),
+                ("== iterator", lambda: seq == iter(other_items)),
+                ("== shorter list", lambda: seq == shorter),
+                ("< list", lambda: seq < greater),
+                ("<= list", lambda: seq <= greater),
+                ("> list", lambda: seq > greater),
+                (">= list", lambda: seq >= greater),
+                ("count", lambda: seq.count(other_items[-1])),
+                ("index", lambda: seq.index(other_items[-1])),
+            ]
+            for bench, func in benches:
+                # A list only compares equal to lists
+                if name == "list" and bench in ("== DoublyLinkedList", "== tuple", "== iterator"):
+                    continue
+                best = min(timeit.repeat(func, number=1, repeat=REPEAT))
+                print(f"{kind:<7} {name:<5} {bench:<20} {best * 1e3:10.3f} ms")
+
+
+if __name__ == "__main__":
+    main()
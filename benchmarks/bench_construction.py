@@ -0,0 +1,42 @@
+"""Building a DoublyLinkedList from large list, tuple, DoublyLinkedList and generator sources.
+
+Run with: python benchmarks/bench_construction.py
+"""
+import time
+
+from py_doubly_linked_list import DoublyLinkedList
+
+N = 10_000_000
+REPEAT = 3
+
+
+def best_build(make_source):
+    times = []
+    for i in range(REPEAT):
+        source = make_source()
+        start = time.perf_counter()
+        dll = DoublyLinkedList(source)
+        times.append(time.perf_counter() - start)
+        del dll
+    return min(times)
+
+
+def main():
+    items = list(range(N))
+    items_tuple = tuple(items)
+    items_dll = DoublyLinkedList(items)
+    sources = (
+        ("list", lambda: items),
+        ("tuple", lambda: items_tuple),
+        ("DoublyLinkedList", lambda: items_dll),
+        ("generator", lambda: (item for item in items)),
+    )
+    for name, make_source in sources:
+        print(f"{name:<18} {best_build(make_source) * 1e3:10.1f} ms")
+    start = time.perf_counter()
+    list(items)
+    print(f"{'list(list)':<18} {(time.perf_counter() - start) * 1e3:10.1f} ms")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,120 @@
+"""Editing and walking a DoublyLinkedList through a Cursor next to doing the same by index.
+
+The text buffer workload types at a position that moves around, deleting a character now and
+then. The sliding window workload walks the list keeping the sum of the last WINDOW items. Both
+run against a list, a DoublyLinkedList by index and a Cursor, alone and with the head read between
+steps, which moves the list's internal cursor away the way a second part of a program would. The
+list's fingers keep indexing cheap in that case too, so the window walk, which needs two cursor
+calls for each subscript it saves, is about even.
+
+Run with: python benchmarks/bench_cursor.py
+"""
+import random
+import timeit
+
+from py_doubly_linked_list import DoublyLinkedList
+
+N = 100_000
+EDITS = 20_000
+WINDOW = 64
+REPEAT = 3
+
+
+def edit_moves():
+    rng = random.Random(0)
+    moves = []
+    for i in range(EDITS):
+        # Mostly type forwards, sometimes jump a little or delete
+        action = rng.random()
+        moves.append("jump" if action < 0.02 else "delete" if action < 0.2 else "type")
+    return moves
+
+
+def text_by_index(seq, moves, interleaved):
+    rng = random.Random(1)
+    pos = len(seq) // 2
+    for move in moves:
+        if move == "jump":
+            pos = max(0, min(len(seq) - 1, pos + rng.randrange(-50, 50)))
+        elif move == "delete":
+            del seq[pos]
+            pos = min(pos, len(seq) - 1)
+        else:
+            if isinstance(seq, list):
+                seq.insert(pos, "x")
+            else:
+                # DoublyLinkedList.insert takes the value first
+                seq.insert("x", pos)
+            pos += 1
+        if interleaved:
+            seq[0]
+
+
+def text_by_cursor(seq, moves, interleaved):
+    rng = random.Random(1)
+    cursor = seq.cursor(len(seq) // 2)
+    for move in moves:
+        if move == "jump":
+            steps = rng.randrange(-50, 50)
+            for i in range(steps):
+                if cursor.pos < len(seq) - 1:
+                    cursor.next()
+            for i in range(-steps):
+                if cursor.pos > 0:
+                    cursor.prev()
+        elif move == "delete":
+            cursor.delete()
+            if cursor.pos == len(seq):
+                cursor.prev()
+        else:
+            cursor.insert_before("x")
+        if interleaved:
+            seq[0]
+
+
+def window_by_index(seq, interleaved):
+    total = 0
+    for i in range(len(seq)):
+        total += seq[i]
+        if i >= WINDOW:
+            total -= seq[i - WINDOW]
+        if interleaved:
+            seq[0]
+    return total
+
+
+def window_by_cursor(seq, interleaved):
+    head = seq.cursor(0)
+    tail = seq.cursor(0)
+    total = 0
+    for i in range(len(seq)):
+        total += head.value
+        head.next()
+        if i >= WINDOW:
+            total -= tail.value
+            tail.next()
+        if interleaved:
+            seq[0]
+    return total
+
+
+def main():
+    moves = edit_moves()
+    for interleaved in (False, True):
+        label = "shared" if interleaved else "alone"
+        for name, make, bench in (("list", list, text_by_index),
+                                  ("dll index", DoublyLinkedList, text_by_index),
+                                  ("dll cursor", DoublyLinkedList, text_by_cursor)):
+            best = min(timeit.repeat(lambda: bench(make(["a"] * N), moves, interleaved), number=1, repeat=REPEAT))
+            print(f"text buffer    {label:<7} {name:<11} {best / EDITS * 1e6:10.3f} us/edit")
+        items = list(range(N))
+        for name, make, bench in (("list", list, window_by_index),
+                                  ("dll index", DoublyLinkedList, window_by_index),
+                                  ("dll cursor", DoublyLinkedList, window_by_cursor)):
+            seq = make(items)
+            best = min(timeit.repeat(lambda: bench(seq, interleaved), number=1, repeat=REPEAT))
+            print(f"sliding window {label:<7} {name:<11} {best / N * 1e6:10.3f} us/step")
+
+
+if __name__ == "__main__":
+    main()
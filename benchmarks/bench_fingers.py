@@ -0,0 +1,93 @@
+"""Positional access that alternates between a few distant regions of a list, which the cursor
+alone would have to walk back and forth between.
+
+Run with: python benchmarks/bench_fingers.py
+"""
+import time
+
+from py_doubly_linked_list import DoublyLinkedList
+
+N = 100_000
+OPS = 20_000
+REPEAT = 3
+
+
+def two_regions(container):
+    # Alternate between reads near the first and the third quarter
+    a, b = N // 4, 3 * N // 4
+    def run():
+        for i in range(OPS // 2):
+            container[a + i % 64]
+            container[b + i % 64]
+    return run
+
+
+def read_while_appending(container):
+    # Scan from the front while appending at the end, like a work list that grows as it is consumed
+    def run():
+        append = container.append
+        for i in range(OPS // 2):
+            container[N // 2 + i]
+            append(i)
+    return run
+
+
+def merge_access(container):
+    # Step through two runs side by side, as a merge reading positional items would
+    a, b = N // 8, N // 2
+    def run():
+        for i in range(OPS // 2):
+            container[a + i]
+            container[b + i]
+    return run
+
+
+def round_robin(container):
+    # Cycle through four regions, inserting and removing in each, so the fingers are shifted as well
+    regions = [N // 8, 3 * N // 8, 5 * N // 8, 7 * N // 8]
+    insert = container.insert if isinstance(container, list) else None
+    def run():
+        for i in range(OPS // 4):
+            for region in regions:
+                position = region + i % 32
+                container[position]
+                if insert:
+                    insert(position, i)
+                    container.pop(position + 1)
+                else:
+                    container.insert(i, position, False)
+                    container.pop(position + 1)
+    return run
+
+
+PATTERNS = (
+    ("two regions", two_regions),
+    ("read while appending", read_while_appending),
+    ("merge access", merge_access),
+    ("round robin", round_robin),
+)
+CONTAINERS = (
+    ("list", list),
+    ("dll", DoublyLinkedList),
+    ("dll indexed", lambda iterable: DoublyLinkedList(iterable, indexed=True)),
+)
+
+
+def main():
+    print(f"{'ns per access':<22} " + " ".join(f"{name:>12}" for name, make in CONTAINERS))
+    for pattern, prepare in PATTERNS:
+        row = []
+        for name, make in CONTAINERS:
+            best = None
+            for i in range(REPEAT):
+                run = prepare(make(range(N)))
+                start = time.perf_counter()
+                run()
+                elapsed = time.perf_counter() - start
+                best = elapsed if best is None else min(best, elapsed)
+            row.append(f"{best / OPS * 1e9:12.1f}")
+        print(f"{pattern:<22} " + " ".join(row), flush=True)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,83 @@
+"""Membership, count and remove on a plain and a hashed DoublyLinkedList next to a list.
+
+Scans on the plain list and the builtin list are O(n), so they run fewer operations. The second
+part uses a list of DUPLICATES_N items with only DISTINCT different values, where every value has
+thousands of equal items. remove and index have to find the first of them, the hashed list keeps
+equal items chained in list order so that stays O(1), apart from the position index returns.
+
+Run with: python benchmarks/bench_hashed.py
+"""
+import random
+import sys
+import timeit
+
+from py_doubly_linked_list import DoublyLinkedList
+
+N = 1_000_000
+OPS = 10_000
+SCAN_OPS = 20
+REPEAT = 3
+DUPLICATES_N = 100_000
+DISTINCT = 10
+
+
+def contains(seq, values):
+    for value in values:
+        value in seq
+
+
+def contains_missing(seq, values):
+    for value in values:
+        -value - 1 in seq
+
+
+def count(seq, values):
+    for value in values:
+        seq.count(value)
+
+
+def remove_append(seq, values):
+    for value in values:
+        seq.remove(value)
+        seq.append(value)
+
+
+def index(seq, values):
+    for value in values:
+        seq.index(value)
+
+
+def duplicates():
+    rng = random.Random(1)
+    items = [rng.randrange(DISTINCT) for i in range(DUPLICATES_N)]
+    values = [rng.randrange(DISTINCT) for i in range(OPS)]
+    for name, make in (("list", list),
+                       ("plain", DoublyLinkedList),
+                       ("hashed", lambda items: DoublyLinkedList(items, hashed=True)),
+                       ("hashed indexed", lambda items: DoublyLinkedList(items, hashed=True, indexed=True))):
+        seq = make(items)
+        for bench in (count, remove_append, index):
+            # count scans every item without the table
+            ops = SCAN_OPS if bench is count and not name.startswith("hashed") else OPS
+            best = min(timeit.repeat(lambda: bench(seq, values[:ops]), number=1, repeat=REPEAT))
+            print(f"duplicates {name:<15} {bench.__name__:<14} {best / ops * 1e6:10.2f} us/op")
+
+
+def main():
+    rng = random.Random(0)
+    values = [rng.randrange(N) for i in range(OPS)]
+    for name, make, ops in (("list", list, SCAN_OPS),
+                            ("plain", DoublyLinkedList, SCAN_OPS),
+                            ("hashed", lambda items: DoublyLinkedList(items, hashed=True), OPS)):
+        best = min(timeit.repeat(lambda: make(range(N)), number=1, repeat=REPEAT))
+        print(f"{name:<7} {'build':<17} {best * 1e3:10.2f} ms")
+        seq = make(range(N))
+        for bench in (contains, contains_missing, count, remove_append):
+            best = min(timeit.repeat(lambda: bench(seq, values[:ops]), number=1, repeat=REPEAT))
+            print(f"{name:<7} {bench.__name__:<17} {best / ops * 1e6:10.2f} us/op")
+        print(f"{name:<7} sys.getsizeof     {sys.getsizeof(seq) / N:10.2f} bytes/element")
+    duplicates()
+
+
+if __name__ == "__main__":
+    main()
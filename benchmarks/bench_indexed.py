@@ -0,0 +1,40 @@
+"""Random positional access on a plain and an indexed DoublyLinkedList.
+
+Run with: python benchmarks/bench_indexed.py
+"""
+import random
+import sys
+import timeit
+
+from py_doubly_linked_list import DoublyLinkedList
+
+N = 1_000_000
+OPS = 2_000
+REPEAT = 3
+
+
+def random_access(dll, positions):
+    for position in positions:
+        dll[position]
+
+
+def random_insert_pop(dll, positions):
+    for position in positions:
+        dll.insert(0, position)
+        dll.pop(position)
+
+
+def main():
+    rng = random.Random(0)
+    positions = [rng.randrange(N - 1) for i in range(OPS)]
+    for indexed in (False, True):
+        dll = DoublyLinkedList(range(N), indexed=indexed)
+        name = "indexed" if indexed else "plain"
+        for bench in (random_access, random_insert_pop):
+            best = min(timeit.repeat(lambda: bench(dll, positions), number=1, repeat=REPEAT))
+            print(f"{name:<8} {bench.__name__:<18} {best / OPS * 1e6:10.2f} us/op")
+        print(f"{name:<8} sys.getsizeof        {sys.getsizeof(dll) / N:10.2f} bytes/element")
+
+
+if __name__ == "__main__":
+    main()
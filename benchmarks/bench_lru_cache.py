@@ -0,0 +1,70 @@
+"""LRUCache compared to an OrderedDict based LRU cache and functools.lru_cache.
+
+Run with: python benchmarks/bench_lru_cache.py
+"""
+import functools
+import random
+import timeit
+from collections import OrderedDict
+
+from py_doubly_linked_list import LRUCache
+
+MAXSIZE = 1_000
+KEY_SPACE = 20_000
+N = 200_000
+REPEAT = 5
+
+
+class OrderedDictLRU:
+    def __init__(self, maxsize):
+        self.maxsize = maxsize
+        self.data = OrderedDict()
+
+    def get(self, key, default=None):
+        try:
+            self.data.move_to_end(key)
+        except KeyError:
+            return default
+        return self.data[key]
+
+    def put(self, key, value):
+        self.data[key] = value
+        self.data.move_to_end(key)
+        if len(self.data) > self.maxsize:
+            self.data.popitem(last=False)
+
+
+def workload(cache, keys):
+    get = cache.get
+    put = cache.put
+    for key in keys:
+        if get(key) is None:
+            put(key, key)
+
+
+def lru_cache_workload(keys):
+    @functools.lru_cache(maxsize=MAXSIZE)
+    def compute(key):
+        return key
+    for key in keys:
+        compute(key)
+
+
+def main():
+    rng = random.Random(0)
+    keys = [int(rng.paretovariate(1.2) * 100) % KEY_SPACE for i in range(N)]
+    results = {
+        "LRUCache": lambda: workload(LRUCache(MAXSIZE), keys),
+        "OrderedDict": lambda: workload(OrderedDictLRU(MAXSIZE), keys),
+        "functools.lru_cache": lambda: lru_cache_workload(keys),
+    }
+    for name, bench in results.items():
+        best = min(timeit.repeat(bench, number=1, repeat=REPEAT))
+        print(f"{name:<20} {N / best / 1e6:6.2f} M lookups/s")
+    cache = LRUCache(MAXSIZE)
+    workload(cache, keys)
+    print(f"hits={cache.hits} misses={cache.misses} evictions={cache.evictions}")
+
+
+if __name__ == "__main__":
+    main()
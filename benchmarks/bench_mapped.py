@@ -0,0 +1,80 @@
+"""Queue style use of a 1M item MappedLinkedList next to an in-memory DoublyLinkedList.
+
+Appends, iterates and pops short strings, then times reopening the file, which only reads its
+header, against restoring a DoublyLinkedList written with dump.
+
+Run with: python benchmarks/bench_mapped.py
+"""
+import os
+import tempfile
+import time
+
+from py_doubly_linked_list import DoublyLinkedList, MappedLinkedList
+
+N = 1_000_000
+REPEAT = 3
+
+
+def best_of(func):
+    best = float("inf")
+    for i in range(REPEAT):
+        start = time.perf_counter()
+        func()
+        best = min(best, time.perf_counter() - start)
+    return best
+
+
+def report(name, seconds):
+    print(f"{name:<40} {seconds * 1e3:10.3f} ms")
+
+
+def main():
+    values = [f"job {i}" for i in range(N)]
+    directory = tempfile.mkdtemp()
+    path = os.path.join(directory, "queue.dll")
+    dump_path = os.path.join(directory, "queue.dump")
+    try:
+        for cls in (DoublyLinkedList, MappedLinkedList):
+            def fill():
+                lst = MappedLinkedList(path) if cls is MappedLinkedList else DoublyLinkedList()
+                lst.clear()
+                for value in values:
+                    lst.append(value)
+                return lst
+            report(f"{cls.__name__} append x{N}", best_of(fill))
+            lst = fill()
+            report(f"{cls.__name__} iterate", best_of(lambda: [None for item in lst]))
+
+            def drain():
+                for i in range(N // 2):
+                    lst.pop(0)
+                    lst.pop()
+            start = time.perf_counter()
+            drain()
+            report(f"{cls.__name__} pop both ends x{N}", time.perf_counter() - start)
+            if cls is MappedLinkedList:
+                lst.close()
+
+        with MappedLinkedList(path) as lst:
+            lst.extend(values)
+        with open(dump_path, "wb") as file:
+            DoublyLinkedList(values).dump(file)
+
+        def reopen():
+            MappedLinkedList(path).close()
+
+        def load():
+            with open(dump_path, "rb") as file:
+                DoublyLinkedList.load(file)
+        report("MappedLinkedList reopen", best_of(reopen))
+        report("DoublyLinkedList.load", best_of(load))
+        print(f"file size {os.path.getsize(path) / 2**20:.1f} MiB for {N} items")
+    finally:
+        for name in (path, dump_path):
+            if os.path.exists(name):
+                os.remove(name)
+        os.rmdir(directory)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,77 @@
+"""Node allocation throughput, exercises the node pool.
+
+The bulk cases build and release a million nodes at a time, where allocation is most of the work.
+The churn cases append and pop one item at a time. To see what the pool saves, compare a normal
+build with one that mallocs and frees every node on its own:
+
+    CFLAGS=-DDLL_NO_NODE_POOL pip install .
+
+Run with: python benchmarks/bench_node_pool.py
+"""
+import timeit
+
+from py_doubly_linked_list import DoublyLinkedList, node_pool_stats, shrink_node_pool
+
+N = 200_000
+BULK_N = 1_000_000
+REPEAT = 5
+
+SOURCE = list(range(BULK_N))
+SMALL = DoublyLinkedList(range(1000))
+
+
+def fill_then_drain():
+    dll = DoublyLinkedList()
+    append = dll.append
+    pop = dll.pop
+    for i in range(N):
+        append(i)
+    for i in range(N):
+        pop()
+
+
+def interleaved():
+    dll = DoublyLinkedList(range(1000))
+    append = dll.append
+    pop = dll.pop
+    for i in range(N):
+        append(i)
+        pop()
+
+
+def both_ends():
+    dll = DoublyLinkedList(range(1000))
+    append = dll.append
+    pop = dll.pop
+    for i in range(N):
+        append(i, False)
+        pop(0)
+
+
+def extend_clear():
+    dll = DoublyLinkedList()
+    for i in range(5):
+        dll.extend(SOURCE)
+        dll.clear()
+
+
+def repeat_release():
+    for i in range(5):
+        repeated = SMALL * (BULK_N // len(SMALL))
+        del repeated
+
+
+def main():
+    for bench in (fill_then_drain, interleaved, both_ends):
+        best = min(timeit.repeat(bench, number=1, repeat=REPEAT))
+        print(f"{bench.__name__:<16} {2 * N / best / 1e6:6.2f} M ops/s")
+    for bench in (extend_clear, repeat_release):
+        best = min(timeit.repeat(bench, number=1, repeat=REPEAT))
+        print(f"{bench.__name__:<16} {best / (5 * BULK_N) * 1e9:6.2f} ns per node built and released")
+    print("pool after run:", node_pool_stats())
+    print("bytes released by shrink_node_pool():", shrink_node_pool())
+    print("pool after shrink:", node_pool_stats())
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,59 @@
+"""Time and peak memory of saving and restoring a 1M item DoublyLinkedList through a file.
+
+Compares pickling a list copy, pickling the DoublyLinkedList directly and dump/load. Peak memory is
+what tracemalloc sees allocated while the operation runs, for loads that includes the restored
+items. Pickling keeps a memo entry for every item it writes, dump starts a new pickle per frame.
+
+Run with: python benchmarks/bench_pickle.py
+"""
+import os
+import pickle
+import tempfile
+import time
+import tracemalloc
+
+from py_doubly_linked_list import DoublyLinkedList
+
+N = 1_000_000
+REPEAT = 3
+
+
+def measure(func, path, mode):
+    best = float("inf")
+    for i in range(REPEAT):
+        with open(path, mode) as file:
+            start = time.perf_counter()
+            rslt = func(file)
+            best = min(best, time.perf_counter() - start)
+        del rslt
+    # Timed separately since tracing every allocation slows the run down
+    with open(path, mode) as file:
+        tracemalloc.start()
+        rslt = func(file)
+        peak = tracemalloc.get_traced_memory()[1]
+        tracemalloc.stop()
+    return best, peak
+
+
+def main():
+    lst = DoublyLinkedList(f"item {i}" for i in range(N))
+    fd, path = tempfile.mkstemp()
+    os.close(fd)
+    try:
+        benches = [
+            ("pickle.dump(list(lst))", lambda file: pickle.dump(list(lst), file, -1), "wb"),
+            ("pickle.load, list", lambda file: DoublyLinkedList(pickle.load(file)), "rb"),
+            ("pickle.dump(lst)", lambda file: pickle.dump(lst, file, -1), "wb"),
+            ("pickle.load", pickle.load, "rb"),
+            ("lst.dump", lst.dump, "wb"),
+            ("DoublyLinkedList.load", DoublyLinkedList.load, "rb"),
+        ]
+        for name, func, mode in benches:
+            best, peak = measure(func, path, mode)
+            print(f"{name:<24} {best * 1e3:9.1f} ms   peak {peak / 2**20:8.2f} MiB")
+    finally:
+        os.remove(path)
+
+
+if __name__ == "__main__":
+    main()
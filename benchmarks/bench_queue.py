@@ -0,0 +1,73 @@
+"""Producer/consumer throughput of queue.Queue, queue.SimpleQueue and LinkedQueue.
+
+Run with: python benchmarks/bench_queue.py
+"""
+import queue
+import threading
+import time
+
+from py_doubly_linked_list import LinkedQueue
+
+N = 200_000
+REPEAT = 3
+BATCH = 64
+
+
+def produce(q, count):
+    put = q.put
+    for i in range(count):
+        put(i)
+
+
+# Consumers stop at the None sentinel and put it back for the next consumer
+def consume(q):
+    get = q.get
+    while get() is not None:
+        pass
+    q.put(None)
+
+
+def consume_many(q):
+    get_many = q.get_many
+    while None not in get_many(BATCH):
+        pass
+    q.put(None)
+
+
+def run(make_queue, consumer, pairs):
+    times = []
+    for i in range(REPEAT):
+        q = make_queue()
+        count = N // pairs
+        producers = [threading.Thread(target=produce, args=(q, count)) for j in range(pairs)]
+        consumers = [threading.Thread(target=consumer, args=(q,)) for j in range(pairs)]
+        start = time.perf_counter()
+        for thread in producers + consumers:
+            thread.start()
+        for thread in producers:
+            thread.join()
+        q.put(None)
+        for thread in consumers:
+            thread.join()
+        times.append(time.perf_counter() - start)
+    return N / min(times)
+
+
+def main():
+    cases = (
+        ("queue.Queue", queue.Queue, consume),
+        ("queue.Queue(1000)", lambda: queue.Queue(1000), consume),
+        ("SimpleQueue", queue.SimpleQueue, consume),
+        ("LinkedQueue", LinkedQueue, consume),
+        ("LinkedQueue(1000)", lambda: LinkedQueue(1000), consume),
+        ("get_many", LinkedQueue, consume_many),
+        ("get_many(1000)", lambda: LinkedQueue(1000), consume_many),
+    )
+    for pairs in (1, 4):
+        print(f"{pairs} producer(s), {pairs} consumer(s)")
+        for name, make_queue, consumer in cases:
+            print(f"    {name:<18} {run(make_queue, consumer, pairs) / 1e6:8.3f} M items/s")
+
+
+if __name__ == "__main__":
+    main()
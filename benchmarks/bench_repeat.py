@@ -0,0 +1,43 @@
+"""Repeating a DoublyLinkedList with * and *= next to list and to building the copies with extend.
+
+Run with: python benchmarks/bench_repeat.py
+"""
+import timeit
+
+from py_doubly_linked_list import DoublyLinkedList
+
+SIZES = ((10, 100_000), (1_000, 1_000), (100_000, 10))
+REPEAT = 5
+
+
+def extend_loop(seq, times):
+    repeated = DoublyLinkedList()
+    for i in range(times):
+        repeated.extend(seq)
+    return repeated
+
+
+def inplace(make, items, times):
+    seq = make(items)
+    seq *= times
+    return seq
+
+
+def main():
+    for length, times in SIZES:
+        items = list(range(length))
+        dll = DoublyLinkedList(items)
+        benches = [
+            ("list * n", lambda: items * times),
+            ("dll * n", lambda: dll * times),
+            ("dll extend loop", lambda: extend_loop(dll, times)),
+            ("list *= n", lambda: inplace(list, items, times)),
+            ("dll *= n", lambda: inplace(DoublyLinkedList, items, times)),
+        ]
+        for name, func in benches:
+            best = min(timeit.repeat(func, number=1, repeat=REPEAT))
+            print(f"{length:>7} x {times:<7} {name:<16} {best * 1e3:10.2f} ms  {best / (length * times) * 1e9:7.2f} ns/item")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,25 @@
+"""str of a DoublyLinkedList next to str of a list, and repr_limited on the same lists.
+
+Run with: python benchmarks/bench_repr.py
+"""
+import timeit
+
+from py_doubly_linked_list import DoublyLinkedList
+
+SIZES = [1_000, 100_000, 1_000_000]
+REPEAT = 3
+
+
+def main():
+    for n in SIZES:
+        values = list(range(n))
+        lst = DoublyLinkedList(values)
+        for name, bench in (("list str", lambda: str(values)),
+                            ("DoublyLinkedList str", lambda: str(lst)),
+                            ("DoublyLinkedList repr_limited(20)", lambda: lst.repr_limited(20))):
+            best = min(timeit.repeat(bench, number=1, repeat=REPEAT))
+            print(f"{n:>9} {name:<34} {best * 1e3:10.3f} ms")
+
+
+if __name__ == "__main__":
+    main()
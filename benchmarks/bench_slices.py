@@ -0,0 +1,29 @@
+"""Slice reads, assignments and deletions on a DoublyLinkedList compared with list.
+
+Run with: python benchmarks/bench_slices.py
+"""
+import timeit
+
+from py_doubly_linked_list import DoublyLinkedList
+
+N = 100_000
+REPEAT = 3
+
+
+def main():
+    for cls in (DoublyLinkedList, list):
+        lst = cls(range(N))
+        cases = (
+            ("read [::7]", lambda: lst[::7]),
+            ("read [::-7]", lambda: lst[::-7]),
+            ("assign [1000:2000]", lambda: lst.__setitem__(slice(1000, 2000), range(1000))),
+            ("assign [::7]", lambda: lst.__setitem__(slice(None, None, 7), range(len(range(0, N, 7))))),
+            ("delete+restore [::7]", lambda: (lst.__delitem__(slice(None, None, 7)), lst.extend(range(len(range(0, N, 7)))))),
+        )
+        for name, bench in cases:
+            best = min(timeit.repeat(bench, number=1, repeat=REPEAT))
+            print(f"{cls.__name__:<18} {name:<22} {best * 1e3:10.2f} ms")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,36 @@
+"""DoublyLinkedList.sort compared to list.sort on random, presorted and reverse sorted input.
+
+Run with: python benchmarks/bench_sort.py
+"""
+import random
+import timeit
+
+from py_doubly_linked_list import DoublyLinkedList
+
+N = 100_000
+REPEAT = 5
+
+
+def inputs():
+    rng = random.Random(0)
+    random_ints = [rng.randrange(N) for i in range(N)]
+    yield "random", random_ints
+    yield "presorted", sorted(random_ints)
+    yield "reversed", sorted(random_ints, reverse=True)
+    yield "few unique", [rng.randrange(10) for i in range(N)]
+    yield "random str", [str(value) for value in random_ints]
+
+
+def main():
+    print(f"{'input':<12} {'list':>10} {'dll':>10} {'ratio':>7}")
+    for name, data in inputs():
+        list_time = min(timeit.repeat("values.sort()", setup="values = list(data)",
+                                      globals={"data": data}, number=1, repeat=REPEAT))
+        dll_time = min(timeit.repeat("values.sort()", setup="values = DoublyLinkedList(data)",
+                                     globals={"data": data, "DoublyLinkedList": DoublyLinkedList},
+                                     number=1, repeat=REPEAT))
+        print(f"{name:<12} {list_time * 1e3:8.2f}ms {dll_time * 1e3:8.2f}ms {dll_time / list_time:6.2f}x")
+
+
+if __name__ == "__main__":
+    main()
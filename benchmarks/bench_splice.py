@@ -0,0 +1,30 @@
+"""Merging two large lists by copying them versus splicing their nodes.
+
+Run with: python benchmarks/bench_splice.py
+"""
+import timeit
+
+from py_doubly_linked_list import DoublyLinkedList
+
+N = 1_000_000
+REPEAT = 3
+
+
+def main():
+    for name, merge in (("extend", lambda a, b: a.extend(b)), ("splice", lambda a, b: a.splice(b))):
+        times = []
+        for i in range(REPEAT):
+            a = DoublyLinkedList(range(N))
+            b = DoublyLinkedList(range(N))
+            times.append(timeit.timeit(lambda: merge(a, b), number=1))
+        print(f"{name:<8} merge {min(times) * 1e3:10.3f} ms")
+    for name, partition in (("slice", lambda a: a[N // 2:]), ("split", lambda a: a.split(N // 2))):
+        times = []
+        for i in range(REPEAT):
+            a = DoublyLinkedList(range(N))
+            times.append(timeit.timeit(lambda: partition(a), number=1))
+        print(f"{name:<8} half  {min(times) * 1e3:10.3f} ms")
+
+
+if __name__ == "__main__":
+    main()
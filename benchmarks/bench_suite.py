@@ -0,0 +1,238 @@
+"""Side by side timings of DoublyLinkedList, list and collections.deque for the common operations.
+
+Every benchmark runs for each container at each size and reports the best time per operation over
+REPEAT runs, operations a container does not support are shown as -. Setup is never timed. --json
+writes the results with the interpreter and platform so runs can be compared over time.
+
+Run with: python benchmarks/bench_suite.py [--sizes 1000 100000] [--only sort iteration] [--json results.json]
+"""
+import argparse
+import json
+import platform
+import random
+import sys
+import time
+from collections import deque
+
+from py_doubly_linked_list import DoublyLinkedList
+
+SIZES = (1_000, 10_000, 100_000, 1_000_000, 10_000_000)
+REPEAT = 3
+CONTAINERS = {
+    "list": list,
+    "deque": deque,
+    "dll": DoublyLinkedList,
+    "dll indexed": lambda iterable: DoublyLinkedList(iterable, indexed=True),
+}
+
+BENCHMARKS = {}
+
+
+def benchmark(name):
+    def register(prepare):
+        BENCHMARKS[name] = prepare
+        return prepare
+    return register
+
+
+# Containers that are only read, or restored by the benchmark, are built once per size
+shared_containers = {}
+
+
+def shared(kind, n):
+    if (kind, n) not in shared_containers:
+        shared_containers.clear()
+        shared_containers[(kind, n)] = CONTAINERS[kind](range(n))
+    return shared_containers[(kind, n)]
+
+
+# Each benchmark returns the callable to time and the number of operations it performs, or None
+# when the container does not support the operation
+
+@benchmark("append/pop end")
+def append_pop_end(kind, n):
+    container = shared(kind, n)
+    ops = 1000
+    def run():
+        append, pop = container.append, container.pop
+        for i in range(ops):
+            append(i)
+        for i in range(ops):
+            pop()
+    return run, 2 * ops
+
+
+@benchmark("append/pop start")
+def append_pop_start(kind, n):
+    container = shared(kind, n)
+    ops = 100
+    if kind == "list":
+        def run():
+            for i in range(ops):
+                container.insert(0, i)
+            for i in range(ops):
+                container.pop(0)
+    elif kind == "deque":
+        def run():
+            for i in range(ops):
+                container.appendleft(i)
+            for i in range(ops):
+                container.popleft()
+    else:
+        def run():
+            for i in range(ops):
+                container.append(i, False)
+            for i in range(ops):
+                container.pop(0)
+    return run, 2 * ops
+
+
+@benchmark("insert/delete middle")
+def insert_delete_middle(kind, n):
+    container = shared(kind, n)
+    ops = 100
+    index = n // 2
+    if kind == "list":
+        def run():
+            for i in range(ops):
+                container.insert(index, i)
+                container.pop(index)
+    elif kind == "deque":
+        def run():
+            for i in range(ops):
+                container.insert(index, i)
+                del container[index]
+    else:
+        # Repeated work at one position is served from the cursor
+        def run():
+            for i in range(ops):
+                container.insert(i, index)
+                container.pop(index + 1)
+    return run, 2 * ops
+
+
+@benchmark("random index")
+def random_index(kind, n):
+    container = shared(kind, n)
+    rng = random.Random(0)
+    indices = [rng.randrange(n) for i in range(100)]
+    def run():
+        for i in indices:
+            container[i]
+    return run, len(indices)
+
+
+@benchmark("iteration")
+def iteration(kind, n):
+    container = shared(kind, n)
+    def run():
+        for item in container:
+            pass
+    return run, n
+
+
+@benchmark("slice")
+def slice_copy(kind, n):
+    if kind == "deque":
+        return None
+    container = shared(kind, n)
+    start = n // 4
+    stop = start + min(1000, n // 2)
+    def run():
+        for i in range(10):
+            container[start:stop]
+    return run, 10
+
+
+@benchmark("sort")
+def sort(kind, n):
+    if kind == "deque":
+        return None
+    rng = random.Random(0)
+    container = CONTAINERS[kind](rng.randrange(n) for i in range(n))
+    return container.sort, n
+
+
+@benchmark("count")
+def count(kind, n):
+    container = shared(kind, n)
+    return lambda: container.count(-1), n
+
+
+@benchmark("index")
+def index(kind, n):
+    container = shared(kind, n)
+    return lambda: container.index(n - 1), n
+
+
+@benchmark("construction")
+def construction(kind, n):
+    source = list(range(n))
+    make = CONTAINERS[kind]
+    return lambda: make(source), n
+
+
+@benchmark("teardown")
+def teardown(kind, n):
+    holder = [CONTAINERS[kind](range(n))]
+    return holder.clear, n
+
+
+def measure(prepare, kind, n, repeat):
+    best = None
+    for i in range(repeat):
+        prepared = prepare(kind, n)
+        if prepared is None:
+            return None
+        run, ops = prepared
+        start = time.perf_counter()
+        run()
+        elapsed = time.perf_counter() - start
+        best = elapsed if best is None else min(best, elapsed)
+    return best, ops
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare DoublyLinkedList with list and deque.")
+    parser.add_argument("--containers", nargs="+", choices=CONTAINERS, default=list(CONTAINERS))
+    parser.add_argument("--sizes", type=int, nargs="+", default=SIZES)
+    parser.add_argument("--repeat", type=int, default=REPEAT)
+    parser.add_argument("--only", nargs="+", choices=BENCHMARKS, metavar="NAME",
+                        help="run only these benchmarks: " + ", ".join(BENCHMARKS))
+    parser.add_argument("--json", metavar="PATH", help="also write the results to PATH as JSON")
+    args = parser.parse_args()
+
+    results = []
+    print(f"{'ns per operation':<22} {'size':>10} " + " ".join(f"{kind:>12}" for kind in args.containers))
+    for name, prepare in BENCHMARKS.items():
+        if args.only and name not in args.only:
+            continue
+        for n in args.sizes:
+            row = []
+            for kind in args.containers:
+                measured = measure(prepare, kind, n, args.repeat)
+                if measured is None:
+                    row.append(f"{'-':>12}")
+                    continue
+                seconds, ops = measured
+                row.append(f"{seconds / ops * 1e9:12.1f}")
+                results.append({"benchmark": name, "container": kind, "size": n,
+                                "seconds": seconds, "ops": ops, "ns_per_op": seconds / ops * 1e9})
+            print(f"{name:<22} {n:>10} " + " ".join(row), flush=True)
+        shared_containers.clear()
+
+    if args.json:
+        with open(args.json, "w") as file:
+            json.dump({
+                "python": sys.version,
+                "implementation": platform.python_implementation(),
+                "platform": platform.platform(),
+                "machine": platform.machine(),
+                "timestamp": time.strftime("%Y-%m-%dT%H:%M:%S%z"),
+                "repeat": args.repeat,
+                "results": results,
+            }, file, indent=2)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,51 @@
+"""Latency of releasing a 10M item list at once versus in deferred chunks.
+
+Run with: python benchmarks/bench_teardown.py
+"""
+import time
+
+from py_doubly_linked_list import DoublyLinkedList, release_deferred
+
+N = 10_000_000
+REPEAT = 3
+BUDGETS = (10_000, 100_000, 1_000_000)
+
+
+def timed(function):
+    start = time.perf_counter()
+    function()
+    return time.perf_counter() - start
+
+
+def main():
+    for name, release in (("del", None), ("clear", DoublyLinkedList.clear)):
+        times = []
+        for i in range(REPEAT):
+            test_list = DoublyLinkedList(range(N))
+            if release:
+                times.append(timed(lambda: release(test_list)))
+            else:
+                # Time the drop of the last reference
+                holder = [test_list]
+                del test_list
+                times.append(timed(holder.clear))
+        print(f"{name:<24} {min(times) * 1e3:10.3f} ms")
+    for budget in BUDGETS:
+        clears, pauses, totals = [], [], []
+        for i in range(REPEAT):
+            test_list = DoublyLinkedList(range(N))
+            clears.append(timed(lambda: test_list.clear(deferred=True)))
+            chunk_times = []
+            remaining = N
+            while remaining:
+                start = time.perf_counter()
+                remaining = release_deferred(budget)
+                chunk_times.append(time.perf_counter() - start)
+            pauses.append(max(chunk_times))
+            totals.append(sum(chunk_times))
+        print(f"clear(deferred=True)     {min(clears) * 1e3:10.3f} ms")
+        print(f"    budget {budget:>9}    {min(pauses) * 1e3:10.3f} ms worst chunk {min(totals) * 1e3:10.3f} ms total")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,58 @@
+"""Throughput of append/pop churn spread over several threads.
+
+Every thread works on its own list and then all threads share one list and one LRUCache. On a
+free-threaded build (python3.13t / python3.14t) the private lists should scale with the number
+of threads, with the GIL the total time stays about the same.
+
+Run with: python benchmarks/bench_threads.py
+"""
+import sys
+import threading
+import time
+
+from py_doubly_linked_list import DoublyLinkedList, LRUCache
+
+OPS = 200_000
+THREADS = (1, 2, 4, 8)
+
+
+def churn(test_list):
+    for i in range(OPS):
+        test_list.append(i)
+        test_list.append(i, False)
+        test_list.pop()
+        test_list.pop(0)
+
+
+def lookups(cache):
+    for i in range(OPS):
+        cache[i % 512] = i
+        cache.get((i * 7) % 512)
+
+
+def run(thread_count, target, make_arg):
+    threads = [threading.Thread(target=target, args=(make_arg(),)) for i in range(thread_count)]
+    start = time.perf_counter()
+    for thread in threads:
+        thread.start()
+    for thread in threads:
+        thread.join()
+    return time.perf_counter() - start
+
+
+def main():
+    gil = sys._is_gil_enabled() if hasattr(sys, "_is_gil_enabled") else True
+    print(f"GIL enabled: {gil}")
+    shared = DoublyLinkedList()
+    cache = LRUCache(256)
+    for name, target, make_arg in (("private lists", churn, DoublyLinkedList),
+                                   ("shared list", churn, lambda: shared),
+                                   ("shared LRUCache", lookups, lambda: cache)):
+        for thread_count in THREADS:
+            elapsed = run(thread_count, target, make_arg)
+            rate = thread_count * OPS / elapsed / 1e6
+            print(f"{name:<16} {thread_count} threads {elapsed * 1e3:10.1f} ms {rate:8.2f} M ops/s")
+
+
+if __name__ == "__main__":
+    main()
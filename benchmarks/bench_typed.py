@@ -0,0 +1,47 @@
+"""Scans over 1M ints and floats in a list, a DoublyLinkedList and the unboxed typed lists.
+
+sum, min and max are the builtins for list and DoublyLinkedList and the methods of the typed lists.
+
+Run with: python benchmarks/bench_typed.py
+"""
+import random
+import sys
+import timeit
+
+from py_doubly_linked_list import DoublyLinkedList, DoublyLinkedListF64, DoublyLinkedListI64
+
+N = 1_000_000
+REPEAT = 5
+
+
+def scans(lst, missing, typed):
+    yield "count", lambda: lst.count(missing)
+    yield "contains", lambda: missing in lst
+    yield "index", lambda: lst.index(lst[-1])
+    yield "sum", lst.sum if typed else lambda: sum(lst)
+    yield "min", lst.min if typed else lambda: min(lst)
+    yield "max", lst.max if typed else lambda: max(lst)
+    yield "iterate", lambda: [None for item in lst]
+
+
+def main():
+    rng = random.Random(0)
+    data = {
+        "int": ([rng.randrange(-10**9, 10**9) for i in range(N)], 10**10, DoublyLinkedListI64),
+        "float": ([rng.random() for i in range(N)], 2.0, DoublyLinkedListF64),
+    }
+    for kind, (values, missing, typed) in data.items():
+        for cls in (list, DoublyLinkedList, typed):
+            lst = cls(values)
+            for name, bench in scans(lst, missing, cls is typed):
+                best = min(timeit.repeat(bench, number=1, repeat=REPEAT))
+                print(f"{kind:<6} {cls.__name__:<20} {name:<9} {best * 1e3:9.2f} ms")
+            print(f"{kind:<6} {cls.__name__:<20} sys.getsizeof {sys.getsizeof(lst) / N:5.2f} bytes/element")
+        # Exporting copies the values once, consumers then read the contiguous buffer
+        lst = typed(values)
+        best = min(timeit.repeat(lambda: memoryview(lst).release(), number=1, repeat=REPEAT))
+        print(f"{kind:<6} {typed.__name__:<20} {'export':<9} {best * 1e3:9.2f} ms")
+
+
+if __name__ == "__main__":
+    main()
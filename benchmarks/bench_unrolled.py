@@ -0,0 +1,47 @@
+"""Scans and mid-list inserts on a DoublyLinkedList and an UnrolledLinkedList.
+
+Run with: python benchmarks/bench_unrolled.py
+"""
+import random
+import sys
+import timeit
+
+from py_doubly_linked_list import DoublyLinkedList, UnrolledLinkedList
+
+N = 1_000_000
+OPS = 200
+REPEAT = 3
+
+
+def iterate(lst, positions):
+    for item in lst:
+        pass
+
+
+def count(lst, positions):
+    lst.count(-1)
+
+
+def contains(lst, positions):
+    -1 in lst
+
+
+def mid_insert(lst, positions):
+    for position in positions:
+        lst.insert(position, position)
+        lst.pop(position)
+
+
+def main():
+    rng = random.Random(0)
+    positions = [rng.randrange(N // 2 - 1000, N // 2 + 1000) for i in range(OPS)]
+    for cls in (DoublyLinkedList, UnrolledLinkedList):
+        lst = cls(range(N))
+        for bench in (iterate, count, contains, mid_insert):
+            best = min(timeit.repeat(lambda: bench(lst, positions), number=1, repeat=REPEAT))
+            print(f"{cls.__name__:<20} {bench.__name__:<12} {best * 1e3:10.2f} ms")
+        print(f"{cls.__name__:<20} sys.getsizeof {sys.getsizeof(lst) / N:9.2f} bytes/element")
+
+
+if __name__ == "__main__":
+    main()
@@ -1,4 +1,4 @@
-// TODO rich comparison, repeat option, check errors
+// TODO check errors
 #define PY_SSIZE_T_CLEAN
 #include <Python.h>
 #include <structmember.h>
@@ -13,758 +13,9487 @@
         Py_INCREF(obj);
         return obj;
     }
+    static inline PyObject* Py_XNewRef(PyObject *obj)
+    {
+        Py_XINCREF(obj);
+        return obj;
+    }
+#endif
+#if PY_MINOR_VERSION < 13
+    // PyTime_t and its monotonic clock became public in 3.13, the private versions are exported before that
+    typedef _PyTime_t PyTime_t;
+    static inline int PyTime_Monotonic(PyTime_t* result)
+    {
+        *result = _PyTime_GetMonotonicClock();
+        return 0;
+    }
+#endif
+#if PY_VERSION_HEX < 0x030E0000
+    // PyUnicodeWriter became public in 3.14, earlier versions export the private writer it wraps.
+    // WriteUTF8 is only ever given ASCII here.
+    typedef _PyUnicodeWriter PyUnicodeWriter;
+    static inline PyUnicodeWriter* PyUnicodeWriter_Create(Py_ssize_t length)
+    {
+        PyUnicodeWriter* writer = PyMem_Malloc(sizeof(PyUnicodeWriter));
+        if(!writer) { PyErr_NoMemory(); return NULL; }
+        _PyUnicodeWriter_Init(writer);
+        writer->overallocate = 1;
+        return writer;
+    }
+    static inline void PyUnicodeWriter_Discard(PyUnicodeWriter* writer)
+    {
+        _PyUnicodeWriter_Dealloc(writer);
+        PyMem_Free(writer);
+    }
+    static inline PyObject* PyUnicodeWriter_Finish(PyUnicodeWriter* writer)
+    {
+        PyObject* string = _PyUnicodeWriter_Finish(writer);
+        PyMem_Free(writer);
+        return string;
+    }
+    static inline int PyUnicodeWriter_WriteUTF8(PyUnicodeWriter* writer, const char* string, Py_ssize_t size)
+    {
+        return _PyUnicodeWriter_WriteASCIIString(writer, string, size < 0 ? (Py_ssize_t)strlen(string) : size);
+    }
+    static inline int PyUnicodeWriter_WriteRepr(PyUnicodeWriter* writer, PyObject* object)
+    {
+        PyObject* repr = PyObject_Repr(object); if(!repr) { return -1; }
+        int rslt = _PyUnicodeWriter_WriteStr(writer, repr);
+        Py_DECREF(repr);
+        return rslt;
+    }
+#endif
+#if PY_MINOR_VERSION < 13
+    // Critical sections only lock anything on free-threaded builds, which start at 3.13
+    #define Py_BEGIN_CRITICAL_SECTION(op) {
+    #define Py_END_CRITICAL_SECTION() }
+    #define Py_BEGIN_CRITICAL_SECTION2(a, b) {
+    #define Py_END_CRITICAL_SECTION2() }
+#endif
+#ifdef Py_GIL_DISABLED
+    // Only the internal headers have this, it locks exact lists while their PySequence_Fast items
+    // are read. Tuples can't change and other sequences were copied.
+    #define DLL_BEGIN_CRITICAL_SECTION_SEQUENCE_FAST(original) \
+        { \
+            PyObject* dll_fast_original = (PyObject*)(original); \
+            int dll_fast_lock = PyList_CheckExact(dll_fast_original); \
+            PyCriticalSection dll_fast_section; \
+            if(dll_fast_lock) { PyCriticalSection_Begin(&dll_fast_section, dll_fast_original); }
+    #define DLL_END_CRITICAL_SECTION_SEQUENCE_FAST() \
+            if(dll_fast_lock) { PyCriticalSection_End(&dll_fast_section); } \
+        }
+#else
+    #define DLL_BEGIN_CRITICAL_SECTION_SEQUENCE_FAST(original) {
+    #define DLL_END_CRITICAL_SECTION_SEQUENCE_FAST() }
+#endif
+#ifdef Py_GIL_DISABLED
+    // Module wide state that is not owned by a single object is guarded by plain mutexes
+    #define DLL_MUTEX_LOCK(mutex) PyMutex_Lock(&(mutex))
+    #define DLL_MUTEX_UNLOCK(mutex) PyMutex_Unlock(&(mutex))
+#else
+    #define DLL_MUTEX_LOCK(mutex)
+    #define DLL_MUTEX_UNLOCK(mutex)
+#endif
+#if (defined(Py_GIL_DISABLED) || defined(DLL_NODE_CACHE)) && !defined(DLL_NO_NODE_POOL)
+    // Per thread node caches, see DLLNodeCache
+    #undef DLL_NODE_CACHE
+    #define DLL_NODE_CACHE
+    #ifdef _MSC_VER
+        #define DLL_THREAD_LOCAL __declspec(thread)
+    #else
+        #define DLL_THREAD_LOCAL _Thread_local
+    #endif
+#else
+    #undef DLL_NODE_CACHE
+#endif
+#ifdef DLL_STATS
+    // Hot path counters for stats(), only compiled in when built with DLL_STATS defined. Threads
+    // share them, so free-threaded builds update them with atomics and GIL builds with plain adds.
+    static struct
+    {
+        Py_ssize_t locate_cursor; // Locate calls that walked from each anchor or jumped through the index
+        Py_ssize_t locate_finger;
+        Py_ssize_t locate_head;
+        Py_ssize_t locate_tail;
+        Py_ssize_t locate_index;
+        Py_ssize_t steps_cursor; // Nodes walked from each anchor
+        Py_ssize_t steps_finger;
+        Py_ssize_t steps_head;
+        Py_ssize_t steps_tail;
+        Py_ssize_t node_allocs;
+        Py_ssize_t node_frees;
+        Py_ssize_t sort_comparisons;
+        Py_ssize_t peak_length;
+    } dll_stats;
+    #ifdef Py_GIL_DISABLED
+        #define DLL_STAT_ADD_TO(counter, n) ((void)_Py_atomic_add_ssize(&(counter), (n)))
+        #define DLL_STAT_LOAD(counter) _Py_atomic_load_ssize_relaxed(&(counter))
+        #define DLL_STAT_STORE(counter, value) _Py_atomic_store_ssize_relaxed(&(counter), (value))
+    #else
+        #define DLL_STAT_ADD_TO(counter, n) ((counter) += (n))
+        #define DLL_STAT_LOAD(counter) (counter)
+        #define DLL_STAT_STORE(counter, value) ((counter) = (value))
+    #endif
+    #define DLL_STAT_ADD(field, n) DLL_STAT_ADD_TO(dll_stats.field, (n))
+    #define DLL_STAT_PEAK(length) DLLStats_peak(length)
+
+    static inline void DLLStats_peak(Py_ssize_t length)
+    {
+    #ifdef Py_GIL_DISABLED
+        // Retries until the peak is at least length, another thread may raise it in between
+        Py_ssize_t peak = _Py_atomic_load_ssize_relaxed(&dll_stats.peak_length);
+        while(length > peak && !_Py_atomic_compare_exchange_ssize(&dll_stats.peak_length, &peak, length)) { }
+    #else
+        if(length > dll_stats.peak_length) { dll_stats.peak_length = length; }
+    #endif
+    }
+#else
+    #define DLL_STAT_ADD(field, n)
+    #define DLL_STAT_PEAK(length)
 #endif
 
+// Python facing entry points hold a critical section on their object for the whole call, so they
+// are generated as _locked wrappers around the plain functions. Everything else, and every
+// internal call between entry points, expects the lock to be held already.
+#define DLL_LOCKED(rtype, func, params, call_args) \
+    static rtype func##_locked params \
+    { \
+        rtype rslt; \
+        Py_BEGIN_CRITICAL_SECTION(op); \
+        rslt = func call_args; \
+        Py_END_CRITICAL_SECTION(); \
+        return rslt; \
+    }
+#define DLL_LOCKED_KWARGS(func) DLL_LOCKED(PyObject*, func, (PyObject* op, PyObject* args, PyObject* kwds), (op, args, kwds))
+#define DLL_LOCKED_UNARY(func) DLL_LOCKED(PyObject*, func, (PyObject* op), (op))
+#define DLL_LOCKED_BINARY(func) DLL_LOCKED(PyObject*, func, (PyObject* op, PyObject* other), (op, other))
+#define DLL_LOCKED_NOARGS(func) DLL_LOCKED(PyObject*, func, (PyObject* op, PyObject* dummy), (op, dummy))
+
 // Typedefs
 
+struct NodeHandle;
+struct DLLTower;
+
 typedef struct DLLNode
 {
 	PyObject* value;
     struct DLLNode* next;
     struct DLLNode* prev;
 	PyObject* key;
+    struct NodeHandle* handle; // Python handle referring to this node, if one was handed out
+    union
+    {
+        struct DLLTower* tower; // Skip links of indexed lists, NULL for most nodes
+        Py_hash_t key_hash; // Hash of key in LRUCache entries, which are never indexed
+    };
 } DLLNode;
 
-// - - - - - DoublyLinkedListNode - - - - - //
+static void NodeHandle_invalidate(struct NodeHandle*);
 
-// Initalization and Deallocation
+// - - - - - Node Pool - - - - - //
 
-static void
-DLLNode_dealloc(DLLNode* op)
+// Nodes are carved out of fixed size slabs and recycled through a module wide free list,
+// so append/pop churn never has to go back to malloc. The free list is threaded through next.
+// The DLLNodePool functions expect node_pool_mutex to be held on free-threaded builds.
+// Building with DLL_NO_NODE_POOL defined mallocs and frees every node on its own instead, to
+// benchmark the pool against. The free list then only holds nodes reserved for a chain.
+
+#define DLL_SLAB_NODES 256
+
+typedef struct DLLSlab
 {
-    Py_XDECREF(op->value);
-    Py_XDECREF(op->key);
-    free(op);
+    DLLNode nodes[DLL_SLAB_NODES];
+} DLLSlab;
+
+static struct
+{
+    DLLNode* free_list;
+    Py_ssize_t free_count;
+    DLLSlab** slabs;
+    Py_ssize_t slab_count;
+    Py_ssize_t slab_capacity;
+} node_pool = {NULL, 0, NULL, 0, 0};
+
+#ifdef Py_GIL_DISABLED
+static PyMutex node_pool_mutex = {0}; // Held for every access to node_pool
+#endif
+
+// Makes room to record slab_count slabs, at least doubling the room
+static int DLLNodePool_fit_slabs(Py_ssize_t slab_count)
+{
+    if(slab_count <= node_pool.slab_capacity) { return 0; }
+    Py_ssize_t capacity = node_pool.slab_capacity ? node_pool.slab_capacity * 2 : 16;
+    if(capacity < slab_count) { capacity = slab_count; }
+    if(capacity > PY_SSIZE_T_MAX / (Py_ssize_t)sizeof(DLLSlab*)) { PyErr_NoMemory(); return -1; }
+    DLLSlab** slabs = realloc(node_pool.slabs, capacity * sizeof(DLLSlab*));
+    if(!slabs) { PyErr_NoMemory(); return -1; }
+    node_pool.slabs = slabs;
+    node_pool.slab_capacity = capacity;
+    return 0;
 }
 
-static void DLLNode_dealloc_chain(DLLNode* op)
+static int DLLNodePool_grow()
 {
-    Py_XDECREF(op->value);
-    if(op->next != NULL) {
-        DLLNode_dealloc_chain(op->next);
+#ifdef DLL_NO_NODE_POOL
+    DLLNode* node = malloc(sizeof(DLLNode));
+    if(!node) { PyErr_NoMemory(); return -1; }
+    node->next = node_pool.free_list;
+    node_pool.free_list = node;
+    node_pool.free_count += 1;
+#else
+    if(DLLNodePool_fit_slabs(node_pool.slab_count + 1)) { return -1; }
+    DLLSlab* slab = malloc(sizeof(DLLSlab));
+    if(!slab) { PyErr_NoMemory(); return -1; }
+    node_pool.slabs[node_pool.slab_count++] = slab;
+    // Push in reverse so nodes are handed out in address order
+    for(Py_ssize_t i = DLL_SLAB_NODES-1; i >= 0; i--)
+    {
+        slab->nodes[i].next = node_pool.free_list;
+        node_pool.free_list = &slab->nodes[i];
     }
-    free(op);
+    node_pool.free_count += DLL_SLAB_NODES;
+#endif
+    return 0;
 }
 
-static DLLNode* DLLNode_new()
+// Grows the pool until count nodes can be taken without going back to malloc. The slab list is sized
+// for every new slab first, which fails before any slab is allocated if count is far beyond memory.
+// If a slab can't be allocated the slabs grown so far are given back.
+static int DLLNodePool_reserve(Py_ssize_t count)
 {
-    DLLNode *self = malloc(sizeof(DLLNode));
-    self->value = Py_NewRef(Py_None);
-    if (!self->value) {
-        DLLNode_dealloc(self);
-        return NULL;
+    if(node_pool.free_count >= count) { return 0; }
+    Py_ssize_t slab_count = node_pool.slab_count;
+    if(DLLNodePool_fit_slabs(slab_count + (count - node_pool.free_count + DLL_SLAB_NODES - 1) / DLL_SLAB_NODES)) { return -1; }
+    while(node_pool.free_count < count)
+    {
+        if(DLLNodePool_grow())
+        {
+#ifdef DLL_NO_NODE_POOL
+            while(node_pool.free_list)
+            {
+                DLLNode* node = node_pool.free_list;
+                node_pool.free_list = node->next;
+                free(node);
+            }
+            node_pool.free_count = 0;
+#else
+            // The new slabs pushed all of their nodes onto the front of the free list
+            Py_ssize_t grown = (node_pool.slab_count - slab_count) * DLL_SLAB_NODES;
+            for(Py_ssize_t i = 0; i < grown; i++) { node_pool.free_list = node_pool.free_list->next; }
+            node_pool.free_count -= grown;
+            while(node_pool.slab_count > slab_count) { free(node_pool.slabs[--node_pool.slab_count]); }
+#endif
+            return -1;
+        }
     }
-    self->key = NULL;
-    self->next = NULL;
-    self->prev = NULL;
-    return self;
+    return 0;
 }
 
-// __Methods__
+// Hands a whole chain (linked through next, values already released) back to the pool at once
+static void DLLNodePool_release_chain(DLLNode* first, DLLNode* last, Py_ssize_t count)
+{
+    DLL_STAT_ADD(node_frees, count);
+#ifdef DLL_NO_NODE_POOL
+    for(Py_ssize_t i = 0; i < count; i++)
+    {
+        DLLNode* next = first->next;
+        free(first);
+        first = next;
+    }
+#else
+    last->next = node_pool.free_list;
+    node_pool.free_list = first;
+    node_pool.free_count += count;
+#endif
+}
 
-static PyObject* DLLNode_str(DLLNode* op)
+static int DLLSlab_compare(const void* a, const void* b)
 {
-    DLLNode* self = op;
-    return PyUnicode_FromFormat("%S", self->value);
+    uintptr_t slab_a = (uintptr_t)*(DLLSlab* const*)a;
+    uintptr_t slab_b = (uintptr_t)*(DLLSlab* const*)b;
+    return (slab_a > slab_b) - (slab_a < slab_b);
 }
 
-static PyObject* DLLNode_repr(DLLNode* op)
+// Returns the slab that node was carved from, slabs must be sorted by address
+static Py_ssize_t DLLNodePool_find_slab(DLLNode* node)
 {
-    DLLNode* self = op;
-    return PyUnicode_FromFormat("%R", self->value);
+    Py_ssize_t low = 0, high = node_pool.slab_count - 1;
+    while(low <= high)
+    {
+        Py_ssize_t middle = (low + high) / 2;
+        DLLSlab* slab = node_pool.slabs[middle];
+        if(node < slab->nodes) { high = middle - 1; }
+        else if(node >= slab->nodes + DLL_SLAB_NODES) { low = middle + 1; }
+        else { return middle; }
+    }
+    return -1;
 }
 
+// Frees every slab with no live nodes left in it. Returns the number of bytes given back.
+static Py_ssize_t DLLNodePool_shrink()
+{
+    if(node_pool.free_count == 0) { return 0; }
+#ifdef DLL_NO_NODE_POOL
+    // Only nodes reserved for a chain that wasn't built are left
+    Py_ssize_t released = node_pool.free_count;
+    while(node_pool.free_list)
+    {
+        DLLNode* node = node_pool.free_list;
+        node_pool.free_list = node->next;
+        free(node);
+    }
+    node_pool.free_count = 0;
+    return released * (Py_ssize_t)sizeof(DLLNode);
+#else
+    qsort(node_pool.slabs, node_pool.slab_count, sizeof(DLLSlab*), DLLSlab_compare);
+    Py_ssize_t* free_nodes = calloc(node_pool.slab_count, sizeof(Py_ssize_t));
+    if(!free_nodes) { return 0; }
+    for(DLLNode* node = node_pool.free_list; node; node = node->next)
+    {
+        free_nodes[DLLNodePool_find_slab(node)] += 1;
+    }
+    // Rebuild the free list without the nodes of empty slabs, keeping address order
+    DLLNode* free_list = NULL;
+    DLLNode** link = &free_list;
+    for(DLLNode* node = node_pool.free_list; node; node = node->next)
+    {
+        if(free_nodes[DLLNodePool_find_slab(node)] != DLL_SLAB_NODES)
+        {
+            *link = node;
+            link = &node->next;
+        }
+    }
+    *link = NULL;
+    Py_ssize_t kept = 0;
+    Py_ssize_t released = 0;
+    for(Py_ssize_t i = 0; i < node_pool.slab_count; i++)
+    {
+        if(free_nodes[i] == DLL_SLAB_NODES) { free(node_pool.slabs[i]); released += 1; }
+        else { node_pool.slabs[kept++] = node_pool.slabs[i]; }
+    }
+    free(free_nodes);
+    node_pool.free_list = free_list;
+    node_pool.slab_count = kept;
+    node_pool.free_count -= released * DLL_SLAB_NODES;
+    return released * (Py_ssize_t)sizeof(DLLSlab);
+#endif
+}
 
-// - - - - - DoublyLinkedList - - - - - //
+#ifdef DLL_NODE_CACHE
+// Free-threaded builds give every thread a small cache of free nodes, so single appends and pops
+// don't take node_pool_mutex for each node. The cache is refilled from and given back to the pool
+// DLL_CACHE_BATCH nodes at a time. A capsule in the thread state dict owns it and hands the nodes
+// back when the thread's state is cleared. Building with DLL_NODE_CACHE defined turns it on with
+// the GIL too, to test it.
+
+#define DLL_CACHE_BATCH 32
+#define DLL_CACHE_NAME "py_doubly_linked_list.node_cache"
 
 typedef struct
 {
-	PyObject_HEAD
-    DLLNode* head;
-    DLLNode* tail;
-    DLLNode* cursor;
-    Py_ssize_t cursor_pos;
-    Py_ssize_t length;
-} DoublyLinkedList;
+    DLLNode* free_list;
+    Py_ssize_t count;
+} DLLNodeCache;
 
-static PyTypeObject DoublyLinkedListType;
+static DLL_THREAD_LOCAL DLLNodeCache* node_cache = NULL;
 
-// Define internal helper methods
+// Gives the first count cached nodes back to the pool
+static void DLLNodeCache_release(DLLNodeCache* cache, Py_ssize_t count)
+{
+    if(count == 0) { return; }
+    DLLNode* first = cache->free_list;
+    DLLNode* last = first;
+    for(Py_ssize_t i = 1; i < count; i++) { last = last->next; }
+    cache->free_list = last->next;
+    cache->count -= count;
+    DLL_MUTEX_LOCK(node_pool_mutex);
+    last->next = node_pool.free_list;
+    node_pool.free_list = first;
+    node_pool.free_count += count;
+    DLL_MUTEX_UNLOCK(node_pool_mutex);
+}
 
-static int DoublyLinkedList_locate(PyObject*, Py_ssize_t);
-static int DoublyLinkedList_cursor_insert(PyObject*, PyObject*, int);
-static int DoublyLinkedList_append_iterator(PyObject*, PyObject*, int);
-static int DoublyLinkedList_cursor_delete(PyObject*);
+// Takes up to DLL_CACHE_BATCH nodes from the pool into an empty cache, growing the pool if it has none
+static int DLLNodeCache_refill(DLLNodeCache* cache)
+{
+    DLL_MUTEX_LOCK(node_pool_mutex);
+    if(!node_pool.free_list && DLLNodePool_grow()) { DLL_MUTEX_UNLOCK(node_pool_mutex); return -1; }
+    Py_ssize_t count = node_pool.free_count < DLL_CACHE_BATCH ? node_pool.free_count : DLL_CACHE_BATCH;
+    DLLNode* first = node_pool.free_list;
+    DLLNode* last = first;
+    for(Py_ssize_t i = 1; i < count; i++) { last = last->next; }
+    node_pool.free_list = last->next;
+    node_pool.free_count -= count;
+    DLL_MUTEX_UNLOCK(node_pool_mutex);
+    last->next = NULL;
+    cache->free_list = first;
+    cache->count = count;
+    return 0;
+}
 
-// Initialization and deallocation
+static void DLLNodeCache_destroy(PyObject* capsule)
+{
+    DLLNodeCache* cache = PyCapsule_GetPointer(capsule, DLL_CACHE_NAME);
+    DLLNodeCache_release(cache, cache->count);
+    if(node_cache == cache) { node_cache = NULL; }
+    PyMem_RawFree(cache);
+}
 
-static void
-DoublyLinkedList_dealloc(PyObject *op)
+// Returns the calling thread's cache, making it on first use. Returns NULL without an exception set
+// if it can't be made, nodes then go to and from the pool directly.
+static DLLNodeCache* DLLNodeCache_get()
 {
-    DoublyLinkedList* self = (DoublyLinkedList*)op;
-    if(self->head) { DLLNode_dealloc_chain(self->head); }
-    Py_TYPE(self)->tp_free(self);
+    if(node_cache) { return node_cache; }
+    PyObject* dict = PyThreadState_GetDict(); if(!dict) { return NULL; }
+    PyObject *type, *value, *traceback;
+    PyErr_Fetch(&type, &value, &traceback);
+    DLLNodeCache* cache = PyMem_RawCalloc(1, sizeof(DLLNodeCache));
+    PyObject* capsule = cache ? PyCapsule_New(cache, DLL_CACHE_NAME, DLLNodeCache_destroy) : NULL;
+    if(!capsule) { PyMem_RawFree(cache); }
+    else if(PyDict_SetItemString(dict, DLL_CACHE_NAME, capsule) == 0) { node_cache = cache; }
+    Py_XDECREF(capsule);
+    PyErr_Clear();
+    PyErr_Restore(type, value, traceback);
+    return node_cache;
 }
 
-static PyObject* DoublyLinkedList_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
+// The calling thread's cached nodes are given back before the pool is measured or shrunk, other
+// threads keep theirs
+static void DLLNodeCache_flush()
 {
-    DoublyLinkedList *self;
-    self = (DoublyLinkedList*)type->tp_alloc(type, 0);
-    if(self)
+    if(node_cache) { DLLNodeCache_release(node_cache, node_cache->count); }
+}
+#endif
+
+// - - - - - DoublyLinkedListNode - - - - - //
+
+// Initalization and Deallocation
+
+static void
+DLLNode_dealloc(DLLNode* op)
+{
+    if(op->handle) { NodeHandle_invalidate(op->handle); }
+    Py_XDECREF(op->value);
+    Py_XDECREF(op->key);
+#ifdef DLL_NODE_CACHE
+    DLLNodeCache* cache = node_cache;
+    if(cache)
     {
-        self->head = NULL;
-        self->tail = NULL;
-        self->cursor = NULL;
-        self->cursor_pos = 0;
-        self->length = 0;
+        DLL_STAT_ADD(node_frees, 1);
+        op->next = cache->free_list;
+        cache->free_list = op;
+        cache->count += 1;
+        if(cache->count >= 2 * DLL_CACHE_BATCH) { DLLNodeCache_release(cache, DLL_CACHE_BATCH); }
+        return;
     }
-    return (PyObject*)self;
+#endif
+    DLL_MUTEX_LOCK(node_pool_mutex);
+    DLLNodePool_release_chain(op, op, 1);
+    DLL_MUTEX_UNLOCK(node_pool_mutex);
 }
 
-static int
-DoublyLinkedList_init(PyObject* op, PyObject *args)
+// Releases a detached chain, the nodes go back to the pool in one splice
+static void DLLNode_dealloc_chain(DLLNode* op)
 {
-    DoublyLinkedList* self = (DoublyLinkedList*)op;
-    PyObject* iterable = NULL;
-    if(!PyArg_ParseTuple(args, "|O", &iterable)) { return -1; }
-    if(iterable)
+    DLLNode* last = op;
+    Py_ssize_t count = 0;
+    for(DLLNode* node = op; node; node = node->next)
     {
-        if(DoublyLinkedList_append_iterator((PyObject*)self, iterable, 1)) { return -1; }
+        if(node->handle) { NodeHandle_invalidate(node->handle); }
+        Py_CLEAR(node->value);
+        Py_CLEAR(node->key);
+        last = node;
+        count += 1;
     }
-    return 0;
+    DLL_MUTEX_LOCK(node_pool_mutex);
+    DLLNodePool_release_chain(op, last, count);
+    DLL_MUTEX_UNLOCK(node_pool_mutex);
 }
 
-// Methods
+// Chains handed over by clear(deferred=True). Their items are released in bounded steps by
+// release_deferred instead of all at once. Guarded by node_pool_mutex like the pool itself.
+static struct
+{
+    DLLNode* head;
+    DLLNode* tail;
+    Py_ssize_t count;
+} deferred_nodes = {NULL, NULL, 0};
 
-static PyObject* DoublyLinkedList_insert(PyObject* op, PyObject* args, PyObject* kwds)
+// Queues a detached chain for release_deferred, any handles must already be invalidated
+static void DLLNode_defer_chain(DLLNode* head, DLLNode* tail, Py_ssize_t count)
 {
-    DoublyLinkedList* self = (DoublyLinkedList*)op;
-    static char* kwlist[] = {"object", "index", "forward", NULL};
-    PyObject* object = NULL;
-    Py_ssize_t index;
-    int forward = 1;
-    if(!PyArg_ParseTupleAndKeywords(args, kwds, "On|i", kwlist,
-                                    &object, &index, &forward))
-    {                              
-        return NULL;
-    }
-    if(DoublyLinkedList_locate((PyObject*)self, index)) { return NULL; }
-    if(DoublyLinkedList_cursor_insert((PyObject*)self, object, forward)) { return NULL; }
-    return Py_NewRef(Py_None);
+    tail->next = NULL;
+    DLL_MUTEX_LOCK(node_pool_mutex);
+    if(deferred_nodes.tail) { deferred_nodes.tail->next = head; } else { deferred_nodes.head = head; }
+    deferred_nodes.tail = tail;
+    deferred_nodes.count += count;
+    DLL_MUTEX_UNLOCK(node_pool_mutex);
 }
 
-static PyObject* DoublyLinkedList_append(PyObject* op, PyObject* args, PyObject* kwds)
+// Releases up to budget deferred nodes, all of them if budget is negative. Returns the number left.
+static Py_ssize_t DLLNode_release_deferred(Py_ssize_t budget)
 {
-    DoublyLinkedList* self = (DoublyLinkedList*) op;
-    static char* kwlist[] = {"object", "forward", NULL};
-    PyObject* object = NULL;
-    int forward = 1;
-    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|i", kwlist, &object, &forward)) { return NULL; }
-    if(forward) { self->cursor = self->tail; self->cursor_pos = self->length-1; if(self->cursor_pos < 0) {self->cursor_pos = 0;} }
-    else { self->cursor = self->head; self->cursor_pos = 0; }
-    if(DoublyLinkedList_cursor_insert((PyObject*)self, object, forward)) { return NULL; }
-    return Py_NewRef(Py_None);
+    DLL_MUTEX_LOCK(node_pool_mutex);
+    DLLNode* head = deferred_nodes.head;
+    if(budget < 0 || budget >= deferred_nodes.count)
+    {
+        deferred_nodes.head = NULL;
+        deferred_nodes.tail = NULL;
+        deferred_nodes.count = 0;
+    }
+    else if(budget > 0)
+    {
+        DLLNode* last = head;
+        for(Py_ssize_t i = 1; i < budget; i++) { last = last->next; }
+        deferred_nodes.head = last->next;
+        deferred_nodes.count -= budget;
+        last->next = NULL;
+    }
+    else { head = NULL; }
+    DLL_MUTEX_UNLOCK(node_pool_mutex);
+    // Items are released outside the mutex, their finalizers may defer more chains
+    if(head) { DLLNode_dealloc_chain(head); }
+    DLL_MUTEX_LOCK(node_pool_mutex);
+    Py_ssize_t remaining = deferred_nodes.count;
+    DLL_MUTEX_UNLOCK(node_pool_mutex);
+    return remaining;
 }
 
-static PyObject* DoublyLinkedList_index(PyObject* op, PyObject* args, PyObject* kwds)
+static DLLNode* DLLNode_new()
 {
-    DoublyLinkedList* self = (DoublyLinkedList*)op;
-    static char* kwlist[] = {"value", "start", "stop", NULL};
-    PyObject* value; Py_ssize_t start = 0; Py_ssize_t stop = self->length;
-    if(!PyArg_ParseTupleAndKeywords(args, kwds, "O|nn", kwlist, &value, &start, &stop)) { return NULL; }
-    if(DoublyLinkedList_locate((PyObject*)self, start)) { return NULL; }
-    for(Py_ssize_t i=start; i<stop; i++)
+    DLLNode* self;
+#ifdef DLL_NODE_CACHE
+    DLLNodeCache* cache = DLLNodeCache_get();
+    if(cache)
     {
-        int rslt = PyObject_RichCompareBool((self->cursor)->value, value, Py_EQ);
-        if(rslt == -1) { return NULL; }
-        if(rslt)
-        {
-            PyObject* rtn = PyLong_FromSsize_t(i); if(!rtn) { return NULL; }
-            return rtn;
-        }
-        self->cursor = (self->cursor)->next;
-        self->cursor_pos += 1;
+        if(!cache->free_list && DLLNodeCache_refill(cache)) { return NULL; }
+        self = cache->free_list;
+        cache->free_list = self->next;
+        cache->count -= 1;
+        DLL_STAT_ADD(node_allocs, 1);
     }
-    PyObject* err_format = PyUnicode_FromFormat("%S not in list", value); if(!err_format) { return NULL; }
-    const char* err_str = PyUnicode_AsUTF8(err_format); if(!err_str) { Py_DECREF(err_format); return NULL; }
-    PyErr_SetString(PyExc_ValueError, err_str);
-    Py_DECREF(err_format);
-    return NULL;
+    else
+#endif
+    {
+        DLL_MUTEX_LOCK(node_pool_mutex);
+        if(!node_pool.free_list && DLLNodePool_grow()) { DLL_MUTEX_UNLOCK(node_pool_mutex); return NULL; }
+        self = node_pool.free_list;
+        node_pool.free_list = self->next;
+        node_pool.free_count -= 1;
+        DLL_STAT_ADD(node_allocs, 1);
+        DLL_MUTEX_UNLOCK(node_pool_mutex);
+    }
+    self->value = Py_NewRef(Py_None);
+    self->key = NULL;
+    self->next = NULL;
+    self->prev = NULL;
+    self->handle = NULL;
+    self->tower = NULL;
+    return self;
 }
 
-static PyObject* DoublyLinkedList_pop(PyObject* op, PyObject* args, PyObject* kwds)
+// A detached chain of nodes that is built front to back and linked into a list in one step
+
+typedef struct
 {
-    DoublyLinkedList* self = (DoublyLinkedList*) op;
-    static char* kwlist[] = {"index", NULL};
-    Py_ssize_t index = self->length-1;
-    if(!PyArg_ParseTupleAndKeywords(args, kwds, "|n", kwlist, &index)) { return NULL; }
-    if(DoublyLinkedList_locate((PyObject*)self, index)) { return NULL; }
-    DLLNode* cursor = self->cursor;
-    PyObject* popped = Py_NewRef(cursor->value);
-    if(DoublyLinkedList_cursor_delete((PyObject*)self)) { return NULL; }
-    return popped;
+    DLLNode* first;
+    DLLNode* last;
+    Py_ssize_t length;
+} DLLChain;
+
+static int DLLChain_append(DLLChain* chain, PyObject* value)
+{
+    DLLNode* node = DLLNode_new(); if(!node) { return -1; }
+    Py_SETREF(node->value, Py_NewRef(value));
+    node->prev = chain->last;
+    if(chain->last) { chain->last->next = node; } else { chain->first = node; }
+    chain->last = node;
+    chain->length += 1;
+    return 0;
 }
 
-static PyObject* DoublyLinkedList_remove(PyObject* op, PyObject* args, PyObject* kwds)
+static int DLLChain_prepend(DLLChain* chain, PyObject* value)
 {
-    DoublyLinkedList* self = (DoublyLinkedList*)op;
-    if(!DoublyLinkedList_index((PyObject*)self, args, kwds)) { return NULL; }
-    if(DoublyLinkedList_cursor_delete((PyObject*)self)) { return NULL; }
-    return Py_NewRef(Py_None);
+    DLLNode* node = DLLNode_new(); if(!node) { return -1; }
+    Py_SETREF(node->value, Py_NewRef(value));
+    node->next = chain->first;
+    if(chain->first) { chain->first->prev = node; } else { chain->last = node; }
+    chain->first = node;
+    chain->length += 1;
+    return 0;
 }
 
-static PyObject* DoublyLinkedList_extend(PyObject* op, PyObject* args, PyObject* kwds)
+// Takes count nodes off the pool in one pass and links them into chain, filling each one with the
+// value next_value returns for it
+#define DLLCHAIN_FILL(chain, count, next_value) \
+    do { \
+        DLLNode* fill_first = node_pool.free_list; \
+        DLLNode* fill_prev = NULL; \
+        DLLNode* fill_node = fill_first; \
+        for(Py_ssize_t fill_i = 0; fill_i < (count); fill_i++) \
+        { \
+            fill_node->value = Py_NewRef(next_value); \
+            fill_node->key = NULL; \
+            fill_node->handle = NULL; \
+            fill_node->tower = NULL; \
+            fill_node->prev = fill_prev; \
+            fill_prev = fill_node; \
+            fill_node = fill_node->next; \
+        } \
+        node_pool.free_list = fill_node; \
+        node_pool.free_count -= (count); \
+        DLL_STAT_ADD(node_allocs, (count)); \
+        fill_prev->next = NULL; \
+        (chain)->first = fill_first; \
+        (chain)->last = fill_prev; \
+        (chain)->length = (count); \
+    } while(0)
+
+// Builds a chain from count values, in reverse order if forward is false
+static int DLLChain_from_array(DLLChain* chain, PyObject** values, Py_ssize_t count, int forward)
 {
-    DoublyLinkedList* self = (DoublyLinkedList* )op;
-    static char* kwlist[] = {"iterable", "forward", NULL};
-    PyObject* iterable;
-    int forward = 1;
-    if(!PyArg_ParseTupleAndKeywords(args, kwds, "O|i", kwlist, &iterable, &forward)) { return NULL; }
-    if(DoublyLinkedList_append_iterator((PyObject*)self, iterable, forward)) { return NULL; }
-    return Py_NewRef(Py_None);
+    if(count == 0) { return 0; }
+    DLL_MUTEX_LOCK(node_pool_mutex);
+    if(DLLNodePool_reserve(count)) { DLL_MUTEX_UNLOCK(node_pool_mutex); return -1; }
+    if(forward) { DLLCHAIN_FILL(chain, count, values[fill_i]); }
+    else { DLLCHAIN_FILL(chain, count, values[count - 1 - fill_i]); }
+    DLL_MUTEX_UNLOCK(node_pool_mutex);
+    return 0;
 }
 
-static PyObject* DoublyLinkedList_copy(PyObject* op)
+// Builds a chain with the values of count nodes starting at node, walking backwards from node if
+// forward is false
+static int DLLChain_from_nodes(DLLChain* chain, DLLNode* node, Py_ssize_t count, int forward)
 {
-    DoublyLinkedList* copy = (DoublyLinkedList*)DoublyLinkedList_new(&DoublyLinkedListType, NULL, NULL); if(!copy) { return NULL; }
-    if(DoublyLinkedList_append_iterator((PyObject*)copy, op, 1)) { return NULL; }
-    return (PyObject*)copy;
+    if(count == 0) { return 0; }
+    DLL_MUTEX_LOCK(node_pool_mutex);
+    if(DLLNodePool_reserve(count)) { DLL_MUTEX_UNLOCK(node_pool_mutex); return -1; }
+    DLLNode* source = node;
+    if(forward) { DLLCHAIN_FILL(chain, count, (source = (fill_i ? source->next : source))->value); }
+    else { DLLCHAIN_FILL(chain, count, (source = (fill_i ? source->prev : source))->value); }
+    DLL_MUTEX_UNLOCK(node_pool_mutex);
+    return 0;
 }
 
-static PyObject* DoublyLinkedList_reverse(PyObject* op)
+// Builds a chain with the values of the count nodes from head to tail repeated times over. All the
+// nodes are taken from the pool at once, a repeat that can't be reserved leaves the pool as it was.
+static int DLLChain_repeat(DLLChain* chain, DLLNode* head, DLLNode* tail, Py_ssize_t count, Py_ssize_t times)
 {
-    DoublyLinkedList* self = (DoublyLinkedList*)op;
-    Py_ssize_t middle = self->length / 2;
-    PyObject* temp;
-    DLLNode* node1 = self->head;
-    DLLNode* node2 = self->tail;
-    for(Py_ssize_t i = 0; i < middle; i++){
-        temp = (PyObject*)node1->value;
-        node1->value = node2->value;
-        node2->value = (PyObject*)temp;
-        node1 = node1->next;
-        node2 = node2->prev;
-    }
-    return Py_NewRef(Py_None);
+    if(count == 0 || times <= 0) { return 0; }
+    if(count > PY_SSIZE_T_MAX / times / (Py_ssize_t)sizeof(DLLNode)) { PyErr_NoMemory(); return -1; }
+    Py_ssize_t total = count * times;
+    DLL_MUTEX_LOCK(node_pool_mutex);
+    if(DLLNodePool_reserve(total)) { DLL_MUTEX_UNLOCK(node_pool_mutex); return -1; }
+    // The source ends at tail, so it wraps around to head for the next copy
+    DLLNode* source = tail;
+    DLLCHAIN_FILL(chain, total, (source = (source == tail ? head : source->next))->value);
+    DLL_MUTEX_UNLOCK(node_pool_mutex);
+    return 0;
 }
 
-static PyObject* DoublyLinkedList_count(PyObject* op, PyObject* args, PyObject* kwds)
+static void DLLChain_dealloc(DLLChain* chain)
 {
-    DoublyLinkedList* self = (DoublyLinkedList*)op;
-    static char* kwlist[] = {"value", NULL};
-    PyObject* value;
-    if(!PyArg_ParseTupleAndKeywords(args, kwds, "O", kwlist, &value)) { return NULL; }
-    DLLNode* temp = self->head;
-    Py_ssize_t count = 0;
-    for(Py_ssize_t i = 0; i<self->length; i++)
-    {
-        int rslt = PyObject_RichCompareBool(temp->value, value, Py_EQ);
-        if(rslt == -1) { return NULL; }
-        if(rslt) { count += 1; }
-        temp = temp->next;
-    }
-    PyObject* rtn = PyLong_FromSsize_t(count); if(!rtn) { return NULL; }
-    return rtn;
+    if(chain->first) { DLLNode_dealloc_chain(chain->first); }
+    chain->first = NULL;
+    chain->last = NULL;
+    chain->length = 0;
 }
 
-static PyObject* DoublyLinkedList_clear_method(PyObject* op)
+// - - - - - Skip List Index - - - - - //
+
+// Optional index for O(log n) positional access. Some nodes get a tower of skip links on top of the
+// node chain, every link stores the distance in positions to the tower it points at (or to the end
+// of the list), so a position is found by descending from the widest links. Towers are promoted
+// with probability 1/4, which averages 1/3 links per node. The header tower sits at position -1.
+
+#define DLL_INDEX_MAX_LEVEL 24
+#define DLL_INDEX_WALK 16 // Linear walks up to this length are cheaper than descending the index
+
+typedef struct DLLSkipLink
 {
-    DoublyLinkedList* self = (DoublyLinkedList*)op;
-    if(self->length == 0) { return Py_NewRef(Py_None); }
-    DLLNode_dealloc_chain(self->head);
-    self->head = NULL; self->tail = NULL; self->cursor = NULL;
-    self->length = 0; self->cursor_pos = 0;
-    return Py_NewRef(Py_None);
+    struct DLLTower* next;
+    struct DLLTower* prev;
+    Py_ssize_t width;
+} DLLSkipLink;
+
+typedef struct DLLTower
+{
+    DLLNode* node; // NULL for the header
+    int height;
+    DLLSkipLink links[];
+} DLLTower;
+
+typedef struct
+{
+    int level; // Highest level in use
+    uint64_t seed;
+    Py_ssize_t bytes; // Memory held by the index, header included
+    DLLTower* header;
+} DLLIndex;
+
+static DLLIndex* DLLIndex_new(uint64_t seed)
+{
+    Py_ssize_t header_size = sizeof(DLLTower) + DLL_INDEX_MAX_LEVEL * sizeof(DLLSkipLink);
+    DLLIndex* index = PyMem_Malloc(sizeof(DLLIndex));
+    if(!index) { PyErr_NoMemory(); return NULL; }
+    index->header = PyMem_Malloc(header_size);
+    if(!index->header) { PyMem_Free(index); PyErr_NoMemory(); return NULL; }
+    index->level = 0;
+    index->seed = seed | 1;
+    index->bytes = sizeof(DLLIndex) + header_size;
+    index->header->node = NULL;
+    index->header->height = DLL_INDEX_MAX_LEVEL;
+    return index;
 }
 
-//Helper method for sort, swaps two nodes that are next to each
-static void swap(DLLNode* node1, DLLNode* node2)
+static int DLLIndex_random_height(DLLIndex* index)
 {
-    PyObject* temp = node1->value;
-    node1->value = node2->value;
-    node2->value = temp;
+    // xorshift64, two bits per level for a promotion chance of 1/4
+    uint64_t r = index->seed;
+    r ^= r << 13; r ^= r >> 7; r ^= r << 17;
+    index->seed = r;
+    int height = 0;
+    while(height < DLL_INDEX_MAX_LEVEL && (r & 3) == 0) { height += 1; r >>= 2; }
+    return height;
 }
 
-static void swap_with_key(DLLNode* node1, DLLNode* node2)
+// Allocates a tower for node, returns NULL without an error set if the node stays a plain node
+static DLLTower* DLLIndex_new_tower(DLLIndex* index, DLLNode* node, int height)
 {
-    PyObject* temp = node1->value;
-    node1->value = node2->value;
-    node2->value = temp;
-    temp = node1->key;
-    node1->key = node2->key;
-    node2->key = temp;
+    if(height == 0) { return NULL; }
+    Py_ssize_t size = sizeof(DLLTower) + height * sizeof(DLLSkipLink);
+    DLLTower* tower = PyMem_Malloc(size);
+    if(!tower) { return NULL; } // An index without this tower is still valid
+    tower->node = node;
+    tower->height = height;
+    node->tower = tower;
+    index->bytes += size;
+    return tower;
 }
 
-static PyObject* DoublyLinkedList_sort(PyObject* op, PyObject* args, PyObject* kwds)
+static void DLLIndex_free_tower(DLLIndex* index, DLLTower* tower)
 {
-    DoublyLinkedList* self = (DoublyLinkedList*)op;
-    char* kwlist[] = {"key", "reverse", NULL};
-    PyObject* key = NULL; int reverse = 0;
-    if(!PyArg_ParseTupleAndKeywords(args, kwds, "|Oi", kwlist, &key, &reverse)) { return NULL; }
-    int operator;
-    if(reverse) { operator = Py_GT; } else { operator = Py_LT; }
-    DLLNode* temp = self->head;
-    DLLNode* next = temp->next;
-    DLLNode* prev;
-    int comparison;
-
-    if(key) {
-		if(!PyCallable_Check(key)) { PyErr_SetString(PyExc_TypeError, "Key must be a callable"); return NULL; }
-		for(int i = 0; i < self->length; i++)
-        {
-			PyObject* value_key = PyObject_CallOneArg(key, temp->value);
-			if(!value_key) { return NULL; }
-			temp->key = value_key;
-			temp = temp->next;
-		}
-		for(int i = 1; i < self->length; i++)
-        {
-            temp = next;
-            next = temp->next;
-            for(int j = i; j >= 1; j--)
-            {
-                prev = temp->prev;
-                comparison = PyObject_RichCompareBool(temp->key, prev->key, operator);
-                if(comparison == -1) { return NULL; }
-                if(comparison) { swap_with_key(prev, temp); temp = prev; }
-                else { break; }
-            }
-    	}
-		temp = self->head;
-		for(int i =0; i < self->length; i++)
-        {
-			Py_DECREF(temp->key);
-            temp->key = NULL;
-			temp = temp->next;
-		}
-		self->cursor_pos = 0;
-        self->cursor = self->head;
-    	return Py_NewRef(Py_None);
-	}
-	else
-    {
-    	for(int i = 1; i < self->length; i++)
-        {
-            temp = next;
-            next = temp->next;
-            for(int j = i; j >= 1; j--)
-            {
-                prev = temp->prev;
-                comparison = PyObject_RichCompareBool(temp->value, prev->value, operator);
-                if(comparison == -1) { return NULL; }
-                if(comparison) { swap(prev, temp); temp = prev; }
-                else { break; }
-        	}
-    	}
-    	self->cursor_pos = 0;
-        self->cursor = self->head;
-    	return Py_NewRef(Py_None);
-	}
+    tower->node->tower = NULL;
+    index->bytes -= sizeof(DLLTower) + tower->height * sizeof(DLLSkipLink);
+    PyMem_Free(tower);
 }
 
-// Internal Methods
+// Fills path with the last tower before position at every level and their positions
+static void DLLIndex_path(DLLIndex* index, Py_ssize_t position, DLLTower** path, Py_ssize_t* path_pos)
+{
+    DLLTower* tower = index->header;
+    Py_ssize_t pos = -1;
+    for(int level = index->level-1; level >= 0; level--)
+    {
+        while(tower->links[level].next && pos + tower->links[level].width < position)
+        {
+            pos += tower->links[level].width;
+            tower = tower->links[level].next;
+        }
+        path[level] = tower;
+        path_pos[level] = pos;
+    }
+}
 
-// Takes in DoublyLinkedList and index, locates node at that index and sets cursor to it
-static int DoublyLinkedList_locate(PyObject* op, Py_ssize_t index)
+// Registers node as the new element at position, length is the length before the insert
+static void DLLIndex_insert(DLLIndex* index, DLLNode* node, Py_ssize_t position, Py_ssize_t length)
 {
-    DoublyLinkedList* self = (DoublyLinkedList*)op;
-    if(index < 0) { index = self->length + index; }
-    if(index >= self->length || index < 0)
+    DLLTower* path[DLL_INDEX_MAX_LEVEL];
+    Py_ssize_t path_pos[DLL_INDEX_MAX_LEVEL];
+    DLLIndex_path(index, position, path, path_pos);
+    DLLTower* tower = DLLIndex_new_tower(index, node, DLLIndex_random_height(index));
+    int height = tower ? tower->height : 0;
+    for(int level = index->level; level < height; level++)
     {
-        PyErr_SetString(PyExc_IndexError, "Index out of bounds");
-        return -1;
+        index->header->links[level].next = NULL;
+        index->header->links[level].width = length + 1;
+        path[level] = index->header;
+        path_pos[level] = -1;
     }
-    DLLNode* search_node = self->cursor;
-    Py_ssize_t search_distance = index-self->cursor_pos;
-    const Py_ssize_t head_distance = index;
-    const Py_ssize_t tail_distance = index-(self->length-1);
-    if(labs(head_distance) < labs(search_distance))
+    if(height > index->level) { index->level = height; }
+    for(int level = 0; level < height; level++)
     {
-        search_node = self->head;
-        search_distance = head_distance;
+        DLLSkipLink* link = &path[level]->links[level];
+        tower->links[level].next = link->next;
+        tower->links[level].prev = path[level];
+        tower->links[level].width = path_pos[level] + link->width + 1 - position;
+        if(link->next) { link->next->links[level].prev = tower; }
+        link->next = tower;
+        link->width = position - path_pos[level];
     }
-    else if(labs(tail_distance) < labs(search_distance))
+    for(int level = height; level < index->level; level++) { path[level]->links[level].width += 1; }
+}
+
+// Drops node at position from the index
+static void DLLIndex_remove(DLLIndex* index, DLLNode* node, Py_ssize_t position)
+{
+    DLLTower* path[DLL_INDEX_MAX_LEVEL];
+    Py_ssize_t path_pos[DLL_INDEX_MAX_LEVEL];
+    DLLIndex_path(index, position, path, path_pos);
+    DLLTower* tower = node->tower;
+    for(int level = 0; level < index->level; level++)
     {
-        search_node = self->tail;
-        search_distance = tail_distance;
+        DLLSkipLink* link = &path[level]->links[level];
+        if(tower && level < tower->height)
+        {
+            link->width += tower->links[level].width - 1;
+            link->next = tower->links[level].next;
+            if(link->next) { link->next->links[level].prev = path[level]; }
+        }
+        else { link->width -= 1; }
     }
-    if(search_distance>0)
+    if(tower) { DLLIndex_free_tower(index, tower); }
+    while(index->level > 0 && !index->header->links[index->level-1].next) { index->level -= 1; }
+}
+
+// Returns the node at position, head is the first node of the list
+static DLLNode* DLLIndex_find(DLLIndex* index, DLLNode* head, Py_ssize_t position)
+{
+    DLLTower* tower = index->header;
+    Py_ssize_t pos = -1;
+    for(int level = index->level-1; level >= 0; level--)
     {
-        for(Py_ssize_t i = 0; i<search_distance; i++)
+        while(tower->links[level].next && pos + tower->links[level].width <= position)
         {
-            search_node = search_node->next;
+            pos += tower->links[level].width;
+            tower = tower->links[level].next;
         }
     }
-    else if(search_distance<0)
+    DLLNode* node = head;
+    if(tower->node) { node = tower->node; }
+    else { pos = 0; }
+    for(; pos < position; pos++) { node = node->next; }
+    return node;
+}
+
+// Returns the position of node by walking back to the nearest tower and climbing to the header
+static Py_ssize_t DLLIndex_position(DLLIndex* index, DLLNode* node)
+{
+    Py_ssize_t steps = 0;
+    while(node && !node->tower) { node = node->prev; steps += 1; }
+    if(!node) { return steps - 1; }
+    DLLTower* tower = node->tower;
+    int level = tower->height - 1;
+    Py_ssize_t pos = -1;
+    while(tower->node)
     {
-        for(Py_ssize_t i=0; i>search_distance; i--)
+        DLLTower* prev = tower->links[level].prev;
+        pos += prev->links[level].width;
+        tower = prev;
+        if(tower->node && tower->height - 1 > level) { level = tower->height - 1; }
+    }
+    return pos + steps;
+}
+
+// Frees every tower, leaving an empty index
+static void DLLIndex_clear(DLLIndex* index)
+{
+    if(index->level == 0) { return; }
+    DLLTower* tower = index->header->links[0].next;
+    while(tower)
+    {
+        DLLTower* next = tower->links[0].next;
+        DLLIndex_free_tower(index, tower);
+        tower = next;
+    }
+    index->level = 0;
+}
+
+// Builds the index for a whole chain in one pass
+static void DLLIndex_rebuild(DLLIndex* index, DLLNode* head, Py_ssize_t length)
+{
+    DLLIndex_clear(index);
+    DLLTower* last[DLL_INDEX_MAX_LEVEL];
+    Py_ssize_t last_pos[DLL_INDEX_MAX_LEVEL];
+    for(int level = 0; level < DLL_INDEX_MAX_LEVEL; level++)
+    {
+        last[level] = index->header;
+        last_pos[level] = -1;
+        index->header->links[level].next = NULL;
+    }
+    Py_ssize_t pos = 0;
+    for(DLLNode* node = head; node; node = node->next, pos++)
+    {
+        DLLTower* tower = DLLIndex_new_tower(index, node, DLLIndex_random_height(index));
+        if(!tower) { continue; }
+        for(int level = 0; level < tower->height; level++)
         {
-            search_node = search_node->prev;
+            last[level]->links[level].next = tower;
+            last[level]->links[level].width = pos - last_pos[level];
+            tower->links[level].prev = last[level];
+            last[level] = tower;
+            last_pos[level] = pos;
         }
+        if(tower->height > index->level) { index->level = tower->height; }
     }
-    self->cursor = search_node;
-    self->cursor_pos = index;
+    for(int level = 0; level < index->level; level++)
+    {
+        last[level]->links[level].next = NULL;
+        last[level]->links[level].width = length - last_pos[level];
+    }
+}
+
+static void DLLIndex_dealloc(DLLIndex* index)
+{
+    DLLIndex_clear(index);
+    PyMem_Free(index->header);
+    PyMem_Free(index);
+}
+
+// - - - - - Hash Index - - - - - //
+
+// Optional index from values to their nodes for O(1) membership, count and remove. Equal items
+// share a group in an open addressing table, which counts them and chains them in list order, so
+// the first occurrence is always at hand. A second table keyed by node address holds the group and
+// chain links of every node, so a node leaves its group without hashing its value again. Cursor
+// inserts, deletes and item assignment keep both up to date, other changes mark the index stale
+// and it is rebuilt by the next lookup. Lookups scan the list instead while it holds unhashable
+// items.
+
+#define DLL_HASH_MIN_TABLE 8
+// Probes step through a table by an odd stride taken from the higher bits of the hash, which
+// reaches every slot exactly once
+#define DLL_HASH_STRIDE(hash) ((((size_t)(hash)) >> 5) | 1)
+// Nodes are at least 16 bytes apart, so the low bits of their address are dropped
+#define DLL_HASH_NODE(node) ((size_t)(uintptr_t)(node) >> 4)
+
+static DLLNode dll_hash_dummy_node; // Marks deleted table slots
+#define DLL_HASH_DUMMY (&dll_hash_dummy_node)
+#define DLL_HASH_LIVE(node) ((node) && (node) != DLL_HASH_DUMMY)
+
+typedef struct
+{
+    Py_hash_t hash;
+    DLLNode* first; // First of the equal items in list order, NULL for empty slots
+    DLLNode* last;
+    Py_ssize_t count;
+} DLLHashGroup;
+
+typedef struct
+{
+    DLLNode* node; // NULL for empty slots
+    size_t group; // Slot of the node's group
+    DLLNode* prev_equal; // Neighbours in the group's chain
+    DLLNode* next_equal;
+} DLLHashMember;
+
+typedef struct
+{
+    DLLHashGroup* groups;
+    size_t group_mask;
+    Py_ssize_t group_used; // Live groups
+    Py_ssize_t group_fill; // Live and deleted slots
+    DLLHashMember* members;
+    size_t member_mask;
+    Py_ssize_t member_used;
+    Py_ssize_t member_fill;
+    Py_ssize_t unhashable; // Items without an entry because they could not be hashed
+    int stale; // The entries don't match the list and are rebuilt before the next lookup
+    size_t stale_count; // Bumped whenever the index goes stale, so a running rebuild notices changes
+    int busy; // Entries are being added while hashing runs python code, lookups scan the list meanwhile
+} DLLHashIndex;
+
+// Number of slots that keeps used entries under 2/3 of the table
+static size_t DLL_hash_table_size(Py_ssize_t used)
+{
+    size_t size = DLL_HASH_MIN_TABLE;
+    while(size * 2 <= (size_t)used * 3) { size <<= 1; }
+    return size;
+}
+
+// Replaces the tables with empty ones, the member table with room for members entries
+static int DLLHashIndex_reset(DLLHashIndex* hashed, Py_ssize_t members)
+{
+    size_t member_size = DLL_hash_table_size(members);
+    DLLHashGroup* groups = PyMem_Calloc(DLL_HASH_MIN_TABLE, sizeof(DLLHashGroup));
+    DLLHashMember* member_table = PyMem_Calloc(member_size, sizeof(DLLHashMember));
+    if(!groups || !member_table) { PyMem_Free(groups); PyMem_Free(member_table); PyErr_NoMemory(); return -1; }
+    PyMem_Free(hashed->groups);
+    PyMem_Free(hashed->members);
+    hashed->groups = groups;
+    hashed->group_mask = DLL_HASH_MIN_TABLE - 1;
+    hashed->group_used = 0;
+    hashed->group_fill = 0;
+    hashed->members = member_table;
+    hashed->member_mask = member_size - 1;
+    hashed->member_used = 0;
+    hashed->member_fill = 0;
+    hashed->unhashable = 0;
     return 0;
 }
 
-// Create a new node with value and inserts it forwards or backwards and sets cursor to it.
-static int DoublyLinkedList_cursor_insert(PyObject* op, PyObject* object, int forward)
+static DLLHashIndex* DLLHashIndex_new(void)
 {
-    DoublyLinkedList* self = (DoublyLinkedList*)op;
-    self->length += 1;
-    DLLNode* node = DLLNode_new(); if(!node) { return -1; }
-    Py_SETREF(node->value, Py_NewRef(object));
-    if(self->cursor == NULL)
+    DLLHashIndex* hashed = PyMem_Calloc(1, sizeof(DLLHashIndex));
+    if(!hashed) { PyErr_NoMemory(); return NULL; }
+    if(DLLHashIndex_reset(hashed, 0)) { PyMem_Free(hashed); return NULL; }
+    return hashed;
+}
+
+// Returns the first empty or deleted group slot for hash
+static size_t DLLHashIndex_free_group(DLLHashGroup* groups, size_t mask, Py_hash_t hash)
+{
+    size_t i = (size_t)hash & mask;
+    while(DLL_HASH_LIVE(groups[i].first)) { i = (i + DLL_HASH_STRIDE(hash)) & mask; }
+    return i;
+}
+
+// Returns the first empty or deleted member slot for node
+static size_t DLLHashIndex_free_member(DLLHashMember* members, size_t mask, DLLNode* node)
+{
+    size_t hash = DLL_HASH_NODE(node);
+    size_t i = hash & mask;
+    while(DLL_HASH_LIVE(members[i].node)) { i = (i + DLL_HASH_STRIDE(hash)) & mask; }
+    return i;
+}
+
+// Returns the entry of node, NULL if it has none
+static DLLHashMember* DLLHashIndex_member(DLLHashIndex* hashed, DLLNode* node)
+{
+    size_t hash = DLL_HASH_NODE(node);
+    for(size_t i = hash & hashed->member_mask; hashed->members[i].node; i = (i + DLL_HASH_STRIDE(hash)) & hashed->member_mask)
     {
-        self->head = node;
-        self->tail = node;
-        self->cursor = node;
+        if(hashed->members[i].node == node) { return &hashed->members[i]; }
     }
-    else
+    return NULL;
+}
+
+// Makes room for members more entries and groups more groups, dropping deleted slots when a table
+// is rebuilt. Doubling keeps single adds amortized O(1), a large batch gets just the room it needs.
+// Moving the groups re-points the entries of their members.
+static int DLLHashIndex_reserve(DLLHashIndex* hashed, Py_ssize_t members, Py_ssize_t groups)
+{
+    if((size_t)(hashed->member_fill + members) * 3 >= (hashed->member_mask + 1) * 2)
     {
-        DLLNode* cursor = self->cursor;
-        if(forward)
+        Py_ssize_t used = hashed->member_used;
+        size_t size = DLL_hash_table_size(used + (members > used ? members : used));
+        DLLHashMember* table = PyMem_Calloc(size, sizeof(DLLHashMember));
+        if(!table) { PyErr_NoMemory(); return -1; }
+        for(size_t i = 0; i <= hashed->member_mask; i++)
         {
-            self->cursor_pos += 1;
-            if(cursor->next == NULL)
-            {
-                node->prev = cursor;
-                self->tail = node;
-                cursor->next = node;
-            }
-            else
-            {
-                DLLNode* temp = cursor->next;
-                node->prev = cursor;
-                temp->prev = node;
-                node->next = temp;
-                cursor->next = node;
-            }
+            DLLHashMember* member = &hashed->members[i];
+            if(DLL_HASH_LIVE(member->node)) { table[DLLHashIndex_free_member(table, size - 1, member->node)] = *member; }
         }
-        else
+        PyMem_Free(hashed->members);
+        hashed->members = table;
+        hashed->member_mask = size - 1;
+        hashed->member_fill = used;
+    }
+    if((size_t)(hashed->group_fill + groups) * 3 >= (hashed->group_mask + 1) * 2)
+    {
+        Py_ssize_t used = hashed->group_used;
+        size_t size = DLL_hash_table_size(used + (groups > used ? groups : used));
+        DLLHashGroup* table = PyMem_Calloc(size, sizeof(DLLHashGroup));
+        if(!table) { PyErr_NoMemory(); return -1; }
+        for(size_t i = 0; i <= hashed->group_mask; i++)
         {
-            if(cursor->prev == NULL)
-            {
-                cursor->prev = node;
-                self->head = node;
-                node->next = cursor;
-            }
-            else
+            DLLHashGroup* group = &hashed->groups[i];
+            if(!DLL_HASH_LIVE(group->first)) { continue; }
+            size_t slot = DLLHashIndex_free_group(table, size - 1, group->hash);
+            table[slot] = *group;
+            for(DLLNode* node = group->first; node; )
             {
-                DLLNode* temp = cursor->prev;
-                node->prev = temp;
-                cursor->prev = node;
-                temp->next = node;
-                node->next = node;
+                DLLHashMember* member = DLLHashIndex_member(hashed, node);
+                member->group = slot;
+                node = member->next_equal;
             }
         }
+        PyMem_Free(hashed->groups);
+        hashed->groups = table;
+        hashed->group_mask = size - 1;
+        hashed->group_fill = used;
     }
-    self->cursor = node;
     return 0;
 }
 
-static int DoublyLinkedList_cursor_delete(PyObject* op)
+// Adds an entry for node, which is already in the list, to the group at slot, or to a new group
+// for hash if found is 0. place is 1 if node comes after every other member of the group, -1 if it
+// comes before all of them, otherwise its neighbours in the group are found by walking out from it
+// until the walk meets another member or an end of the list. Room has to be reserved first.
+static void DLLHashIndex_add(DLLHashIndex* hashed, DLLNode* node, Py_hash_t hash, size_t slot, int found, int place)
 {
-    DoublyLinkedList* self = (DoublyLinkedList*)op;
-    self->length -= 1;
-    DLLNode* cursor = self->cursor;
-    if(cursor->next == NULL)
+    DLLNode* prev_equal = NULL;
+    DLLNode* next_equal = NULL;
+    if(!found)
     {
-        if(cursor->prev == NULL)
+        slot = DLLHashIndex_free_group(hashed->groups, hashed->group_mask, hash);
+        if(!hashed->groups[slot].first) { hashed->group_fill += 1; }
+        hashed->groups[slot] = (DLLHashGroup){hash, node, node, 0};
+        hashed->group_used += 1;
+    }
+    else if(place > 0) { prev_equal = hashed->groups[slot].last; }
+    else if(place < 0) { next_equal = hashed->groups[slot].first; }
+    else
+    {
+        DLLNode* back = node->prev;
+        DLLNode* ahead = node->next;
+        while(1)
         {
-            self->head = NULL;
-            self->tail = NULL;
-            self->cursor = NULL;
+            if(!back) { next_equal = hashed->groups[slot].first; break; }
+            DLLHashMember* member = DLLHashIndex_member(hashed, back);
+            if(member && member->group == slot) { prev_equal = back; next_equal = member->next_equal; break; }
+            back = back->prev;
+            if(!ahead) { prev_equal = hashed->groups[slot].last; break; }
+            member = DLLHashIndex_member(hashed, ahead);
+            if(member && member->group == slot) { next_equal = ahead; prev_equal = member->prev_equal; break; }
+            ahead = ahead->next;
         }
-        else
+    }
+    DLLHashGroup* group = &hashed->groups[slot];
+    if(prev_equal) { DLLHashIndex_member(hashed, prev_equal)->next_equal = node; }
+    else { group->first = node; }
+    if(next_equal) { DLLHashIndex_member(hashed, next_equal)->prev_equal = node; }
+    else { group->last = node; }
+    group->count += 1;
+    size_t member_slot = DLLHashIndex_free_member(hashed->members, hashed->member_mask, node);
+    if(!hashed->members[member_slot].node) { hashed->member_fill += 1; }
+    hashed->members[member_slot] = (DLLHashMember){node, slot, prev_equal, next_equal};
+    hashed->member_used += 1;
+}
+
+// Removes the entry of node before the node leaves the list or gets a new value. A node without an
+// entry holds an unhashable item.
+static void DLLHashIndex_forget(DLLHashIndex* hashed, DLLNode* node)
+{
+    DLLHashMember* member = DLLHashIndex_member(hashed, node);
+    if(!member)
+    {
+        hashed->unhashable -= 1;
+        return;
+    }
+    DLLHashGroup* group = &hashed->groups[member->group];
+    if(member->prev_equal) { DLLHashIndex_member(hashed, member->prev_equal)->next_equal = member->next_equal; }
+    else { group->first = member->next_equal; }
+    if(member->next_equal) { DLLHashIndex_member(hashed, member->next_equal)->prev_equal = member->prev_equal; }
+    else { group->last = member->prev_equal; }
+    group->count -= 1;
+    if(group->count == 0)
+    {
+        group->first = DLL_HASH_DUMMY;
+        hashed->group_used -= 1;
+    }
+    member->node = DLL_HASH_DUMMY;
+    hashed->member_used -= 1;
+}
+
+// Moves the entry of node to the end of its group's chain, or to the start if place is -1, after the
+// node moved to that end of the list. Room freed by forgetting it is reused, so nothing grows.
+static void DLLHashIndex_move_to_end(DLLHashIndex* hashed, DLLNode* node, int place)
+{
+    DLLHashMember* member = DLLHashIndex_member(hashed, node); if(!member) { return; }
+    size_t slot = member->group;
+    Py_hash_t hash = hashed->groups[slot].hash;
+    DLLHashIndex_forget(hashed, node);
+    DLLHashIndex_add(hashed, node, hash, slot, DLL_HASH_LIVE(hashed->groups[slot].first), place);
+}
+
+// Flips every chain after the list was reversed
+static void DLLHashIndex_reverse(DLLHashIndex* hashed)
+{
+    for(size_t i = 0; i <= hashed->group_mask; i++)
+    {
+        DLLHashGroup* group = &hashed->groups[i];
+        if(!DLL_HASH_LIVE(group->first)) { continue; }
+        DLLNode* first = group->first;
+        group->first = group->last;
+        group->last = first;
+    }
+    for(size_t i = 0; i <= hashed->member_mask; i++)
+    {
+        DLLHashMember* member = &hashed->members[i];
+        if(!DLL_HASH_LIVE(member->node)) { continue; }
+        DLLNode* prev_equal = member->prev_equal;
+        member->prev_equal = member->next_equal;
+        member->next_equal = prev_equal;
+    }
+}
+
+// Drops every entry for an empty list, shrinking the tables back to their minimum size
+static void DLLHashIndex_clear(DLLHashIndex* hashed)
+{
+    if(hashed->group_mask + 1 > DLL_HASH_MIN_TABLE || hashed->member_mask + 1 > DLL_HASH_MIN_TABLE)
+    {
+        // Keep the large tables if small ones can't be allocated, no error can be raised here
+        DLLHashGroup* groups = PyMem_Calloc(DLL_HASH_MIN_TABLE, sizeof(DLLHashGroup));
+        DLLHashMember* members = PyMem_Calloc(DLL_HASH_MIN_TABLE, sizeof(DLLHashMember));
+        if(groups && members)
         {
-            self->tail = cursor->prev;
-            self->cursor = cursor->prev;
-            (cursor->prev)->next = cursor->next;
-            self->cursor_pos-=1;
+            PyMem_Free(hashed->groups);
+            PyMem_Free(hashed->members);
+            hashed->groups = groups;
+            hashed->group_mask = DLL_HASH_MIN_TABLE - 1;
+            hashed->members = members;
+            hashed->member_mask = DLL_HASH_MIN_TABLE - 1;
         }
+        else { PyMem_Free(groups); PyMem_Free(members); }
     }
-    else
+    memset(hashed->groups, 0, (hashed->group_mask + 1) * sizeof(DLLHashGroup));
+    memset(hashed->members, 0, (hashed->member_mask + 1) * sizeof(DLLHashMember));
+    hashed->group_used = 0;
+    hashed->group_fill = 0;
+    hashed->member_used = 0;
+    hashed->member_fill = 0;
+    hashed->unhashable = 0;
+    hashed->stale = 0;
+}
+
+static Py_ssize_t DLLHashIndex_bytes(DLLHashIndex* hashed)
+{
+    return sizeof(DLLHashIndex) + (hashed->group_mask + 1) * sizeof(DLLHashGroup) + (hashed->member_mask + 1) * sizeof(DLLHashMember);
+}
+
+static void DLLHashIndex_dealloc(DLLHashIndex* hashed)
+{
+    PyMem_Free(hashed->groups);
+    PyMem_Free(hashed->members);
+    PyMem_Free(hashed);
+}
+
+// - - - - - Item Comparison - - - - - //
+
+// Equality and ordering of items for scans and list comparisons. Items are checked for identity
+// first like list does. Exact ints, floats and strs compared to an item of the same type are
+// compared directly, everything else goes through rich comparison.
+
+// Reads an exact int, returns 0 if it doesn't fit in a long
+static inline int DLL_long_value(PyObject* op, long* value)
+{
+    int overflow;
+    *value = PyLong_AsLongAndOverflow(op, &overflow);
+    return !overflow;
+}
+
+// Equal strs have the same kind and length, so their data can be compared directly
+static inline int DLL_unicode_equal(PyObject* a, PyObject* b)
+{
+#if PY_VERSION_HEX < 0x030C0000
+    if(!PyUnicode_IS_READY(a) || !PyUnicode_IS_READY(b))
+    {
+        int rslt = PyUnicode_Compare(a, b);
+        if(rslt == -1 && PyErr_Occurred()) { return -1; }
+        return rslt == 0;
+    }
+#endif
+    Py_ssize_t length = PyUnicode_GET_LENGTH(a);
+    if(length != PyUnicode_GET_LENGTH(b) || PyUnicode_KIND(a) != PyUnicode_KIND(b)) { return 0; }
+    return memcmp(PyUnicode_DATA(a), PyUnicode_DATA(b), length * PyUnicode_KIND(a)) == 0;
+}
+
+// a == b like PyObject_RichCompareBool. Rich comparison can run python code, the items are held
+// while it runs.
+static int DLL_items_equal(PyObject* a, PyObject* b)
+{
+    if(a == b) { return 1; }
+    PyTypeObject* type = Py_TYPE(a);
+    if(type == Py_TYPE(b))
+    {
+        if(type == &PyFloat_Type) { return PyFloat_AS_DOUBLE(a) == PyFloat_AS_DOUBLE(b); }
+        if(type == &PyUnicode_Type) { return DLL_unicode_equal(a, b); }
+        long x, y;
+        if(type == &PyLong_Type && DLL_long_value(a, &x) && DLL_long_value(b, &y)) { return x == y; }
+    }
+    Py_INCREF(a); Py_INCREF(b);
+    int rslt = PyObject_RichCompareBool(a, b, Py_EQ);
+    Py_DECREF(a); Py_DECREF(b);
+    return rslt;
+}
+
+// a compare_op b for the first items that differ in a list comparison, like PyObject_RichCompare
+static PyObject* DLL_items_order(PyObject* a, PyObject* b, int compare_op)
+{
+    PyTypeObject* type = Py_TYPE(a);
+    if(type == Py_TYPE(b))
+    {
+        if(type == &PyFloat_Type) { Py_RETURN_RICHCOMPARE(PyFloat_AS_DOUBLE(a), PyFloat_AS_DOUBLE(b), compare_op); }
+        if(type == &PyUnicode_Type)
+        {
+            int rslt = PyUnicode_Compare(a, b);
+            if(rslt == -1 && PyErr_Occurred()) { return NULL; }
+            Py_RETURN_RICHCOMPARE(rslt, 0, compare_op);
+        }
+        long x, y;
+        if(type == &PyLong_Type && DLL_long_value(a, &x) && DLL_long_value(b, &y)) { Py_RETURN_RICHCOMPARE(x, y, compare_op); }
+    }
+    return PyObject_RichCompare(a, b, compare_op);
+}
+
+// Matches the items of a scan against one value. The fast path for the type of value is picked
+// once, so count and index only check the type of each item.
+typedef struct
+{
+    PyObject* value;
+    PyTypeObject* type; // Exact type of value if it has a fast path, NULL otherwise
+    long long_value;
+    double float_value;
+} DLLMatcher;
+
+static void DLLMatcher_init(DLLMatcher* matcher, PyObject* value)
+{
+    matcher->value = value;
+    matcher->type = NULL;
+    matcher->long_value = 0;
+    matcher->float_value = 0.0;
+    if(PyFloat_CheckExact(value))
+    {
+        matcher->type = &PyFloat_Type;
+        matcher->float_value = PyFloat_AS_DOUBLE(value);
+    }
+    else if(PyUnicode_CheckExact(value)) { matcher->type = &PyUnicode_Type; }
+    else if(PyLong_CheckExact(value) && DLL_long_value(value, &matcher->long_value)) { matcher->type = &PyLong_Type; }
+}
+
+// item == value like PyObject_RichCompareBool(item, value, Py_EQ)
+static inline int DLLMatcher_match(DLLMatcher* matcher, PyObject* item)
+{
+    if(item == matcher->value) { return 1; }
+    if(Py_IS_TYPE(item, matcher->type))
+    {
+        if(matcher->type == &PyFloat_Type) { return PyFloat_AS_DOUBLE(item) == matcher->float_value; }
+        if(matcher->type == &PyUnicode_Type) { return DLL_unicode_equal(item, matcher->value); }
+        // ints are stored in their shortest form, one that doesn't fit in a long differs from value
+        long x;
+        return DLL_long_value(item, &x) && x == matcher->long_value;
+    }
+    return DLL_items_equal(item, matcher->value);
+}
+
+// - - - - - DoublyLinkedList - - - - - //
+
+#define DLL_FINGERS 4
+#define DLL_FINGER_MIN_GAP 32 // Cursor moves shorter than this don't leave a finger behind
+
+// A position the cursor was at before it moved elsewhere, so code that alternates between regions
+// of the list doesn't have to walk back. A finger is only valid while its mod_count matches the
+// list's, cursor inserts and deletes keep the fingers they don't remove up to date and every other
+// change invalidates them.
+typedef struct
+{
+    DLLNode* node;
+    Py_ssize_t pos;
+    size_t mod_count;
+    size_t used; // finger_clock at the last use, the least recently used finger is replaced first
+} DLLFinger;
+
+typedef struct
+{
+	PyObject_HEAD
+    DLLNode* head;
+    DLLNode* tail;
+    DLLNode* cursor;
+    Py_ssize_t cursor_pos;
+    Py_ssize_t length;
+    size_t mod_count; // Bumped on every change to the chain so iterators can detect it
+    Py_ssize_t handle_count; // Live NodeHandles referring to nodes of this list
+    DLLIndex* index; // Skip list index, NULL unless the list was created with indexed=True
+    DLLHashIndex* hashed; // Hash index, NULL unless the list was created with hashed=True
+    DLLNode* sort_tail; // Old tail while sort has the chain detached, its prev links still reach every node
+    DLLFinger fingers[DLL_FINGERS];
+    size_t finger_clock;
+    struct Cursor* cursors; // Live Cursors on the list, single inserts and deletes keep their positions
+} DoublyLinkedList;
+
+static PyTypeObject DoublyLinkedListType;
+static PyTypeObject DoublyLinkedListIteratorType;
+static PyTypeObject NodeHandleType;
+
+typedef struct NodeHandle
+{
+    PyObject_HEAD
+    DLLNode* node; // NULL once the node has been removed from its list
+    DoublyLinkedList* list; // Strong reference while the handle is valid, NULL afterwards
+} NodeHandle;
+
+typedef struct Cursor
+{
+    PyObject_HEAD
+    DoublyLinkedList* list;
+    NodeHandle* handle; // Handle of the node the cursor is at, NULL at the end of the list
+    Py_ssize_t pos;
+    size_t mod_count; // mod_count of the list when pos was last known
+    struct Cursor* prev; // Neighbours in the list's chain of cursors
+    struct Cursor* next;
+} Cursor;
+
+#ifdef Py_GIL_DISABLED
+static PyMutex handle_mutex = {0}; // Held while handle->list is changed or read outside a list lock
+#endif
+
+// Define internal helper methods
+
+static int DoublyLinkedList_locate(PyObject*, Py_ssize_t);
+static void DoublyLinkedList_save_cursor(DoublyLinkedList*, Py_ssize_t);
+static void DoublyLinkedList_clear_fingers(DoublyLinkedList*);
+static int DoublyLinkedList_cursor_insert(PyObject*, PyObject*, int);
+static int DoublyLinkedList_append_iterator(PyObject*, PyObject*, int);
+static int DoublyLinkedList_cursor_delete(PyObject*);
+static int DoublyLinkedList_ass_item(PyObject*, Py_ssize_t, PyObject*);
+static PyObject* DoublyLinkedList_iter(PyObject*);
+static PyObject* NodeHandle_for(DoublyLinkedList*, DLLNode*);
+static PyObject* Cursor_for(DoublyLinkedList*, DLLNode*, Py_ssize_t);
+static PyObject* DoublyLinkedList_reversed(PyObject*, PyObject*);
+static void DoublyLinkedList_link_chain(DoublyLinkedList*, DLLNode*, DLLNode*, Py_ssize_t, DLLNode*, Py_ssize_t);
+static int DoublyLinkedList_hash_lookup(DoublyLinkedList*, PyObject*, Py_ssize_t*, DLLNode**);
+static void DoublyLinkedList_cursor_to_node(DoublyLinkedList*, DLLNode*);
+static Py_ssize_t DoublyLinkedList_position(DoublyLinkedList*, DLLNode*);
+static void DoublyLinkedList_reset_cursor(DoublyLinkedList*);
+static void DoublyLinkedList_shift_cursors(DoublyLinkedList*, Py_ssize_t, Py_ssize_t);
+static void DoublyLinkedList_forget_cursors(DoublyLinkedList*);
+
+// Creates the indexes that were asked for and aren't there yet, for the items already in the list
+static int DoublyLinkedList_enable(DoublyLinkedList* self, int indexed, int hashed)
+{
+    if(indexed && !self->index)
+    {
+        self->index = DLLIndex_new((uint64_t)(uintptr_t)self); if(!self->index) { return -1; }
+        DLLIndex_rebuild(self->index, self->head, self->length);
+    }
+    if(hashed && !self->hashed)
+    {
+        self->hashed = DLLHashIndex_new(); if(!self->hashed) { return -1; }
+        self->hashed->stale = self->length > 0;
+    }
+    return 0;
+}
+
+// Marks the hash index out of date after a change that didn't keep it up to date
+static inline void DoublyLinkedList_hash_stale(DoublyLinkedList* self)
+{
+    if(!self->hashed) { return; }
+    self->hashed->stale = 1;
+    self->hashed->stale_count += 1;
+}
+
+// Initialization and deallocation
+
+static void
+DoublyLinkedList_dealloc(PyObject *op)
+{
+    DoublyLinkedList* self = (DoublyLinkedList*)op;
+    PyObject_GC_UnTrack(op);
+    // Lists nested inside lists are released level by level instead of recursing through every dealloc
+    Py_TRASHCAN_BEGIN(op, DoublyLinkedList_dealloc)
+    if(self->index) { DLLIndex_dealloc(self->index); }
+    if(self->hashed) { DLLHashIndex_dealloc(self->hashed); }
+    if(self->head) { DLLNode_dealloc_chain(self->head); }
+    Py_TYPE(self)->tp_free(self);
+    Py_TRASHCAN_END
+}
+
+static int DoublyLinkedList_traverse(PyObject* op, visitproc visit, void* arg)
+{
+    DoublyLinkedList* self = (DoublyLinkedList*)op;
+    for(DLLNode* node = self->head; node; node = node->next)
+    {
+        Py_VISIT(node->value);
+    }
+    // The detached chain of a running sort, keys only exist while sorting
+    for(DLLNode* node = self->sort_tail; node; node = node->prev)
+    {
+        Py_VISIT(node->value);
+        Py_VISIT(node->key);
+    }
+    return 0;
+}
+
+// Breaks reference cycles by releasing every item, handles to the nodes are invalidated
+static int DoublyLinkedList_clear(PyObject* op)
+{
+    DoublyLinkedList* self = (DoublyLinkedList*)op;
+    DLLNode* head = self->head;
+    self->head = NULL; self->tail = NULL; self->cursor = NULL;
+    self->length = 0; self->cursor_pos = 0;
+    self->mod_count += 1;
+    if(self->index) { DLLIndex_clear(self->index); }
+    if(self->hashed) { DLLHashIndex_clear(self->hashed); }
+    if(head) { DLLNode_dealloc_chain(head); }
+    return 0;
+}
+
+static PyObject* DoublyLinkedList_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
+{
+    DoublyLinkedList *self;
+    self = (DoublyLinkedList*)type->tp_alloc(type, 0);
+    if(self)
+    {
+        self->head = NULL;
+        self->tail = NULL;
+        self->cursor = NULL;
+        self->cursor_pos = 0;
+        self->length = 0;
+        self->mod_count = 0;
+        self->handle_count = 0;
+        self->index = NULL;
+        self->hashed = NULL;
+        self->sort_tail = NULL;
+        memset(self->fingers, 0, sizeof(self->fingers));
+        self->finger_clock = 0;
+        self->cursors = NULL;
+    }
+    return (PyObject*)self;
+}
+
+static int
+DoublyLinkedList_init(PyObject* op, PyObject *args, PyObject *kwds)
+{
+    DoublyLinkedList* self = (DoublyLinkedList*)op;
+    static char* kwlist[] = {"", "indexed", "hashed", NULL};
+    PyObject* iterable = NULL;
+    int indexed = 0;
+    int hashed = 0;
+    if(!PyArg_ParseTupleAndKeywords(args, kwds, "|O$ii", kwlist, &iterable, &indexed, &hashed)) { return -1; }
+    if(DoublyLinkedList_enable(self, indexed, hashed)) { return -1; }
+    if(iterable)
+    {
+        if(DoublyLinkedList_append_iterator((PyObject*)self, iterable, 1)) { return -1; }
+    }
+    return 0;
+}
+
+// Methods
+
+static PyObject* DoublyLinkedList_insert(PyObject* op, PyObject* args, PyObject* kwds)
+{
+    DoublyLinkedList* self = (DoublyLinkedList*)op;
+    static char* kwlist[] = {"object", "index", "forward", NULL};
+    PyObject* object = NULL;
+    Py_ssize_t index;
+    int forward = 1;
+    if(!PyArg_ParseTupleAndKeywords(args, kwds, "On|i", kwlist,
+                                    &object, &index, &forward))
+    {                              
+        return NULL;
+    }
+    if(DoublyLinkedList_locate((PyObject*)self, index)) { return NULL; }
+    if(DoublyLinkedList_cursor_insert((PyObject*)self, object, forward)) { return NULL; }
+    return Py_NewRef(Py_None);
+}
+
+static PyObject* DoublyLinkedList_append(PyObject* op, PyObject* args, PyObject* kwds)
+{
+    DoublyLinkedList* self = (DoublyLinkedList*) op;
+    static char* kwlist[] = {"object", "forward", NULL};
+    PyObject* object = NULL;
+    int forward = 1;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|i", kwlist, &object, &forward)) { return NULL; }
+    DoublyLinkedList_save_cursor(self, forward ? self->length : 0);
+    if(forward) { self->cursor = self->tail; self->cursor_pos = self->length-1; if(self->cursor_pos < 0) {self->cursor_pos = 0;} }
+    else { self->cursor = self->head; self->cursor_pos = 0; }
+    if(DoublyLinkedList_cursor_insert((PyObject*)self, object, forward)) { return NULL; }
+    return Py_NewRef(Py_None);
+}
+
+// Points the cursor at the first occurrence of value between start and stop for index and remove.
+// Hashed lists find it without a scan when searching the whole list. The position is then looked
+// up only for indexed lists or if need_position is set, 1 is returned if it wasn't.
+static int DoublyLinkedList_find(DoublyLinkedList* self, PyObject* args, PyObject* kwds, int need_position)
+{
+    static char* kwlist[] = {"value", "start", "stop", NULL};
+    PyObject* value; Py_ssize_t start = 0; Py_ssize_t stop = self->length;
+    if(!PyArg_ParseTupleAndKeywords(args, kwds, "O|nn", kwlist, &value, &start, &stop)) { return -1; }
+    // Bounds are clamped like list.index does
+    if(start < 0) { start = start + self->length < 0 ? 0 : start + self->length; }
+    if(stop < 0) { stop = stop + self->length < 0 ? 0 : stop + self->length; }
+    if(stop > self->length) { stop = self->length; }
+    int rslt = 1;
+    if(start == 0 && stop == self->length)
+    {
+        Py_ssize_t count;
+        DLLNode* first;
+        rslt = DoublyLinkedList_hash_lookup(self, value, &count, &first); if(rslt == -1) { return -1; }
+        if(rslt == 0 && count > 0)
+        {
+            if(!self->index && !need_position)
+            {
+                DoublyLinkedList_cursor_to_node(self, first);
+                return 1;
+            }
+            Py_ssize_t position = DoublyLinkedList_position(self, first);
+            DoublyLinkedList_save_cursor(self, position);
+            self->cursor = first;
+            self->cursor_pos = position;
+            return 0;
+        }
+    }
+    if(rslt == 1 && start < stop)
+    {
+        if(DoublyLinkedList_locate((PyObject*)self, start)) { return -1; }
+        DLLMatcher matcher;
+        DLLMatcher_init(&matcher, value);
+        size_t mod_count = self->mod_count;
+        for(Py_ssize_t i=start; i<stop; i++)
+        {
+            // The comparison can run python code, stop if it changed the list
+            int equal = DLLMatcher_match(&matcher, (self->cursor)->value);
+            if(equal == -1) { return -1; }
+            if(mod_count != self->mod_count)
+            {
+                PyErr_SetString(PyExc_RuntimeError, "DoublyLinkedList changed during search");
+                return -1;
+            }
+            if(equal) { return 0; }
+            self->cursor = (self->cursor)->next;
+            self->cursor_pos += 1;
+        }
+    }
+    PyObject* err_format = PyUnicode_FromFormat("%S not in list", value); if(!err_format) { return -1; }
+    const char* err_str = PyUnicode_AsUTF8(err_format); if(!err_str) { Py_DECREF(err_format); return -1; }
+    PyErr_SetString(PyExc_ValueError, err_str);
+    Py_DECREF(err_format);
+    return -1;
+}
+
+static PyObject* DoublyLinkedList_index(PyObject* op, PyObject* args, PyObject* kwds)
+{
+    DoublyLinkedList* self = (DoublyLinkedList*)op;
+    if(DoublyLinkedList_find(self, args, kwds, 1)) { return NULL; }
+    return PyLong_FromSsize_t(self->cursor_pos);
+}
+
+static PyObject* DoublyLinkedList_pop(PyObject* op, PyObject* args, PyObject* kwds)
+{
+    DoublyLinkedList* self = (DoublyLinkedList*) op;
+    static char* kwlist[] = {"index", NULL};
+    Py_ssize_t index = self->length-1;
+    if(!PyArg_ParseTupleAndKeywords(args, kwds, "|n", kwlist, &index)) { return NULL; }
+    if(DoublyLinkedList_locate((PyObject*)self, index)) { return NULL; }
+    DLLNode* cursor = self->cursor;
+    PyObject* popped = Py_NewRef(cursor->value);
+    if(DoublyLinkedList_cursor_delete((PyObject*)self)) { Py_DECREF(popped); return NULL; }
+    return popped;
+}
+
+static PyObject* DoublyLinkedList_remove(PyObject* op, PyObject* args, PyObject* kwds)
+{
+    DoublyLinkedList* self = (DoublyLinkedList*)op;
+    int rslt = DoublyLinkedList_find(self, args, kwds, 0); if(rslt == -1) { return NULL; }
+    if(DoublyLinkedList_cursor_delete((PyObject*)self)) { return NULL; }
+    if(rslt == 1) { DoublyLinkedList_reset_cursor(self); } // The cursor position wasn't looked up
+    return Py_NewRef(Py_None);
+}
+
+static PyObject* DoublyLinkedList_extend(PyObject* op, PyObject* args, PyObject* kwds)
+{
+    DoublyLinkedList* self = (DoublyLinkedList* )op;
+    static char* kwlist[] = {"iterable", "forward", NULL};
+    PyObject* iterable;
+    int forward = 1;
+    if(!PyArg_ParseTupleAndKeywords(args, kwds, "O|i", kwlist, &iterable, &forward)) { return NULL; }
+    if(DoublyLinkedList_append_iterator((PyObject*)self, iterable, forward)) { return NULL; }
+    return Py_NewRef(Py_None);
+}
+
+static PyObject* DoublyLinkedList_copy(PyObject* op)
+{
+    DoublyLinkedList* self = (DoublyLinkedList*)op;
+    DoublyLinkedList* copy = (DoublyLinkedList*)DoublyLinkedList_new(&DoublyLinkedListType, NULL, NULL); if(!copy) { return NULL; }
+    if(DoublyLinkedList_enable(copy, self->index != NULL, self->hashed != NULL)) { Py_DECREF(copy); return NULL; }
+    DLLChain chain = {NULL, NULL, 0};
+    if(DLLChain_from_nodes(&chain, self->head, self->length, 1)) { Py_DECREF(copy); return NULL; }
+    if(chain.first) { DoublyLinkedList_link_chain(copy, chain.first, chain.last, chain.length, NULL, 0); }
+    return (PyObject*)copy;
+}
+
+// Relinks the nodes rather than swapping values so node handles keep referring to their element
+static PyObject* DoublyLinkedList_reverse(PyObject* op)
+{
+    DoublyLinkedList* self = (DoublyLinkedList*)op;
+    DLLNode* node = self->head;
+    while(node)
+    {
+        DLLNode* next = node->next;
+        node->next = node->prev;
+        node->prev = next;
+        node = next;
+    }
+    node = self->head;
+    self->head = self->tail;
+    self->tail = node;
+    if(self->cursor) { self->cursor_pos = self->length - 1 - self->cursor_pos; }
+    if(self->index) { DLLIndex_rebuild(self->index, self->head, self->length); }
+    if(self->hashed && !self->hashed->stale) { DLLHashIndex_reverse(self->hashed); }
+    self->mod_count += 1;
+    return Py_NewRef(Py_None);
+}
+
+static PyObject* DoublyLinkedList_count(PyObject* op, PyObject* args, PyObject* kwds)
+{
+    DoublyLinkedList* self = (DoublyLinkedList*)op;
+    static char* kwlist[] = {"value", NULL};
+    PyObject* value;
+    if(!PyArg_ParseTupleAndKeywords(args, kwds, "O", kwlist, &value)) { return NULL; }
+    Py_ssize_t count = 0;
+    int rslt = DoublyLinkedList_hash_lookup(self, value, &count, NULL); if(rslt == -1) { return NULL; }
+    if(rslt == 0) { return PyLong_FromSsize_t(count); }
+    DLLMatcher matcher;
+    DLLMatcher_init(&matcher, value);
+    DLLNode* temp = self->head;
+    size_t mod_count = self->mod_count;
+    for(Py_ssize_t i = 0; i<self->length; i++)
+    {
+        rslt = DLLMatcher_match(&matcher, temp->value);
+        if(rslt == -1) { return NULL; }
+        if(mod_count != self->mod_count)
+        {
+            PyErr_SetString(PyExc_RuntimeError, "DoublyLinkedList changed during count");
+            return NULL;
+        }
+        if(rslt) { count += 1; }
+        temp = temp->next;
+    }
+    PyObject* rtn = PyLong_FromSsize_t(count); if(!rtn) { return NULL; }
+    return rtn;
+}
+
+static PyObject* DoublyLinkedList_clear_method(PyObject* op, PyObject* args, PyObject* kwds)
+{
+    DoublyLinkedList* self = (DoublyLinkedList*)op;
+    static char* kwlist[] = {"deferred", NULL};
+    int deferred = 0;
+    if(!PyArg_ParseTupleAndKeywords(args, kwds, "|$p", kwlist, &deferred)) { return NULL; }
+    if(self->length == 0) { return Py_NewRef(Py_None); }
+    if(!deferred)
+    {
+        DoublyLinkedList_clear(op);
+        return Py_NewRef(Py_None);
+    }
+    // Only detach the chain here, the items are released later by release_deferred
+    DLLNode* head = self->head;
+    DLLNode* tail = self->tail;
+    Py_ssize_t length = self->length;
+    self->head = NULL; self->tail = NULL; self->cursor = NULL;
+    self->length = 0; self->cursor_pos = 0;
+    self->mod_count += 1;
+    if(self->index) { DLLIndex_clear(self->index); }
+    if(self->hashed) { DLLHashIndex_clear(self->hashed); }
+    for(DLLNode* node = head; node && self->handle_count > 0; node = node->next)
+    {
+        if(node->handle) { NodeHandle_invalidate(node->handle); }
+    }
+    DLLNode_defer_chain(head, tail, length);
+    return Py_NewRef(Py_None);
+}
+
+// Sort helpers. The list is sorted as a natural merge sort over the node chain: ascending and
+// strictly descending runs are detected, short runs are extended with binary insertion and runs
+// are merged by relinking next pointers under the timsort stack invariants. prev pointers are
+// rebuilt once at the end.
+
+#define DLL_SORT_MIN_MERGE 64
+#define DLL_SORT_MAX_PENDING 85
+
+typedef struct
+{
+    DLLNode* head;
+    DLLNode* tail;
+    Py_ssize_t length;
+} DLLRun;
+
+// When every sort key has the same exact type the comparison can skip the generic dispatch
+enum DLLSortKind { SORT_GENERIC, SORT_SAME_TYPE, SORT_FLOAT, SORT_LONG, SORT_UNICODE };
+
+typedef struct
+{
+    int operator;
+    int use_key;
+    enum DLLSortKind kind;
+    richcmpfunc type_compare;
+    Py_ssize_t run_count;
+    DLLRun runs[DLL_SORT_MAX_PENDING];
+} DLLSortState;
+
+static int DLLSort_compare_generic(DLLSortState* state, PyObject* a, PyObject* b)
+{
+    return PyObject_RichCompareBool(a, b, state->operator);
+}
+
+static int DLLSort_compare_same_type(DLLSortState* state, PyObject* a, PyObject* b)
+{
+    PyObject* result = state->type_compare(a, b, state->operator);
+    if(!result) { return -1; }
+    if(Py_Is(result, Py_NotImplemented))
+    {
+        Py_DECREF(result);
+        return PyObject_RichCompareBool(a, b, state->operator);
+    }
+    int rslt = Py_Is(result, Py_True) ? 1 : Py_Is(result, Py_False) ? 0 : PyObject_IsTrue(result);
+    Py_DECREF(result);
+    return rslt;
+}
+
+static int DLLSort_compare_native(DLLSortState* state, PyObject* a, PyObject* b)
+{
+    switch(state->kind)
+    {
+        case SORT_FLOAT:
+        {
+            double x = PyFloat_AS_DOUBLE(a), y = PyFloat_AS_DOUBLE(b);
+            return state->operator == Py_LT ? x < y : x > y;
+        }
+        case SORT_LONG:
+        {
+            int overflow_a, overflow_b;
+            long x = PyLong_AsLongAndOverflow(a, &overflow_a);
+            long y = PyLong_AsLongAndOverflow(b, &overflow_b);
+            if(overflow_a || overflow_b) { return DLLSort_compare_generic(state, a, b); }
+            return state->operator == Py_LT ? x < y : x > y;
+        }
+        case SORT_UNICODE:
+        {
+            int rslt = PyUnicode_Compare(a, b);
+            if(rslt == -1 && PyErr_Occurred()) { return -1; }
+            return state->operator == Py_LT ? rslt < 0 : rslt > 0;
+        }
+        case SORT_SAME_TYPE: return DLLSort_compare_same_type(state, a, b);
+        default: return DLLSort_compare_generic(state, a, b);
+    }
+}
+
+// Returns 1 if a has to be placed before b, 0 if not and -1 on error
+static inline int DLLSort_before(DLLSortState* state, DLLNode* a, DLLNode* b)
+{
+    PyObject* x = state->use_key ? a->key : a->value;
+    PyObject* y = state->use_key ? b->key : b->value;
+    DLL_STAT_ADD(sort_comparisons, 1);
+    if(state->kind == SORT_GENERIC) { return PyObject_RichCompareBool(x, y, state->operator); }
+    return DLLSort_compare_native(state, x, y);
+}
+
+static void DLLSort_select_kind(DLLSortState* state, DLLNode* head)
+{
+    PyObject* first = state->use_key ? head->key : head->value;
+    PyTypeObject* type = Py_TYPE(first);
+    state->kind = SORT_GENERIC;
+    state->type_compare = type->tp_richcompare;
+    if(!state->type_compare) { return; }
+    for(DLLNode* node = head->next; node; node = node->next)
+    {
+        if(!Py_IS_TYPE(state->use_key ? node->key : node->value, type)) { return; }
+    }
+    if(type == &PyFloat_Type) { state->kind = SORT_FLOAT; }
+    else if(type == &PyLong_Type) { state->kind = SORT_LONG; }
+    else if(type == &PyUnicode_Type) { state->kind = SORT_UNICODE; }
+    else { state->kind = SORT_SAME_TYPE; }
+}
+
+static Py_ssize_t DLLSort_min_run(Py_ssize_t n)
+{
+    Py_ssize_t r = 0;
+    while(n >= DLL_SORT_MIN_MERGE) { r |= n & 1; n >>= 1; }
+    return n + r;
+}
+
+// Merges run b into run a, a must come before b in the list. On error every node is still kept in a.
+static int DLLSort_merge(DLLSortState* state, DLLRun* a, DLLRun* b)
+{
+    // Runs that are already in order only need to be joined
+    int in_order = DLLSort_before(state, b->head, a->tail);
+    if(in_order == 0)
+    {
+        a->tail->next = b->head;
+        a->tail = b->tail;
+        a->length += b->length;
+        return 0;
+    }
+    DLLNode* head = NULL;
+    DLLNode** link = &head;
+    DLLNode* x = a->head;
+    DLLNode* y = b->head;
+    int rslt = in_order == -1 ? -1 : 0;
+    while(rslt == 0 && x && y)
+    {
+        int comparison = DLLSort_before(state, y, x);
+        if(comparison == -1) { rslt = -1; break; }
+        if(comparison) { *link = y; link = &y->next; y = y->next; }
+        else { *link = x; link = &x->next; x = x->next; }
+    }
+    DLLNode* tail;
+    if(x)
+    {
+        *link = x;
+        a->tail->next = y;
+        tail = y ? b->tail : a->tail;
+    }
+    else
+    {
+        *link = y;
+        tail = b->tail;
+    }
+    a->head = head;
+    a->tail = tail;
+    a->length += b->length;
+    return rslt;
+}
+
+static int DLLSort_merge_at(DLLSortState* state, Py_ssize_t i)
+{
+    int rslt = DLLSort_merge(state, &state->runs[i], &state->runs[i+1]);
+    for(Py_ssize_t j = i+1; j < state->run_count-1; j++) { state->runs[j] = state->runs[j+1]; }
+    state->run_count -= 1;
+    return rslt;
+}
+
+static int DLLSort_merge_collapse(DLLSortState* state)
+{
+    DLLRun* runs = state->runs;
+    while(state->run_count > 1)
+    {
+        Py_ssize_t n = state->run_count - 2;
+        if((n > 0 && runs[n-1].length <= runs[n].length + runs[n+1].length) ||
+           (n > 1 && runs[n-2].length <= runs[n-1].length + runs[n].length))
+        {
+            if(runs[n-1].length < runs[n+1].length) { n -= 1; }
+        }
+        else if(runs[n].length > runs[n+1].length) { break; }
+        if(DLLSort_merge_at(state, n)) { return -1; }
+    }
+    return 0;
+}
+
+// Cuts the next run off the front of remaining, extending it to min_run nodes with binary insertion
+static int DLLSort_next_run(DLLSortState* state, DLLNode** remaining, Py_ssize_t min_run, DLLRun* run)
+{
+    DLLNode* buffer[DLL_SORT_MIN_MERGE];
+    DLLNode* head = *remaining;
+    DLLNode* tail = head;
+    DLLNode* next = head->next;
+    Py_ssize_t length = 1;
+    int rslt = 0;
+    if(next)
+    {
+        int descending = DLLSort_before(state, next, head);
+        if(descending == -1) { rslt = -1; }
+        else
+        {
+            while(next)
+            {
+                int comparison = DLLSort_before(state, next, tail);
+                if(comparison == -1) { rslt = -1; break; }
+                if(comparison != descending) { break; }
+                tail = next; next = next->next; length += 1;
+            }
+            if(descending)
+            {
+                // Strictly descending, so reversing it keeps the sort stable
+                DLLNode* reversed = NULL;
+                DLLNode* node = head;
+                while(node != next)
+                {
+                    DLLNode* temp = node->next;
+                    node->next = reversed;
+                    reversed = node;
+                    node = temp;
+                }
+                tail = head;
+                head = reversed;
+            }
+        }
+    }
+    tail->next = NULL;
+    if(rslt == 0 && length < min_run && next)
+    {
+        Py_ssize_t count = 0;
+        for(DLLNode* node = head; node; node = node->next) { buffer[count++] = node; }
+        while(count < min_run && next)
+        {
+            DLLNode* node = next;
+            Py_ssize_t low = 0, high = count;
+            while(low < high)
+            {
+                Py_ssize_t middle = (low + high) / 2;
+                int comparison = DLLSort_before(state, node, buffer[middle]);
+                if(comparison == -1) { rslt = -1; break; }
+                if(comparison) { high = middle; }
+                else { low = middle + 1; }
+            }
+            if(rslt) { low = count; }
+            memmove(&buffer[low+1], &buffer[low], (count - low) * sizeof(DLLNode*));
+            buffer[low] = node;
+            count += 1;
+            next = next->next;
+            if(rslt) { break; }
+        }
+        for(Py_ssize_t i = 0; i < count-1; i++) { buffer[i]->next = buffer[i+1]; }
+        buffer[count-1]->next = NULL;
+        head = buffer[0];
+        tail = buffer[count-1];
+        length = count;
+    }
+    run->head = head;
+    run->tail = tail;
+    run->length = length;
+    *remaining = next;
+    return rslt;
+}
+
+static PyObject* DoublyLinkedList_sort(PyObject* op, PyObject* args, PyObject* kwds)
+{
+    DoublyLinkedList* self = (DoublyLinkedList*)op;
+    char* kwlist[] = {"key", "reverse", NULL};
+    PyObject* key = NULL; int reverse = 0;
+    if(!PyArg_ParseTupleAndKeywords(args, kwds, "|Oi", kwlist, &key, &reverse)) { return NULL; }
+    if(Py_IsNone(key)) { key = NULL; }
+    if(key && !PyCallable_Check(key)) { PyErr_SetString(PyExc_TypeError, "Key must be a callable"); return NULL; }
+    if(self->length < 2) { return Py_NewRef(Py_None); }
+
+    DLLSortState state;
+    state.operator = reverse ? Py_GT : Py_LT;
+    state.use_key = key != NULL;
+    state.run_count = 0;
+
+    // Detach the chain so key calls and comparisons that touch the list see it as empty
+    if(self->index) { DLLIndex_clear(self->index); }
+    DoublyLinkedList_hash_stale(self);
+    DLLNode* remaining = self->head;
+    Py_ssize_t length = self->length;
+    self->sort_tail = self->tail; // Sorting only relinks next, so the garbage collector can follow prev
+    self->head = NULL; self->tail = NULL; self->cursor = NULL;
+    self->length = 0; self->cursor_pos = 0;
+    self->mod_count += 1;
+
+    int rslt = 0;
+    if(key)
+    {
+        for(DLLNode* node = remaining; node; node = node->next)
+        {
+            node->key = PyObject_CallOneArg(key, node->value);
+            if(!node->key) { rslt = -1; break; }
+        }
+    }
+    if(rslt)
+    {
+        // Keep the original order, the keys are released with the rest below
+        state.runs[0].head = remaining;
+        remaining = NULL;
+    }
+    else { DLLSort_select_kind(&state, remaining); }
+
+    Py_ssize_t min_run = DLLSort_min_run(length);
+    while(remaining)
+    {
+        DLLRun* run = &state.runs[state.run_count++];
+        if(DLLSort_next_run(&state, &remaining, min_run, run)) { rslt = -1; break; }
+        if(DLLSort_merge_collapse(&state)) { rslt = -1; break; }
+    }
+    while(rslt == 0 && state.run_count > 1)
+    {
+        Py_ssize_t n = state.run_count - 2;
+        if(n > 0 && state.runs[n-1].length < state.runs[n+1].length) { n -= 1; }
+        if(DLLSort_merge_at(&state, n)) { rslt = -1; }
+    }
+    if(rslt && state.run_count > 0)
+    {
+        // Keep every node on a comparison error, the order is left partially sorted
+        for(Py_ssize_t i = 1; i < state.run_count; i++)
+        {
+            state.runs[0].tail->next = state.runs[i].head;
+            state.runs[0].tail = state.runs[i].tail;
+        }
+        state.runs[0].tail->next = remaining;
+    }
+
+    // Rebuild prev pointers and release keys
+    self->sort_tail = NULL;
+    DLLNode* head = state.runs[0].head;
+    DLLNode* prev = NULL;
+    for(DLLNode* node = head; node; node = node->next)
+    {
+        node->prev = prev;
+        Py_CLEAR(node->key);
+        prev = node;
+    }
+    if(self->head)
+    {
+        // Items were added while sorting, drop them like list.sort does
+        DLLNode* added = self->head;
+        self->head = NULL; self->tail = NULL; self->cursor = NULL;
+        self->length = 0; self->cursor_pos = 0;
+        if(self->index) { DLLIndex_clear(self->index); }
+        DLLNode_dealloc_chain(added);
+        if(!rslt) { PyErr_SetString(PyExc_ValueError, "list modified during sort"); rslt = -1; }
+    }
+    self->head = head;
+    self->tail = prev;
+    self->length = length;
+    self->cursor = head;
+    self->cursor_pos = 0;
+    self->mod_count += 1;
+    if(self->index) { DLLIndex_rebuild(self->index, head, length); }
+    DoublyLinkedList_hash_stale(self); // Lookups during the sort may have indexed the empty list
+    if(rslt) { return NULL; }
+    return Py_NewRef(Py_None);
+}
+
+// Node handle methods
+
+// Returns the node a handle refers to, raising ValueError if it is not a live node of this list
+static DLLNode* DoublyLinkedList_handle_node(DoublyLinkedList* self, PyObject* handle)
+{
+    NodeHandle* node_handle = (NodeHandle*)handle;
+    if(!node_handle->node)
+    {
+        PyErr_SetString(PyExc_ValueError, "Node has already been removed from its list");
+        return NULL;
+    }
+    if(node_handle->list != self)
+    {
+        PyErr_SetString(PyExc_ValueError, "Node belongs to a different list");
+        return NULL;
+    }
+    return node_handle->node;
+}
+
+// Handle operations change the list at an unknown index, so the cursor falls back to the head
+static void DoublyLinkedList_reset_cursor(DoublyLinkedList* self)
+{
+    self->cursor = self->head;
+    self->cursor_pos = 0;
+}
+
+// Points the cursor at node for a cursor operation. Its position only matters to indexed lists,
+// which can look it up in O(log n).
+static void DoublyLinkedList_cursor_to_node(DoublyLinkedList* self, DLLNode* node)
+{
+    self->cursor = node;
+    if(self->index) { self->cursor_pos = DLLIndex_position(self->index, node); }
+    else
+    {
+        // The change can't be placed relative to them
+        DoublyLinkedList_clear_fingers(self);
+        DoublyLinkedList_forget_cursors(self);
+    }
+}
+
+static PyObject* DoublyLinkedList_append_node(PyObject* op, PyObject* args, PyObject* kwds)
+{
+    DoublyLinkedList* self = (DoublyLinkedList*)op;
+    PyObject* rslt = DoublyLinkedList_append(op, args, kwds); if(!rslt) { return NULL; }
+    Py_DECREF(rslt);
+    return NodeHandle_for(self, self->cursor);
+}
+
+static PyObject* DoublyLinkedList_insert_node(PyObject* op, PyObject* args, PyObject* kwds)
+{
+    DoublyLinkedList* self = (DoublyLinkedList*)op;
+    PyObject* rslt = DoublyLinkedList_insert(op, args, kwds); if(!rslt) { return NULL; }
+    Py_DECREF(rslt);
+    return NodeHandle_for(self, self->cursor);
+}
+
+static PyObject* DoublyLinkedList_node_at(PyObject* op, PyObject* args, PyObject* kwds)
+{
+    DoublyLinkedList* self = (DoublyLinkedList*)op;
+    static char* kwlist[] = {"index", NULL};
+    Py_ssize_t index;
+    if(!PyArg_ParseTupleAndKeywords(args, kwds, "n", kwlist, &index)) { return NULL; }
+    if(DoublyLinkedList_locate((PyObject*)self, index)) { return NULL; }
+    return NodeHandle_for(self, self->cursor);
+}
+
+// A new cursor is independent of the list's own cursor, index may be the length of the list to
+// start at its end
+static PyObject* DoublyLinkedList_new_cursor(PyObject* op, PyObject* args, PyObject* kwds)
+{
+    DoublyLinkedList* self = (DoublyLinkedList*)op;
+    static char* kwlist[] = {"index", NULL};
+    Py_ssize_t index = 0;
+    if(!PyArg_ParseTupleAndKeywords(args, kwds, "|n", kwlist, &index)) { return NULL; }
+    if(index == self->length) { return Cursor_for(self, NULL, self->length); }
+    if(DoublyLinkedList_locate((PyObject*)self, index)) { return NULL; }
+    return Cursor_for(self, self->cursor, self->cursor_pos);
+}
+
+static PyObject* DoublyLinkedList_remove_node(PyObject* op, PyObject* args, PyObject* kwds)
+{
+    DoublyLinkedList* self = (DoublyLinkedList*)op;
+    static char* kwlist[] = {"node", NULL};
+    PyObject* handle;
+    if(!PyArg_ParseTupleAndKeywords(args, kwds, "O!", kwlist, &NodeHandleType, &handle)) { return NULL; }
+    DLLNode* node = DoublyLinkedList_handle_node(self, handle); if(!node) { return NULL; }
+    PyObject* value = Py_NewRef(node->value);
+    DoublyLinkedList_cursor_to_node(self, node);
+    if(DoublyLinkedList_cursor_delete((PyObject*)self)) { Py_DECREF(value); return NULL; }
+    DoublyLinkedList_reset_cursor(self);
+    return value;
+}
+
+static PyObject* DoublyLinkedList_insert_at_node(DoublyLinkedList* self, PyObject* args, PyObject* kwds, int forward)
+{
+    static char* kwlist[] = {"node", "object", NULL};
+    PyObject* handle;
+    PyObject* object;
+    if(!PyArg_ParseTupleAndKeywords(args, kwds, "O!O", kwlist, &NodeHandleType, &handle, &object)) { return NULL; }
+    DLLNode* node = DoublyLinkedList_handle_node(self, handle); if(!node) { return NULL; }
+    DoublyLinkedList_cursor_to_node(self, node);
+    int rslt = DoublyLinkedList_cursor_insert((PyObject*)self, object, forward);
+    DLLNode* inserted = self->cursor;
+    DoublyLinkedList_reset_cursor(self);
+    if(rslt) { return NULL; }
+    return NodeHandle_for(self, inserted);
+}
+
+static PyObject* DoublyLinkedList_insert_after(PyObject* op, PyObject* args, PyObject* kwds)
+{
+    return DoublyLinkedList_insert_at_node((DoublyLinkedList*)op, args, kwds, 1);
+}
+
+static PyObject* DoublyLinkedList_insert_before(PyObject* op, PyObject* args, PyObject* kwds)
+{
+    return DoublyLinkedList_insert_at_node((DoublyLinkedList*)op, args, kwds, 0);
+}
+
+static PyObject* DoublyLinkedList_move_to_end(PyObject* op, PyObject* args, PyObject* kwds)
+{
+    DoublyLinkedList* self = (DoublyLinkedList*)op;
+    static char* kwlist[] = {"node", "forward", NULL};
+    PyObject* handle;
+    int forward = 1;
+    if(!PyArg_ParseTupleAndKeywords(args, kwds, "O!|i", kwlist, &NodeHandleType, &handle, &forward)) { return NULL; }
+    DLLNode* node = DoublyLinkedList_handle_node(self, handle); if(!node) { return NULL; }
+    if(node == (forward ? self->tail : self->head)) { return Py_NewRef(Py_None); }
+    if(self->index) { DLLIndex_remove(self->index, node, DLLIndex_position(self->index, node)); }
+    if(node->prev) { node->prev->next = node->next; } else { self->head = node->next; }
+    if(node->next) { node->next->prev = node->prev; } else { self->tail = node->prev; }
+    if(forward)
+    {
+        node->prev = self->tail;
+        node->next = NULL;
+        self->tail->next = node;
+        self->tail = node;
+    }
+    else
+    {
+        node->next = self->head;
+        node->prev = NULL;
+        self->head->prev = node;
+        self->head = node;
+    }
+    if(self->index) { DLLIndex_insert(self->index, node, forward ? self->length-1 : 0, self->length-1); }
+    if(self->hashed && !self->hashed->stale) { DLLHashIndex_move_to_end(self->hashed, node, forward ? 1 : -1); }
+    DoublyLinkedList_reset_cursor(self);
+    self->mod_count += 1;
+    return Py_NewRef(Py_None);
+}
+
+// Splice and split
+
+// Links the detached chain first..last of count nodes in after prev, or at the head if prev is
+// NULL, and points the cursor at first, which ends up at position
+static void DoublyLinkedList_link_chain(DoublyLinkedList* self, DLLNode* first, DLLNode* last, Py_ssize_t count, DLLNode* prev, Py_ssize_t position)
+{
+    DLLNode* next = prev ? prev->next : self->head;
+    first->prev = prev;
+    last->next = next;
+    if(prev) { prev->next = first; } else { self->head = first; }
+    if(next) { next->prev = last; } else { self->tail = last; }
+    // A short chain is cheaper to add to the index node by node than to rebuild it
+    if(self->index && count * 8 < self->length)
+    {
+        DLLNode* node = first;
+        for(Py_ssize_t i = 0; i < count; i++, node = node->next)
+        {
+            DLLIndex_insert(self->index, node, position + i, self->length + i);
+        }
+    }
+    self->length += count;
+    DLL_STAT_PEAK(self->length);
+    self->mod_count += 1;
+    DoublyLinkedList_shift_cursors(self, position, count);
+    DoublyLinkedList_hash_stale(self);
+    self->cursor = first;
+    self->cursor_pos = position;
+    if(self->index && count * 8 >= self->length - count) { DLLIndex_rebuild(self->index, self->head, self->length); }
+}
+
+// Re-points the handles of a chain that moved from one list to another. Only walks the chain
+// while the old list still has handles, so moving nodes without handles stays O(1).
+static void DoublyLinkedList_move_handles(DoublyLinkedList* from, DoublyLinkedList* to, DLLNode* node)
+{
+    for(; node && from->handle_count > 0; node = node->next)
+    {
+        if(!node->handle) { continue; }
+        DLL_MUTEX_LOCK(handle_mutex);
+        node->handle->list = (DoublyLinkedList*)Py_NewRef((PyObject*)to);
+        DLL_MUTEX_UNLOCK(handle_mutex);
+        Py_DECREF(from);
+        from->handle_count -= 1;
+        to->handle_count += 1;
+    }
+}
+
+static PyObject* DoublyLinkedList_splice(PyObject* op, PyObject* args, PyObject* kwds)
+{
+    DoublyLinkedList* self = (DoublyLinkedList*)op;
+    static char* kwlist[] = {"other", "index", "forward", NULL};
+    DoublyLinkedList* other;
+    PyObject* index_obj = Py_None;
+    int forward = 1;
+    if(!PyArg_ParseTupleAndKeywords(args, kwds, "O!|Oi", kwlist, &DoublyLinkedListType, &other, &index_obj, &forward)) { return NULL; }
+    if(other == self)
+    {
+        PyErr_SetString(PyExc_ValueError, "Can not splice a list into itself");
+        return NULL;
+    }
+    DLLNode* prev;
+    Py_ssize_t position;
+    if(index_obj == Py_None)
+    {
+        prev = forward ? self->tail : NULL;
+        position = forward ? self->length : 0;
+    }
+    else
+    {
+        Py_ssize_t index = PyNumber_AsSsize_t(index_obj, PyExc_IndexError); if(index == -1 && PyErr_Occurred()) { return NULL; }
+        if(DoublyLinkedList_locate((PyObject*)self, index)) { return NULL; }
+        prev = forward ? self->cursor : self->cursor->prev;
+        position = forward ? self->cursor_pos + 1 : self->cursor_pos;
+    }
+    if(other->length == 0) { return Py_NewRef(Py_None); }
+    DLLNode* first = other->head;
+    DLLNode* last = other->tail;
+    Py_ssize_t count = other->length;
+    other->head = NULL; other->tail = NULL; other->cursor = NULL;
+    other->length = 0; other->cursor_pos = 0;
+    other->mod_count += 1;
+    if(other->index) { DLLIndex_clear(other->index); }
+    if(other->hashed) { DLLHashIndex_clear(other->hashed); }
+    DoublyLinkedList_move_handles(other, self, first);
+    DoublyLinkedList_link_chain(self, first, last, count, prev, position);
+    return Py_NewRef(Py_None);
+}
+
+static PyObject* DoublyLinkedList_split(PyObject* op, PyObject* args, PyObject* kwds)
+{
+    DoublyLinkedList* self = (DoublyLinkedList*)op;
+    static char* kwlist[] = {"index", NULL};
+    Py_ssize_t index;
+    if(!PyArg_ParseTupleAndKeywords(args, kwds, "n", kwlist, &index)) { return NULL; }
+    if(index < 0) { index += self->length; }
+    if(index < 0 || index > self->length)
+    {
+        PyErr_SetString(PyExc_IndexError, "Index out of bounds");
+        return NULL;
+    }
+    DoublyLinkedList* split = (DoublyLinkedList*)DoublyLinkedList_new(&DoublyLinkedListType, NULL, NULL); if(!split) { return NULL; }
+    if(DoublyLinkedList_enable(split, self->index != NULL, self->hashed != NULL)) { Py_DECREF(split); return NULL; }
+    if(index == self->length) { return (PyObject*)split; }
+    DoublyLinkedList_locate((PyObject*)self, index);
+    DLLNode* first = self->cursor;
+    DLLNode* last = self->tail;
+    self->tail = first->prev;
+    if(self->tail) { self->tail->next = NULL; } else { self->head = NULL; }
+    first->prev = NULL;
+    last->next = NULL;
+    Py_ssize_t count = self->length - index;
+    self->length = index;
+    self->mod_count += 1;
+    DoublyLinkedList_reset_cursor(self);
+    if(self->index) { DLLIndex_rebuild(self->index, self->head, self->length); }
+    DoublyLinkedList_hash_stale(self);
+    DoublyLinkedList_move_handles(self, split, first);
+    DoublyLinkedList_link_chain(split, first, last, count, NULL, 0);
+    return (PyObject*)split;
+}
+
+// Internal Methods
+
+static inline int DLLFinger_valid(DoublyLinkedList* self, DLLFinger* finger)
+{
+    return finger->node && finger->mod_count == self->mod_count;
+}
+
+static void DoublyLinkedList_clear_fingers(DoublyLinkedList* self)
+{
+    for(int i = 0; i < DLL_FINGERS; i++) { self->fingers[i].node = NULL; }
+}
+
+// Leaves a finger at the cursor before it moves far away to target
+static void DoublyLinkedList_save_cursor(DoublyLinkedList* self, Py_ssize_t target)
+{
+    if(!self->cursor || labs(target - self->cursor_pos) < DLL_FINGER_MIN_GAP) { return; }
+    // Reuse a finger already in the cursor's region, otherwise a free or the least recently used one
+    DLLFinger* slot = &self->fingers[0];
+    for(int i = 0; i < DLL_FINGERS; i++)
+    {
+        DLLFinger* finger = &self->fingers[i];
+        if(!DLLFinger_valid(self, finger)) { finger->used = 0; }
+        else if(labs(finger->pos - self->cursor_pos) < DLL_FINGER_MIN_GAP) { slot = finger; break; }
+        if(finger->used < slot->used) { slot = finger; }
+    }
+    slot->node = self->cursor;
+    slot->pos = self->cursor_pos;
+    slot->mod_count = self->mod_count;
+    slot->used = ++self->finger_clock;
+}
+
+// Moves the fingers past an insertion (delta 1) at position or the removal (delta -1) of the node
+// at position. Called right after mod_count was bumped for the change.
+static void DoublyLinkedList_shift_fingers(DoublyLinkedList* self, Py_ssize_t position, Py_ssize_t delta, DLLNode* removed)
+{
+    for(int i = 0; i < DLL_FINGERS; i++)
+    {
+        DLLFinger* finger = &self->fingers[i];
+        if(!finger->node || finger->mod_count + 1 != self->mod_count) { continue; }
+        if(finger->node == removed) { finger->node = NULL; continue; }
+        if(delta > 0 ? finger->pos >= position : finger->pos > position) { finger->pos += delta; }
+        finger->mod_count = self->mod_count;
+    }
+}
+
+// Moves the positions of the Cursors past an insertion of delta nodes at position, or the removal
+// (delta -1) of the node at position, like shift_fingers. Cursors that missed an earlier change keep
+// their old mod_count and look their position up again when it is read.
+static void DoublyLinkedList_shift_cursors(DoublyLinkedList* self, Py_ssize_t position, Py_ssize_t delta)
+{
+    for(Cursor* cursor = self->cursors; cursor; cursor = cursor->next)
+    {
+        if(cursor->mod_count + 1 != self->mod_count) { continue; }
+        if(delta > 0 ? cursor->pos >= position : cursor->pos > position) { cursor->pos += delta; }
+        cursor->mod_count = self->mod_count;
+    }
+}
+
+// Makes every Cursor look its position up again, for a change that can't be placed relative to them.
+// A mod_count two behind the list's after the change is never taken up by shift_cursors.
+static void DoublyLinkedList_forget_cursors(DoublyLinkedList* self)
+{
+    for(Cursor* cursor = self->cursors; cursor; cursor = cursor->next) { cursor->mod_count = self->mod_count - 1; }
+}
+
+// Returns the position of a node of the list. Indexed lists look it up in O(log n), others walk out
+// from node in both directions until they reach the cursor, a finger or an end of the list.
+static Py_ssize_t DoublyLinkedList_position(DoublyLinkedList* self, DLLNode* node)
+{
+    if(self->index) { return DLLIndex_position(self->index, node); }
+    DLLNode* back = node;
+    DLLNode* ahead = node;
+    for(Py_ssize_t steps = 0;; steps++, back = back->prev, ahead = ahead->next)
+    {
+        if(!back->prev) { return steps; }
+        if(!ahead->next) { return self->length - 1 - steps; }
+        if(back == self->cursor) { return self->cursor_pos + steps; }
+        if(ahead == self->cursor) { return self->cursor_pos - steps; }
+        for(int i = 0; i < DLL_FINGERS; i++)
+        {
+            DLLFinger* finger = &self->fingers[i];
+            if(!DLLFinger_valid(self, finger)) { continue; }
+            if(finger->node == back) { return finger->pos + steps; }
+            if(finger->node == ahead) { return finger->pos - steps; }
+        }
+    }
+}
+
+// Takes in DoublyLinkedList and index, locates node at that index and sets cursor to it
+static int DoublyLinkedList_locate(PyObject* op, Py_ssize_t index)
+{
+    DoublyLinkedList* self = (DoublyLinkedList*)op;
+    if(index < 0) { index = self->length + index; }
+    if(index >= self->length || index < 0)
+    {
+        PyErr_SetString(PyExc_IndexError, "Index out of bounds");
+        return -1;
+    }
+    DLLNode* search_node = self->cursor;
+    Py_ssize_t search_distance = index-self->cursor_pos;
+    const Py_ssize_t head_distance = index;
+    const Py_ssize_t tail_distance = index-(self->length-1);
+#ifdef DLL_STATS
+    Py_ssize_t* steps = &dll_stats.steps_cursor;
+    Py_ssize_t* anchor = &dll_stats.locate_cursor;
+#endif
+    if(labs(head_distance) < labs(search_distance))
+    {
+        search_node = self->head;
+        search_distance = head_distance;
+#ifdef DLL_STATS
+        steps = &dll_stats.steps_head;
+        anchor = &dll_stats.locate_head;
+#endif
+    }
+    else if(labs(tail_distance) < labs(search_distance))
+    {
+        search_node = self->tail;
+        search_distance = tail_distance;
+#ifdef DLL_STATS
+        steps = &dll_stats.steps_tail;
+        anchor = &dll_stats.locate_tail;
+#endif
+    }
+    // Short walks from the cursor, head or tail are left alone
+    DLLFinger* finger = NULL;
+    for(int i = 0; i < DLL_FINGERS && labs(search_distance) >= DLL_FINGER_MIN_GAP; i++)
+    {
+        if(DLLFinger_valid(self, &self->fingers[i]) && labs(index - self->fingers[i].pos) < labs(search_distance))
+        {
+            finger = &self->fingers[i];
+            search_node = finger->node;
+            search_distance = index - finger->pos;
+        }
+    }
+    if(finger)
+    {
+#ifdef DLL_STATS
+        steps = &dll_stats.steps_finger;
+        anchor = &dll_stats.locate_finger;
+#endif
+        // The cursor takes over the finger's region and the finger keeps the one the cursor leaves
+        finger->used = ++self->finger_clock;
+        if(labs(index - self->cursor_pos) >= DLL_FINGER_MIN_GAP)
+        {
+            finger->node = self->cursor;
+            finger->pos = self->cursor_pos;
+        }
+    }
+    else { DoublyLinkedList_save_cursor(self, index); }
+    if(self->index && labs(search_distance) > DLL_INDEX_WALK)
+    {
+        DLL_STAT_ADD(locate_index, 1);
+        self->cursor = DLLIndex_find(self->index, self->head, index);
+        self->cursor_pos = index;
+        return 0;
+    }
+#ifdef DLL_STATS
+    DLL_STAT_ADD_TO(*anchor, 1);
+    DLL_STAT_ADD_TO(*steps, labs(search_distance));
+#endif
+    if(search_distance>0)
+    {
+        for(Py_ssize_t i = 0; i<search_distance; i++)
+        {
+            search_node = search_node->next;
+        }
+    }
+    else if(search_distance<0)
+    {
+        for(Py_ssize_t i=0; i>search_distance; i--)
+        {
+            search_node = search_node->prev;
+        }
+    }
+    self->cursor = search_node;
+    self->cursor_pos = index;
+    return 0;
+}
+
+// Hash index upkeep
+
+// Hashes value for the hash index. Hashing can run python code, so the cursor is put back
+// afterwards and RuntimeError is raised if the list changed. Returns 1 with no error set if value
+// is unhashable.
+static int DoublyLinkedList_hash_value(DoublyLinkedList* self, PyObject* value, Py_hash_t* hash)
+{
+    DLLNode* cursor = self->cursor;
+    Py_ssize_t cursor_pos = self->cursor_pos;
+    size_t mod_count = self->mod_count;
+    Py_INCREF(value);
+    *hash = PyObject_Hash(value);
+    Py_DECREF(value);
+    if(mod_count != self->mod_count)
+    {
+        if(*hash != -1) { PyErr_SetString(PyExc_RuntimeError, "DoublyLinkedList changed during hashing"); }
+        return -1;
+    }
+    self->cursor = cursor;
+    self->cursor_pos = cursor_pos;
+    if(*hash != -1) { return 0; }
+    if(!PyErr_ExceptionMatches(PyExc_TypeError)) { return -1; }
+    PyErr_Clear();
+    return 1;
+}
+
+// Finds the group of the items equal to value. Returns 1 and sets slot if there is one, 0 if not.
+// Comparing value to the first item of each group with the same hash can run python code, so the
+// cursor is put back afterwards and RuntimeError is raised if the list or the index changed.
+static int DoublyLinkedList_hash_group(DoublyLinkedList* self, PyObject* value, Py_hash_t hash, size_t* slot)
+{
+    DLLHashIndex* hashed = self->hashed;
+    DLLHashGroup* groups = hashed->groups;
+    DLLNode* cursor = self->cursor;
+    Py_ssize_t cursor_pos = self->cursor_pos;
+    size_t mod_count = self->mod_count;
+    size_t stale_count = hashed->stale_count;
+    DLLMatcher matcher;
+    DLLMatcher_init(&matcher, value);
+    int found = 0;
+    for(size_t i = (size_t)hash & hashed->group_mask; groups[i].first; i = (i + DLL_HASH_STRIDE(hash)) & hashed->group_mask)
+    {
+        if(groups[i].first == DLL_HASH_DUMMY || groups[i].hash != hash) { continue; }
+        int rslt = DLLMatcher_match(&matcher, groups[i].first->value); if(rslt == -1) { return -1; }
+        if(mod_count != self->mod_count || stale_count != hashed->stale_count || groups != hashed->groups)
+        {
+            PyErr_SetString(PyExc_RuntimeError, "DoublyLinkedList changed during search");
+            return -1;
+        }
+        if(rslt) { *slot = i; found = 1; break; }
+    }
+    self->cursor = cursor;
+    self->cursor_pos = cursor_pos;
+    return found;
+}
+
+// Adds entries for count nodes from node on, walking forwards and placing each after the items
+// equal to it if forward is set, otherwise walking backwards and placing each before them. The
+// index is marked busy by the caller, so lookups made while hashing don't use the half filled
+// tables, and RuntimeError is raised if hashing changed the list or one of its values.
+static int DoublyLinkedList_hash_chain(DoublyLinkedList* self, DLLNode* node, Py_ssize_t count, int forward)
+{
+    DLLHashIndex* hashed = self->hashed;
+    if(DLLHashIndex_reserve(hashed, count, 0)) { return -1; }
+    size_t stale_count = hashed->stale_count;
+    for(Py_ssize_t i = 0; i < count; i++, node = forward ? node->next : node->prev)
+    {
+        Py_hash_t hash;
+        size_t slot = 0;
+        int found = 0;
+        int unhashable = DoublyLinkedList_hash_value(self, node->value, &hash); if(unhashable == -1) { return -1; }
+        if(!unhashable)
+        {
+            if(DLLHashIndex_reserve(hashed, 0, 1)) { return -1; }
+            found = DoublyLinkedList_hash_group(self, node->value, hash, &slot); if(found == -1) { return -1; }
+        }
+        if(stale_count != hashed->stale_count)
+        {
+            PyErr_SetString(PyExc_RuntimeError, "DoublyLinkedList changed during hashing");
+            return -1;
+        }
+        if(unhashable) { hashed->unhashable += 1; }
+        else { DLLHashIndex_add(hashed, node, hash, slot, found, forward ? 1 : -1); }
+    }
+    return 0;
+}
+
+// Rebuilds a stale hash index from the items
+static int DoublyLinkedList_hash_rebuild(DoublyLinkedList* self)
+{
+    DLLHashIndex* hashed = self->hashed;
+    if(DLLHashIndex_reset(hashed, self->length)) { return -1; }
+    hashed->busy = 1;
+    int rslt = DoublyLinkedList_hash_chain(self, self->head, self->length, 1);
+    hashed->busy = 0;
+    if(!rslt) { hashed->stale = 0; }
+    return rslt;
+}
+
+// Stores value in node and returns the old value, keeping the hash index up to date. The new value
+// is hashed and its group found before anything changes, a node that stays in its group keeps its
+// entry.
+static PyObject* DoublyLinkedList_swap_value(DoublyLinkedList* self, DLLNode* node, PyObject* value)
+{
+    DLLHashIndex* hashed = self->hashed;
+    if(hashed && !hashed->stale)
+    {
+        Py_hash_t hash;
+        size_t slot = 0;
+        int unhashable = DoublyLinkedList_hash_value(self, value, &hash); if(unhashable == -1) { return NULL; }
+        int found = 0;
+        if(!unhashable)
+        {
+            if(DLLHashIndex_reserve(hashed, 1, 1)) { return NULL; }
+            found = DoublyLinkedList_hash_group(self, value, hash, &slot); if(found == -1) { return NULL; }
+        }
+        DLLHashMember* member = DLLHashIndex_member(hashed, node);
+        if(!found || !member || member->group != slot)
+        {
+            DLLHashIndex_forget(hashed, node);
+            // Forgetting node may have emptied the group
+            if(found && !DLL_HASH_LIVE(hashed->groups[slot].first)) { found = 0; }
+            if(unhashable) { hashed->unhashable += 1; }
+            else { DLLHashIndex_add(hashed, node, hash, slot, found, 0); }
+        }
+    }
+    else { DoublyLinkedList_hash_stale(self); }
+    PyObject* old_value = node->value;
+    node->value = Py_NewRef(value);
+    return old_value;
+}
+
+// Finds the items equal to value through the hash index. Sets count and, unless first is NULL, the
+// first of them in list order. Returns 1 if the list has to be scanned instead, because it isn't
+// hashed or value or one of the items is unhashable.
+static int DoublyLinkedList_hash_lookup(DoublyLinkedList* self, PyObject* value, Py_ssize_t* count, DLLNode** first)
+{
+    DLLHashIndex* hashed = self->hashed;
+    if(!hashed || hashed->busy) { return 1; }
+    Py_hash_t hash = PyObject_Hash(value);
+    if(hash == -1)
+    {
+        if(!PyErr_ExceptionMatches(PyExc_TypeError)) { return -1; }
+        PyErr_Clear();
+        return 1;
+    }
+    if(hashed->stale && DoublyLinkedList_hash_rebuild(self)) { return -1; }
+    if(hashed->unhashable > 0) { return 1; }
+    size_t slot = 0;
+    int found = DoublyLinkedList_hash_group(self, value, hash, &slot); if(found == -1) { return -1; }
+    *count = found ? hashed->groups[slot].count : 0;
+    if(first) { *first = found ? hashed->groups[slot].first : NULL; }
+    return 0;
+}
+
+// Create a new node with value and inserts it forwards or backwards and sets cursor to it.
+static int DoublyLinkedList_cursor_insert(PyObject* op, PyObject* object, int forward)
+{
+    DoublyLinkedList* self = (DoublyLinkedList*)op;
+    // Hash and find the group before changing anything, both can fail or run python code
+    DLLHashIndex* hashed = self->hashed && !self->hashed->stale ? self->hashed : NULL;
+    Py_hash_t hash = -1;
+    int unhashable = 0;
+    size_t slot = 0;
+    int found = 0;
+    if(hashed)
+    {
+        unhashable = DoublyLinkedList_hash_value(self, object, &hash); if(unhashable == -1) { return -1; }
+        if(!unhashable)
+        {
+            if(DLLHashIndex_reserve(hashed, 1, 1)) { return -1; }
+            found = DoublyLinkedList_hash_group(self, object, hash, &slot); if(found == -1) { return -1; }
+        }
+    }
+    DLLNode* node = DLLNode_new(); if(!node) { return -1; }
+    Py_ssize_t position = !self->cursor ? 0 : forward ? self->cursor_pos + 1 : self->cursor_pos;
+    if(self->index) { DLLIndex_insert(self->index, node, position, self->length); }
+    self->length += 1;
+    DLL_STAT_PEAK(self->length);
+    self->mod_count += 1;
+    DoublyLinkedList_shift_fingers(self, position, 1, NULL);
+    DoublyLinkedList_shift_cursors(self, position, 1);
+    Py_SETREF(node->value, Py_NewRef(object));
+    if(self->cursor == NULL)
+    {
+        self->head = node;
+        self->tail = node;
+        self->cursor = node;
+    }
+    else
+    {
+        DLLNode* cursor = self->cursor;
+        if(forward)
+        {
+            self->cursor_pos += 1;
+            if(cursor->next == NULL)
+            {
+                node->prev = cursor;
+                self->tail = node;
+                cursor->next = node;
+            }
+            else
+            {
+                DLLNode* temp = cursor->next;
+                node->prev = cursor;
+                temp->prev = node;
+                node->next = temp;
+                cursor->next = node;
+            }
+        }
+        else
+        {
+            if(cursor->prev == NULL)
+            {
+                cursor->prev = node;
+                self->head = node;
+                node->next = cursor;
+            }
+            else
+            {
+                DLLNode* temp = cursor->prev;
+                node->prev = temp;
+                cursor->prev = node;
+                temp->next = node;
+                node->next = cursor;
+            }
+        }
+    }
+    self->cursor = node;
+    if(hashed && unhashable) { hashed->unhashable += 1; }
+    else if(hashed) { DLLHashIndex_add(hashed, node, hash, slot, found, !node->next ? 1 : !node->prev ? -1 : 0); }
+    return 0;
+}
+
+static int DoublyLinkedList_cursor_delete(PyObject* op)
+{
+    DoublyLinkedList* self = (DoublyLinkedList*)op;
+    if(self->hashed && !self->hashed->stale) { DLLHashIndex_forget(self->hashed, self->cursor); }
+    self->length -= 1;
+    self->mod_count += 1;
+    DLLNode* cursor = self->cursor;
+    DoublyLinkedList_shift_fingers(self, self->cursor_pos, -1, cursor);
+    DoublyLinkedList_shift_cursors(self, self->cursor_pos, -1);
+    if(self->index) { DLLIndex_remove(self->index, cursor, self->cursor_pos); }
+    if(cursor->next == NULL)
+    {
+        if(cursor->prev == NULL)
+        {
+            self->head = NULL;
+            self->tail = NULL;
+            self->cursor = NULL;
+        }
+        else
+        {
+            self->tail = cursor->prev;
+            self->cursor = cursor->prev;
+            (cursor->prev)->next = cursor->next;
+            self->cursor_pos-=1;
+        }
+    }
+    else
+    {
+        (cursor->next)->prev = cursor->prev;
+        self->cursor = cursor->next;
+        if(cursor->prev == NULL) { self->head = cursor->next; }
+        else { (cursor->prev)->next = cursor->next; }
+    }
+    DLLNode_dealloc(cursor);
+    return 0;
+}
+
+// Builds the new items as a detached chain and links it in once, so the cursor and index are only
+// updated at the end. Lists, tuples and DoublyLinkedLists are copied straight from their storage,
+// other iterables are sized with their length hint. Items read before an error are kept.
+static int DoublyLinkedList_append_iterator(PyObject* op, PyObject* iterable, int forward)
+{
+    DoublyLinkedList* self = (DoublyLinkedList*)op;
+    DLLChain chain = {NULL, NULL, 0};
+    int rslt = 0;
+    if(PyList_CheckExact(iterable) || PyTuple_CheckExact(iterable))
+    {
+        DLL_BEGIN_CRITICAL_SECTION_SEQUENCE_FAST(iterable);
+        rslt = DLLChain_from_array(&chain, PySequence_Fast_ITEMS(iterable), PySequence_Fast_GET_SIZE(iterable), forward);
+        DLL_END_CRITICAL_SECTION_SEQUENCE_FAST();
+    }
+    else if(iterable == op)
+    {
+        rslt = DLLChain_from_nodes(&chain, forward ? self->head : self->tail, self->length, forward);
+    }
+    else if(PyObject_TypeCheck(iterable, &DoublyLinkedListType))
+    {
+        DoublyLinkedList* other = (DoublyLinkedList*)iterable;
+        Py_BEGIN_CRITICAL_SECTION(other);
+        rslt = DLLChain_from_nodes(&chain, forward ? other->head : other->tail, other->length, forward);
+        Py_END_CRITICAL_SECTION();
+    }
+    else
+    {
+        PyObject* iterator = PyObject_GetIter(iterable); if(!iterator) { return -1; }
+        Py_ssize_t hint = PyObject_LengthHint(iterable, 0);
+        if(hint < 0) { Py_DECREF(iterator); return -1; }
+        DLL_MUTEX_LOCK(node_pool_mutex);
+        rslt = DLLNodePool_reserve(hint);
+        DLL_MUTEX_UNLOCK(node_pool_mutex);
+        if(rslt) { Py_DECREF(iterator); return -1; }
+        PyObject* item;
+        while((item = PyIter_Next(iterator)) != NULL)
+        {
+            rslt = forward ? DLLChain_append(&chain, item) : DLLChain_prepend(&chain, item);
+            Py_DECREF(item);
+            if(rslt) { break; }
+        }
+        Py_DECREF(iterator);
+        if(PyErr_Occurred()) { rslt = -1; }
+    }
+    if(chain.first)
+    {
+        // An up to date hash index only needs entries for the new items
+        DLLHashIndex* hashed = !rslt && self->hashed && !self->hashed->stale ? self->hashed : NULL;
+        DLLNode* prev = forward ? self->tail : NULL;
+        DoublyLinkedList_link_chain(self, chain.first, chain.last, chain.length, prev, forward ? self->length : 0);
+        if(hashed)
+        {
+            hashed->busy = 1;
+            // The chain goes after every item at the end of the list or before them at the start
+            rslt = forward ? DoublyLinkedList_hash_chain(self, chain.first, chain.length, 1) : DoublyLinkedList_hash_chain(self, chain.last, chain.length, 0);
+            hashed->busy = 0;
+            if(!rslt) { hashed->stale = 0; }
+        }
+    }
+    return rslt;
+}
+
+// The other side of a comparison. DoublyLinkedLists are read node by node and exact lists and
+// tuples straight from their storage, other iterables through an iterator.
+typedef struct
+{
+    DoublyLinkedList* list;
+    DLLNode* node;
+    size_t mod_count;
+    PyObject* sequence;
+    Py_ssize_t index;
+    PyObject* iterator;
+} DLLCompareSource;
+
+// Returns a new reference to the next item, NULL at the end or on error
+static PyObject* DLLCompareSource_next(DLLCompareSource* source)
+{
+    if(source->list)
+    {
+        if(!source->node) { return NULL; }
+        PyObject* item = Py_NewRef((source->node)->value);
+        source->node = (source->node)->next;
+        return item;
+    }
+    if(source->sequence)
+    {
+        // A list can shrink while items are compared, so its size is read every time
+        if(source->index >= Py_SIZE(source->sequence)) { return NULL; }
+        return Py_NewRef(PySequence_Fast_ITEMS(source->sequence)[source->index++]);
+    }
+    return PyIter_Next(source->iterator);
+}
+
+// Compares like list does, checking lengths first for == and != when other has one, then finding
+// the first items that differ and ordering those, or the lengths if there are none. Ordering is only
+// supported against DoublyLinkedLists, lists and tuples, equality against any iterable.
+static PyObject* DoublyLinkedList_rich_compare(PyObject* op, PyObject* other, int compare_op)
+{
+    DoublyLinkedList* self = (DoublyLinkedList*)op;
+    int equality = compare_op == Py_EQ || compare_op == Py_NE;
+    DLLCompareSource source = {NULL, NULL, 0, NULL, 0, NULL};
+    Py_ssize_t other_length = -1;
+    if(op == other) { Py_RETURN_RICHCOMPARE(0, 0, compare_op); }
+    if(PyObject_TypeCheck(other, &DoublyLinkedListType))
+    {
+        source.list = (DoublyLinkedList*)other;
+        source.node = (source.list)->head;
+        source.mod_count = (source.list)->mod_count;
+        other_length = (source.list)->length;
+    }
+    else if(PyList_CheckExact(other) || PyTuple_CheckExact(other))
+    {
+        source.sequence = other;
+        other_length = Py_SIZE(other);
+    }
+    else
+    {
+        if(!equality) { Py_RETURN_NOTIMPLEMENTED; }
+        source.iterator = PyObject_GetIter(other);
+        if(!source.iterator)
+        {
+            PyErr_Clear();
+            Py_RETURN_NOTIMPLEMENTED;
+        }
+    }
+    if(equality && other_length >= 0 && other_length != self->length)
+    {
+        Py_XDECREF(source.iterator);
+        return PyBool_FromLong(compare_op == Py_NE);
+    }
+    // Iterating other and comparing items runs python code, so the items are held while they are
+    // compared and the walk stops if either list changed
+    size_t mod_count = self->mod_count;
+    PyObject* value = NULL;
+    PyObject* item = NULL;
+    DLLNode* node = self->head;
+    for(; node; node = node->next)
+    {
+        item = DLLCompareSource_next(&source);
+        if(!item)
+        {
+            if(PyErr_Occurred()) { goto error; }
+            break;
+        }
+        value = Py_NewRef(node->value);
+        int rslt = DLL_items_equal(value, item); if(rslt == -1) { goto error; }
+        if(mod_count != self->mod_count || (source.list && source.mod_count != (source.list)->mod_count))
+        {
+            PyErr_SetString(PyExc_RuntimeError, "DoublyLinkedList changed during comparison");
+            goto error;
+        }
+        if(!rslt) { break; }
+        Py_CLEAR(value);
+        Py_CLEAR(item);
+    }
+    PyObject* rtn;
+    if(value)
+    {
+        if(compare_op == Py_EQ) { rtn = Py_NewRef(Py_False); }
+        else if(compare_op == Py_NE) { rtn = Py_NewRef(Py_True); }
+        else { rtn = DLL_items_order(value, item, compare_op); }
+        Py_DECREF(value);
+        Py_DECREF(item);
+        Py_XDECREF(source.iterator);
+        return rtn;
+    }
+    // All compared items are equal, so the longer side is greater
+    int self_longer = node != NULL;
+    int other_longer = 0;
+    if(!node)
+    {
+        item = DLLCompareSource_next(&source);
+        if(!item && PyErr_Occurred()) { goto error; }
+        other_longer = item != NULL;
+        Py_CLEAR(item);
+    }
+    Py_XDECREF(source.iterator);
+    Py_RETURN_RICHCOMPARE(self_longer, other_longer, compare_op);
+
+error:
+    Py_XDECREF(value);
+    Py_XDECREF(item);
+    Py_XDECREF(source.iterator);
+    return NULL;
+}
+
+// Mapping Methods
+
+// Slices are walked once from the nearest anchor to start, then step nodes at a time
+static DLLNode* DoublyLinkedList_step(DLLNode* node, Py_ssize_t step)
+{
+    for(; step > 0; step--) { node = node->next; }
+    for(; step < 0; step++) { node = node->prev; }
+    return node;
+}
+
+static PyObject* DoublyLinkedList_subscript(PyObject* op, PyObject* slice){
+    DoublyLinkedList* self = (DoublyLinkedList*)op;
+    if(PySlice_Check(slice))
+    {
+        Py_ssize_t start, stop, step;
+        if(PySlice_Unpack(slice, &start, &stop, &step) == -1) { return NULL; }
+        Py_ssize_t slice_length = PySlice_AdjustIndices(self->length, &start, &stop, step);
+        DoublyLinkedList* list_slice = (DoublyLinkedList*)DoublyLinkedList_new(&DoublyLinkedListType, NULL, NULL); if(!list_slice) { return NULL; }
+        if(DoublyLinkedList_enable(list_slice, self->index != NULL, self->hashed != NULL)) { Py_DECREF(list_slice); return NULL; }
+        if(slice_length == 0) { return (PyObject*)list_slice; }
+        DoublyLinkedList_locate((PyObject*)self, start);
+        DLLNode* node = self->cursor;
+        DLLChain chain = {NULL, NULL, 0};
+        for(Py_ssize_t i = 0; i < slice_length; i++)
+        {
+            if(i > 0) { node = DoublyLinkedList_step(node, step); }
+            if(DLLChain_append(&chain, node->value)) { DLLChain_dealloc(&chain); Py_DECREF(list_slice); return NULL; }
+        }
+        self->cursor = node;
+        self->cursor_pos = start + (slice_length - 1) * step;
+        DoublyLinkedList_link_chain(list_slice, chain.first, chain.last, chain.length, NULL, 0);
+        return (PyObject*)list_slice;
+    }
+    else if(PyLong_Check(slice))
+    {
+        Py_ssize_t index = PyLong_AsSsize_t(slice); if(index == -1 && PyErr_Occurred()) { return NULL; }
+        if(DoublyLinkedList_locate((PyObject*)self, index)) { return NULL; }
+        DLLNode* cursor = self->cursor;
+        return Py_NewRef(cursor->value);
+    }
+    else { PyErr_SetString(PyExc_TypeError, "Index must be an integer or slice"); return NULL; }
+}
+
+// Unlinks slice_length nodes, every step-th one from start, and returns them as a detached chain.
+// The cursor is left on a node that is still in the list.
+static DLLNode* DoublyLinkedList_unlink_slice(DoublyLinkedList* self, Py_ssize_t start, Py_ssize_t step, Py_ssize_t slice_length)
+{
+    if(slice_length == 0) { return NULL; }
+    DoublyLinkedList_locate((PyObject*)self, start);
+    DLLNode* node = self->cursor;
+    DLLNode* removed = NULL;
+    DLLNode* removed_last = NULL;
+    DLLNode* next = NULL;
+    for(Py_ssize_t i = 0; i < slice_length; i++)
+    {
+        if(i > 0) { node = DoublyLinkedList_step(next, step - 1); }
+        next = node->next;
+        if(node->prev) { node->prev->next = next; } else { self->head = next; }
+        if(next) { next->prev = node->prev; } else { self->tail = node->prev; }
+        node->prev = removed_last;
+        node->next = NULL;
+        if(removed_last) { removed_last->next = node; } else { removed = node; }
+        removed_last = node;
+    }
+    self->length -= slice_length;
+    self->mod_count += 1;
+    DoublyLinkedList_reset_cursor(self);
+    if(self->index) { DLLIndex_rebuild(self->index, self->head, self->length); }
+    DoublyLinkedList_hash_stale(self);
+    return removed;
+}
+
+static int DoublyLinkedList_ass_subscript(PyObject* op, PyObject* slice, PyObject* value)
+{
+    DoublyLinkedList* self = (DoublyLinkedList*)op;
+    if(!PySlice_Check(slice))
+    {
+        if(!PyIndex_Check(slice))
+        {
+            PyErr_SetString(PyExc_TypeError, "Index must be an integer or slice");
+            return -1;
+        }
+        Py_ssize_t index = PyNumber_AsSsize_t(slice, PyExc_IndexError); if(index == -1 && PyErr_Occurred()) { return -1; }
+        return DoublyLinkedList_ass_item(op, index, value);
+    }
+    Py_ssize_t start, stop, step;
+    if(PySlice_Unpack(slice, &start, &stop, &step) == -1) { return -1; }
+    Py_ssize_t slice_length = PySlice_AdjustIndices(self->length, &start, &stop, step);
+    // Walk negative steps forwards from the lowest index, the same nodes are affected
+    Py_ssize_t walk_start = step < 0 && slice_length > 0 ? start + (slice_length - 1) * step : start;
+    Py_ssize_t walk_step = step < 0 ? -step : step;
+    if(!value)
+    {
+        DLLNode* removed = DoublyLinkedList_unlink_slice(self, walk_start, walk_step, slice_length);
+        if(removed) { DLLNode_dealloc_chain(removed); }
+        return 0;
+    }
+    // Copy first, value may be this list or depend on it. A list value is locked while its items are
+    // read, nodes and values are only released once it is unlocked.
+    PyObject* items = PySequence_Fast(value, "can only assign an iterable"); if(!items) { return -1; }
+    if(step == 1)
+    {
+        DLLChain chain = {NULL, NULL, 0};
+        int rslt;
+        DLL_BEGIN_CRITICAL_SECTION_SEQUENCE_FAST(value);
+        rslt = DLLChain_from_array(&chain, PySequence_Fast_ITEMS(items), PySequence_Fast_GET_SIZE(items), 1);
+        DLL_END_CRITICAL_SECTION_SEQUENCE_FAST();
+        Py_DECREF(items);
+        if(rslt) { return -1; }
+        DLLNode* removed = DoublyLinkedList_unlink_slice(self, start, 1, slice_length);
+        if(chain.first)
+        {
+            DLLNode* prev = NULL;
+            if(start == self->length) { prev = self->tail; }
+            else if(start > 0) { DoublyLinkedList_locate((PyObject*)self, start); prev = self->cursor->prev; }
+            DoublyLinkedList_link_chain(self, chain.first, chain.last, chain.length, prev, start);
+        }
+        if(removed) { DLLNode_dealloc_chain(removed); }
+        return 0;
+    }
+    // Old values are released after the walk so their destructors can not change the list under it
+    Py_ssize_t item_count;
+    PyObject** old_values = NULL;
+    DLL_BEGIN_CRITICAL_SECTION_SEQUENCE_FAST(value);
+    item_count = PySequence_Fast_GET_SIZE(items);
+    if(item_count == slice_length && slice_length > 0)
+    {
+        old_values = PyMem_Malloc(slice_length * sizeof(PyObject*));
+        if(old_values)
+        {
+            PyObject** item_array = PySequence_Fast_ITEMS(items);
+            DoublyLinkedList_locate((PyObject*)self, start);
+            DoublyLinkedList_hash_stale(self);
+            DLLNode* node = self->cursor;
+            for(Py_ssize_t i = 0; i < slice_length; i++)
+            {
+                if(i > 0) { node = DoublyLinkedList_step(node, step); }
+                old_values[i] = node->value;
+                node->value = Py_NewRef(item_array[i]);
+            }
+            self->cursor = node;
+            self->cursor_pos = start + (slice_length - 1) * step;
+        }
+    }
+    DLL_END_CRITICAL_SECTION_SEQUENCE_FAST();
+    Py_DECREF(items);
+    if(item_count != slice_length)
+    {
+        PyErr_Format(PyExc_ValueError, "attempt to assign sequence of size %zd to extended slice of size %zd", item_count, slice_length);
+        return -1;
+    }
+    if(slice_length == 0) { return 0; }
+    if(!old_values) { PyErr_NoMemory(); return -1; }
+    for(Py_ssize_t i = 0; i < slice_length; i++) { Py_DECREF(old_values[i]); }
+    PyMem_Free(old_values);
+    return 0;
+}
+
+// Sequence Methods 
+
+static Py_ssize_t DoublyLinkedList_len(PyObject* op, PyObject* args, PyObject* kwds)
+{
+    DoublyLinkedList* self = (DoublyLinkedList*)op;
+    return self->length;
+}
+
+static PyObject* DoublyLinkedList_item(PyObject* op, Py_ssize_t index)
+{
+    DoublyLinkedList* self = (DoublyLinkedList*)op;
+    if(DoublyLinkedList_locate((PyObject*)self, index)) { return NULL; }
+    DLLNode* cursor = self->cursor;
+    return Py_NewRef(cursor->value);
+}
+
+static int DoublyLinkedList_ass_item(PyObject* op, Py_ssize_t index, PyObject* value)
+{
+    DoublyLinkedList* self = (DoublyLinkedList*)op;
+    if(DoublyLinkedList_locate((PyObject*)self, index)) { return -1; }
+    if(!value)
+    {
+        if(DoublyLinkedList_cursor_delete((PyObject*)self)) { return -1; }
+        return 0;
+    }
+    PyObject* old_value = DoublyLinkedList_swap_value(self, self->cursor, value); if(!old_value) { return -1; }
+    Py_DECREF(old_value);
+    return 0;
+}
+
+// The new list is not shared yet, append_iterator locks op while its nodes are copied
+static PyObject* DoublyLinkedList_concat(PyObject* op, PyObject* concat)
+{
+    PyObject* new_list = DoublyLinkedList_new(&DoublyLinkedListType, NULL, NULL); if(new_list == NULL) { return NULL; }
+    if(DoublyLinkedList_append_iterator(new_list, op, 1)) { Py_DECREF(new_list); return NULL; }
+    if(DoublyLinkedList_append_iterator(new_list, concat, 1)) { Py_DECREF(new_list); return NULL; }
+    return new_list;
+}
+
+static PyObject* DoublyLinkedList_inplace_concat(PyObject* op, PyObject* concat)
+{
+    if(DoublyLinkedList_append_iterator(op, concat, 1)) { return NULL; }
+    return Py_NewRef(op);
+}
+
+// The copies are built as one chain, the result keeps the indexed and hashed settings like copy
+static PyObject* DoublyLinkedList_repeat(PyObject* op, Py_ssize_t times)
+{
+    DoublyLinkedList* self = (DoublyLinkedList*)op;
+    DoublyLinkedList* repeat = (DoublyLinkedList*)DoublyLinkedList_new(&DoublyLinkedListType, NULL, NULL); if(!repeat) { return NULL; }
+    if(DoublyLinkedList_enable(repeat, self->index != NULL, self->hashed != NULL)) { Py_DECREF(repeat); return NULL; }
+    DLLChain chain = {NULL, NULL, 0};
+    if(DLLChain_repeat(&chain, self->head, self->tail, self->length, times)) { Py_DECREF(repeat); return NULL; }
+    if(chain.first) { DoublyLinkedList_link_chain(repeat, chain.first, chain.last, chain.length, NULL, 0); }
+    return (PyObject*)repeat;
+}
+
+// Appends times - 1 copies of the items after the tail in one step, or clears the list if times is
+// less than 1 like list does
+static PyObject* DoublyLinkedList_inplace_repeat(PyObject* op, Py_ssize_t times)
+{
+    DoublyLinkedList* self = (DoublyLinkedList*)op;
+    if(times <= 0)
+    {
+        DoublyLinkedList_clear(op);
+        return Py_NewRef(op);
+    }
+    DLLChain chain = {NULL, NULL, 0};
+    if(DLLChain_repeat(&chain, self->head, self->tail, self->length, times - 1)) { return NULL; }
+    if(chain.first) { DoublyLinkedList_link_chain(self, chain.first, chain.last, chain.length, self->tail, self->length); }
+    return Py_NewRef(op);
+}
+
+// Compares items by identity and then equality like list does
+static int DoublyLinkedList_contains(PyObject* op, PyObject* value)
+{
+    DoublyLinkedList* self = (DoublyLinkedList*)op;
+    Py_ssize_t count;
+    int rslt = DoublyLinkedList_hash_lookup(self, value, &count, NULL); if(rslt == -1) { return -1; }
+    if(rslt == 0) { return count > 0; }
+    DLLMatcher matcher;
+    DLLMatcher_init(&matcher, value);
+    size_t mod_count = self->mod_count;
+    for(DLLNode* node = self->head; node; node = node->next)
+    {
+        rslt = DLLMatcher_match(&matcher, node->value);
+        if(rslt) { return rslt; }
+        if(mod_count != self->mod_count)
+        {
+            PyErr_SetString(PyExc_RuntimeError, "DoublyLinkedList changed during search");
+            return -1;
+        }
+    }
+    return 0;
+}
+
+// __Methods__
+
+// Repr helpers shared by the list types
+
+// Writes the reprs of the items of op as "[a, b, c]" in one pass over its iterator. Stops after
+// max_items items, unless it is negative, and notes how many were left out. With a name the items
+// are wrapped as "name([a, b, c]settings)" like the repr of a deque. A list that is already being
+// written further up the stack is written as "[...]".
+static PyObject* DLL_write_repr(PyObject* op, Py_ssize_t length, const char* name, const char* settings, Py_ssize_t max_items)
+{
+    int status = Py_ReprEnter(op);
+    if(status) { return status > 0 ? PyUnicode_FromString("[...]") : NULL; }
+    PyObject* iterator = NULL;
+    PyObject* item = NULL;
+    PyUnicodeWriter* writer = PyUnicodeWriter_Create(0); if(!writer) { goto error; }
+    if(name && (PyUnicodeWriter_WriteUTF8(writer, name, -1) || PyUnicodeWriter_WriteUTF8(writer, "(", 1))) { goto error; }
+    if(PyUnicodeWriter_WriteUTF8(writer, "[", 1)) { goto error; }
+    Py_ssize_t written = 0;
+    if(length > 0 && max_items != 0)
+    {
+        iterator = PyObject_GetIter(op); if(!iterator) { goto error; }
+        while((max_items < 0 || written < max_items) && (item = PyIter_Next(iterator)))
+        {
+            if(written > 0 && PyUnicodeWriter_WriteUTF8(writer, ", ", 2)) { goto error; }
+            if(PyUnicodeWriter_WriteRepr(writer, item)) { goto error; }
+            Py_CLEAR(item);
+            written += 1;
+        }
+        if(PyErr_Occurred()) { goto error; }
+        Py_CLEAR(iterator);
+    }
+    if(written < length)
+    {
+        char more[48];
+        PyOS_snprintf(more, sizeof(more), "%s... (%zd more)", written > 0 ? ", " : "", length - written);
+        if(PyUnicodeWriter_WriteUTF8(writer, more, -1)) { goto error; }
+    }
+    if(PyUnicodeWriter_WriteUTF8(writer, "]", 1)) { goto error; }
+    if(name && ((settings && PyUnicodeWriter_WriteUTF8(writer, settings, -1)) || PyUnicodeWriter_WriteUTF8(writer, ")", 1))) { goto error; }
+    Py_ReprLeave(op);
+    return PyUnicodeWriter_Finish(writer);
+error:
+    Py_XDECREF(item);
+    Py_XDECREF(iterator);
+    if(writer) { PyUnicodeWriter_Discard(writer); }
+    Py_ReprLeave(op);
+    return NULL;
+}
+
+// Parses the max_items argument of repr_limited
+static int DLL_parse_max_items(PyObject* args, PyObject* kwds, Py_ssize_t* max_items)
+{
+    static char* kwlist[] = {"max_items", NULL};
+    if(!PyArg_ParseTupleAndKeywords(args, kwds, "n", kwlist, max_items)) { return -1; }
+    if(*max_items < 0) { PyErr_SetString(PyExc_ValueError, "max_items must not be negative"); return -1; }
+    return 0;
+}
+
+static PyObject* DoublyLinkedList_str(PyObject* op, PyObject* Py_UNUSED(dummy))
+{
+    return DLL_write_repr(op, ((DoublyLinkedList*)op)->length, NULL, NULL, -1);
+}
+
+// The settings written after the items by repr
+static const char* DoublyLinkedList_repr_settings(DoublyLinkedList* self)
+{
+    if(self->index && self->hashed) { return ", indexed=True, hashed=True"; }
+    if(self->index) { return ", indexed=True"; }
+    if(self->hashed) { return ", hashed=True"; }
+    return NULL;
+}
+
+static PyObject* DoublyLinkedList_repr(PyObject* op)
+{
+    DoublyLinkedList* self = (DoublyLinkedList*)op;
+    return DLL_write_repr(op, self->length, "DoublyLinkedList", DoublyLinkedList_repr_settings(self), -1);
+}
+
+static PyObject* DoublyLinkedList_repr_limited(PyObject* op, PyObject* args, PyObject* kwds)
+{
+    DoublyLinkedList* self = (DoublyLinkedList*)op;
+    Py_ssize_t max_items;
+    if(DLL_parse_max_items(args, kwds, &max_items)) { return NULL; }
+    return DLL_write_repr(op, self->length, "DoublyLinkedList", DoublyLinkedList_repr_settings(self), max_items);
+}
+
+static PyObject* DoublyLinkedList_sizeof(PyObject* op, PyObject* Py_UNUSED(dummy))
+{
+    DoublyLinkedList* self = (DoublyLinkedList*)op;
+    Py_ssize_t size = Py_TYPE(self)->tp_basicsize + self->length * sizeof(DLLNode);
+    if(self->index) { size += self->index->bytes; }
+    if(self->hashed) { size += DLLHashIndex_bytes(self->hashed); }
+    return PyLong_FromSsize_t(size);
+}
+
+static PyObject* DoublyLinkedList_get_indexed(PyObject* op, void* closure)
+{
+    return PyBool_FromLong(((DoublyLinkedList*)op)->index != NULL);
+}
+
+static PyObject* DoublyLinkedList_get_hashed(PyObject* op, void* closure)
+{
+    return PyBool_FromLong(((DoublyLinkedList*)op)->hashed != NULL);
+}
+
+// Pickling and checkpoints
+
+// Imports module.name on use, so pickle and functools are only loaded once something is pickled
+static PyObject* DLL_import_attr(const char* module_name, const char* name)
+{
+    PyObject* module = PyImport_ImportModule(module_name); if(!module) { return NULL; }
+    PyObject* attr = PyObject_GetAttrString(module, name);
+    Py_DECREF(module);
+    return attr;
+}
+
+// Reduces op to a call of its type, or of functools.partial(type, **settings) when settings is not
+// NULL, followed by an iterator over its items. Pickle writes the items in batches as it walks the
+// iterator and feeds them back through extend, so neither side builds a list of every item.
+static PyObject* DLL_reduce_streamed(PyObject* op, PyObject* settings)
+{
+    PyObject* callable;
+    if(settings)
+    {
+        PyObject* partial = DLL_import_attr("functools", "partial"); if(!partial) { return NULL; }
+        PyObject* type_args = PyTuple_Pack(1, (PyObject*)Py_TYPE(op));
+        callable = type_args ? PyObject_Call(partial, type_args, settings) : NULL;
+        Py_XDECREF(type_args); Py_DECREF(partial);
+        if(!callable) { return NULL; }
+    }
+    else { callable = Py_NewRef((PyObject*)Py_TYPE(op)); }
+    PyObject* iterator = PyObject_GetIter(op); if(!iterator) { Py_DECREF(callable); return NULL; }
+    return Py_BuildValue("(N()ON)", callable, Py_None, iterator);
+}
+
+static PyObject* DoublyLinkedList_reduce(PyObject* op, PyObject* Py_UNUSED(dummy))
+{
+    DoublyLinkedList* self = (DoublyLinkedList*)op;
+    if(!self->index && !self->hashed) { return DLL_reduce_streamed(op, NULL); }
+    PyObject* settings = Py_BuildValue("{sOsO}", "indexed", self->index ? Py_True : Py_False, "hashed", self->hashed ? Py_True : Py_False);
+    if(!settings) { return NULL; }
+    PyObject* rslt = DLL_reduce_streamed(op, settings);
+    Py_DECREF(settings);
+    return rslt;
+}
+
+// dump writes an 8 byte header, the magic, format version and flags, followed by frames that each
+// hold an 8 byte little endian length and a pickled tuple of up to chunk_size items. An empty frame
+// ends the dump. Only one frame is held in memory at a time while dumping or loading.
+#define DLL_DUMP_MAGIC "PDLL"
+#define DLL_DUMP_VERSION 1
+#define DLL_DUMP_INDEXED 1
+#define DLL_DUMP_HASHED 2
+#define DLL_DUMP_HEADER 8
+#define DLL_DUMP_CHUNK 1024
+
+static int DLL_write_bytes(PyObject* write, const char* data, Py_ssize_t size)
+{
+    PyObject* rslt = PyObject_CallFunction(write, "y#", data, size); if(!rslt) { return -1; }
+    Py_DECREF(rslt);
+    return 0;
+}
+
+static int DLL_write_frame_length(PyObject* write, uint64_t length)
+{
+    char buffer[8];
+    for(int i = 0; i < 8; i++) { buffer[i] = (char)(length >> (8 * i)); }
+    return DLL_write_bytes(write, buffer, 8);
+}
+
+// Reads exactly size bytes, retrying short reads until the file runs out
+static PyObject* DLL_read_exact(PyObject* read, Py_ssize_t size)
+{
+    PyObject* data = PyBytes_FromStringAndSize(NULL, 0); if(!data) { return NULL; }
+    while(PyBytes_GET_SIZE(data) < size)
+    {
+        PyObject* part = PyObject_CallFunction(read, "n", size - PyBytes_GET_SIZE(data));
+        if(!part) { Py_DECREF(data); return NULL; }
+        if(!PyBytes_Check(part))
+        {
+            Py_DECREF(part); Py_DECREF(data);
+            PyErr_SetString(PyExc_TypeError, "file.read must return bytes");
+            return NULL;
+        }
+        if(PyBytes_GET_SIZE(part) == 0)
+        {
+            Py_DECREF(part); Py_DECREF(data);
+            PyErr_SetString(PyExc_EOFError, "DoublyLinkedList dump is truncated");
+            return NULL;
+        }
+        PyBytes_ConcatAndDel(&data, part); if(!data) { return NULL; }
+    }
+    return data;
+}
+
+static PyObject* DoublyLinkedList_dump(PyObject* op, PyObject* args, PyObject* kwds)
+{
+    DoublyLinkedList* self = (DoublyLinkedList*)op;
+    static char* kwlist[] = {"file", "chunk_size", "protocol", NULL};
+    PyObject* file;
+    Py_ssize_t chunk_size = DLL_DUMP_CHUNK;
+    int protocol = -1;
+    if(!PyArg_ParseTupleAndKeywords(args, kwds, "O|n$i", kwlist, &file, &chunk_size, &protocol)) { return NULL; }
+    if(chunk_size < 1) { PyErr_SetString(PyExc_ValueError, "chunk_size must be positive"); return NULL; }
+    PyObject* write = PyObject_GetAttrString(file, "write"); if(!write) { return NULL; }
+    PyObject* dumps = DLL_import_attr("pickle", "dumps"); if(!dumps) { Py_DECREF(write); return NULL; }
+    char flags = (self->index ? DLL_DUMP_INDEXED : 0) | (self->hashed ? DLL_DUMP_HASHED : 0);
+    char header[DLL_DUMP_HEADER] = {'P', 'D', 'L', 'L', DLL_DUMP_VERSION, flags, 0, 0};
+    if(DLL_write_bytes(write, header, DLL_DUMP_HEADER)) { goto error; }
+    DLLNode* node = self->head;
+    Py_ssize_t remaining = self->length;
+    size_t mod_count = self->mod_count;
+    while(remaining > 0)
+    {
+        Py_ssize_t count = remaining < chunk_size ? remaining : chunk_size;
+        PyObject* chunk = PyTuple_New(count); if(!chunk) { goto error; }
+        for(Py_ssize_t i = 0; i < count; i++)
+        {
+            PyTuple_SET_ITEM(chunk, i, Py_NewRef(node->value));
+            node = node->next;
+        }
+        remaining -= count;
+        // Pickling and writing run python code, node is only used again if the list is unchanged
+        PyObject* payload = PyObject_CallFunction(dumps, "Ni", chunk, protocol); if(!payload) { goto error; }
+        int rslt = DLL_write_frame_length(write, (uint64_t)PyBytes_GET_SIZE(payload));
+        if(!rslt) { rslt = DLL_write_bytes(write, PyBytes_AS_STRING(payload), PyBytes_GET_SIZE(payload)); }
+        Py_DECREF(payload);
+        if(rslt) { goto error; }
+        if(mod_count != self->mod_count)
+        {
+            PyErr_SetString(PyExc_RuntimeError, "DoublyLinkedList changed during dump");
+            goto error;
+        }
+    }
+    if(DLL_write_frame_length(write, 0)) { goto error; }
+    Py_DECREF(write); Py_DECREF(dumps);
+    return Py_NewRef(Py_None);
+error:
+    Py_DECREF(write); Py_DECREF(dumps);
+    return NULL;
+}
+
+// The new list is not shared until it is returned, so it is filled without taking its lock
+static PyObject* DoublyLinkedList_load(PyObject* type, PyObject* args, PyObject* kwds)
+{
+    static char* kwlist[] = {"file", NULL};
+    PyObject* file;
+    if(!PyArg_ParseTupleAndKeywords(args, kwds, "O", kwlist, &file)) { return NULL; }
+    PyObject* read = PyObject_GetAttrString(file, "read"); if(!read) { return NULL; }
+    PyObject* loads = DLL_import_attr("pickle", "loads"); if(!loads) { Py_DECREF(read); return NULL; }
+    DoublyLinkedList* self = NULL;
+    PyObject* header = DLL_read_exact(read, DLL_DUMP_HEADER); if(!header) { goto error; }
+    const char* bytes = PyBytes_AS_STRING(header);
+    if(memcmp(bytes, DLL_DUMP_MAGIC, 4) || bytes[4] != DLL_DUMP_VERSION)
+    {
+        Py_DECREF(header);
+        PyErr_SetString(PyExc_ValueError, "file does not hold a DoublyLinkedList dump");
+        goto error;
+    }
+    int flags = bytes[5];
+    Py_DECREF(header);
+    self = (DoublyLinkedList*)DoublyLinkedList_new(&DoublyLinkedListType, NULL, NULL); if(!self) { goto error; }
+    if(DoublyLinkedList_enable(self, flags & DLL_DUMP_INDEXED, flags & DLL_DUMP_HASHED)) { goto error; }
+    for(;;)
+    {
+        PyObject* frame = DLL_read_exact(read, 8); if(!frame) { goto error; }
+        uint64_t length = 0;
+        for(int i = 0; i < 8; i++) { length |= (uint64_t)(unsigned char)PyBytes_AS_STRING(frame)[i] << (8 * i); }
+        Py_DECREF(frame);
+        if(length == 0) { break; }
+        if(length > (uint64_t)PY_SSIZE_T_MAX)
+        {
+            PyErr_SetString(PyExc_ValueError, "DoublyLinkedList dump has an invalid frame length");
+            goto error;
+        }
+        PyObject* payload = DLL_read_exact(read, (Py_ssize_t)length); if(!payload) { goto error; }
+        PyObject* chunk = PyObject_CallOneArg(loads, payload);
+        Py_DECREF(payload);
+        if(!chunk) { goto error; }
+        if(!PyTuple_Check(chunk))
+        {
+            Py_DECREF(chunk);
+            PyErr_SetString(PyExc_ValueError, "DoublyLinkedList dump has an invalid frame");
+            goto error;
+        }
+        int rslt = DoublyLinkedList_append_iterator((PyObject*)self, chunk, 1);
+        Py_DECREF(chunk);
+        if(rslt) { goto error; }
+    }
+    Py_DECREF(read); Py_DECREF(loads);
+    return (PyObject*)self;
+error:
+    Py_XDECREF(self); Py_DECREF(read); Py_DECREF(loads);
+    return NULL;
+}
+
+// Locked entry points
+
+DLL_LOCKED(int, DoublyLinkedList_init, (PyObject* op, PyObject* args, PyObject* kwds), (op, args, kwds))
+DLL_LOCKED_KWARGS(DoublyLinkedList_append)
+DLL_LOCKED_KWARGS(DoublyLinkedList_append_node)
+DLL_LOCKED_KWARGS(DoublyLinkedList_clear_method)
+DLL_LOCKED_UNARY(DoublyLinkedList_copy)
+DLL_LOCKED_KWARGS(DoublyLinkedList_count)
+DLL_LOCKED_KWARGS(DoublyLinkedList_extend)
+DLL_LOCKED_KWARGS(DoublyLinkedList_index)
+DLL_LOCKED_KWARGS(DoublyLinkedList_insert)
+DLL_LOCKED_KWARGS(DoublyLinkedList_insert_node)
+DLL_LOCKED_KWARGS(DoublyLinkedList_insert_after)
+DLL_LOCKED_KWARGS(DoublyLinkedList_insert_before)
+DLL_LOCKED_KWARGS(DoublyLinkedList_move_to_end)
+DLL_LOCKED_KWARGS(DoublyLinkedList_node_at)
+DLL_LOCKED_KWARGS(DoublyLinkedList_new_cursor)
+DLL_LOCKED_KWARGS(DoublyLinkedList_pop)
+DLL_LOCKED_KWARGS(DoublyLinkedList_remove)
+DLL_LOCKED_KWARGS(DoublyLinkedList_remove_node)
+DLL_LOCKED_UNARY(DoublyLinkedList_reverse)
+DLL_LOCKED_NOARGS(DoublyLinkedList_reversed)
+DLL_LOCKED_NOARGS(DoublyLinkedList_sizeof)
+DLL_LOCKED_NOARGS(DoublyLinkedList_reduce)
+DLL_LOCKED_KWARGS(DoublyLinkedList_dump)
+DLL_LOCKED_KWARGS(DoublyLinkedList_sort)
+DLL_LOCKED_KWARGS(DoublyLinkedList_split)
+DLL_LOCKED_UNARY(DoublyLinkedList_iter)
+DLL_LOCKED(PyObject*, DoublyLinkedList_str, (PyObject* op), (op, NULL))
+DLL_LOCKED_UNARY(DoublyLinkedList_repr)
+DLL_LOCKED_KWARGS(DoublyLinkedList_repr_limited)
+DLL_LOCKED(PyObject*, DoublyLinkedList_get_indexed, (PyObject* op, void* closure), (op, closure))
+DLL_LOCKED(PyObject*, DoublyLinkedList_get_hashed, (PyObject* op, void* closure), (op, closure))
+DLL_LOCKED_BINARY(DoublyLinkedList_subscript)
+DLL_LOCKED(int, DoublyLinkedList_ass_subscript, (PyObject* op, PyObject* slice, PyObject* value), (op, slice, value))
+DLL_LOCKED(Py_ssize_t, DoublyLinkedList_len, (PyObject* op), (op, NULL, NULL))
+DLL_LOCKED(PyObject*, DoublyLinkedList_item, (PyObject* op, Py_ssize_t index), (op, index))
+DLL_LOCKED(int, DoublyLinkedList_ass_item, (PyObject* op, Py_ssize_t index, PyObject* value), (op, index, value))
+DLL_LOCKED_BINARY(DoublyLinkedList_inplace_concat)
+DLL_LOCKED(PyObject*, DoublyLinkedList_repeat, (PyObject* op, Py_ssize_t times), (op, times))
+DLL_LOCKED(PyObject*, DoublyLinkedList_inplace_repeat, (PyObject* op, Py_ssize_t times), (op, times))
+DLL_LOCKED(int, DoublyLinkedList_contains, (PyObject* op, PyObject* value), (op, value))
+
+// splice changes both lists, so both are locked together
+static PyObject* DoublyLinkedList_splice_locked(PyObject* op, PyObject* args, PyObject* kwds)
+{
+    PyObject* other = NULL;
+    if(PyTuple_GET_SIZE(args) > 0) { other = PyTuple_GET_ITEM(args, 0); }
+    else if(kwds) { other = PyDict_GetItemString(kwds, "other"); }
+    if(!other || !PyObject_TypeCheck(other, &DoublyLinkedListType)) { return DoublyLinkedList_splice(op, args, kwds); }
+    PyObject* rslt;
+    Py_BEGIN_CRITICAL_SECTION2(op, other);
+    rslt = DoublyLinkedList_splice(op, args, kwds);
+    Py_END_CRITICAL_SECTION2();
+    return rslt;
+}
+
+// Comparing two lists reads the nodes of both, so both are locked together
+static PyObject* DoublyLinkedList_rich_compare_locked(PyObject* op, PyObject* other, int compare_op)
+{
+    PyObject* rslt;
+    if(op == other || !PyObject_TypeCheck(other, &DoublyLinkedListType))
+    {
+        Py_BEGIN_CRITICAL_SECTION(op);
+        rslt = DoublyLinkedList_rich_compare(op, other, compare_op);
+        Py_END_CRITICAL_SECTION();
+        return rslt;
+    }
+    Py_BEGIN_CRITICAL_SECTION2(op, other);
+    rslt = DoublyLinkedList_rich_compare(op, other, compare_op);
+    Py_END_CRITICAL_SECTION2();
+    return rslt;
+}
+
+static PyGetSetDef DoublyLinkedList_getset[] = {
+    {"indexed", DoublyLinkedList_get_indexed_locked, NULL,
+    "True if the list keeps a skip list index for O(log n) positional access.", NULL},
+    {"hashed", DoublyLinkedList_get_hashed_locked, NULL,
+    "True if the list keeps a hash index for O(1) membership, count and remove.", NULL},
+    {NULL}
+};
+
+static PyMethodDef DoublyLinkedList_methods[] = {
+    {"append", (PyCFunction)DoublyLinkedList_append_locked, METH_VARARGS|METH_KEYWORDS,
+    "Append object to the end of the list. Set forward to false to append to the start."},
+    {"append_node", (PyCFunction)DoublyLinkedList_append_node_locked, METH_VARARGS|METH_KEYWORDS,
+    "Append object like append and return a NodeHandle for it."},
+    {"clear", (PyCFunction)DoublyLinkedList_clear_method_locked, METH_VARARGS|METH_KEYWORDS,
+    "Remove all items from the list. With deferred=True the nodes are only detached in O(1) and their items are released by release_deferred."},
+    {"copy", (PyCFunction)DoublyLinkedList_copy_locked, METH_NOARGS,
+    "Return a shallow copy of the list."},
+    {"count", (PyCFunction)DoublyLinkedList_count_locked, METH_VARARGS|METH_KEYWORDS,
+    "Return number of occurrences of value in the list."},
+    {"cursor", (PyCFunction)DoublyLinkedList_new_cursor_locked, METH_VARARGS|METH_KEYWORDS,
+    "Return a Cursor at index for O(1) navigation and editing, at the end of the list if index is its length.\nRaises IndexError if the index is out of range."},
+    {"dump", (PyCFunction)DoublyLinkedList_dump_locked, METH_VARARGS|METH_KEYWORDS,
+    "Write the list to a binary file in frames of up to chunk_size pickled items, so only one frame is held in memory at a time."},
+    {"extend", (PyCFunction)DoublyLinkedList_extend_locked, METH_VARARGS|METH_KEYWORDS,
+    "Extend list by appending elements from the iterable. Set forward to false to extend from the start."},
+    {"index", (PyCFunction)DoublyLinkedList_index_locked, METH_VARARGS|METH_KEYWORDS,
+    "Return first index of value.\nRaises ValueError if the value is not present."},
+    {"insert", (PyCFunction)DoublyLinkedList_insert_locked, METH_VARARGS|METH_KEYWORDS,
+     "Insert object after index. Set forward to false to insert before index."},
+    {"insert_node", (PyCFunction)DoublyLinkedList_insert_node_locked, METH_VARARGS|METH_KEYWORDS,
+     "Insert object like insert and return a NodeHandle for it."},
+    {"insert_after", (PyCFunction)DoublyLinkedList_insert_after_locked, METH_VARARGS|METH_KEYWORDS,
+     "Insert object directly after node in O(1) and return a NodeHandle for it."},
+    {"insert_before", (PyCFunction)DoublyLinkedList_insert_before_locked, METH_VARARGS|METH_KEYWORDS,
+     "Insert object directly before node in O(1) and return a NodeHandle for it."},
+    {"load", (PyCFunction)DoublyLinkedList_load, METH_VARARGS|METH_KEYWORDS|METH_CLASS,
+     "Read a list written by dump from a binary file, one frame at a time."},
+    {"move_to_end", (PyCFunction)DoublyLinkedList_move_to_end_locked, METH_VARARGS|METH_KEYWORDS,
+     "Move node to the end of the list in O(1). Set forward to false to move it to the start."},
+    {"node_at", (PyCFunction)DoublyLinkedList_node_at_locked, METH_VARARGS|METH_KEYWORDS,
+     "Return a NodeHandle for the item at index.\nRaises IndexError if the index is out of range."},
+    {"pop", (PyCFunction)DoublyLinkedList_pop_locked, METH_VARARGS|METH_KEYWORDS,
+    "Remove and return item at index (default last).\nRaises IndexError if list is empty or index is out of range."},
+    {"remove", (PyCFunction)DoublyLinkedList_remove_locked, METH_VARARGS|METH_KEYWORDS,
+    "Remove first occurence of value.\nRaises ValueError if the value is not present."},
+    {"remove_node", (PyCFunction)DoublyLinkedList_remove_node_locked, METH_VARARGS|METH_KEYWORDS,
+    "Remove node from the list in O(1) and return its value.\nRaises ValueError if the node was already removed or belongs to another list."},
+    {"repr_limited", (PyCFunction)DoublyLinkedList_repr_limited_locked, METH_VARARGS|METH_KEYWORDS,
+    "Return the repr of the list with at most max_items items written out, followed by the number left out."},
+    {"reverse", (PyCFunction)DoublyLinkedList_reverse_locked, METH_NOARGS,
+    "Reverse the order of the list."},
+    {"__reversed__", (PyCFunction)DoublyLinkedList_reversed_locked, METH_NOARGS,
+    "Return a reverse iterator over the list."},
+    {"__reduce__", (PyCFunction)DoublyLinkedList_reduce_locked, METH_NOARGS,
+    "Return state for pickle, the items are streamed from an iterator."},
+    {"__sizeof__", (PyCFunction)DoublyLinkedList_sizeof_locked, METH_NOARGS,
+    "Return the size of the list in memory, in bytes, including its nodes and index."},
+    {"sort", (PyCFunction)DoublyLinkedList_sort_locked, METH_VARARGS|METH_KEYWORDS,
+    "In-place sort in ascending order, equal objects are not swapped. Key can be applied to values and the list will be sorted based on the result of applying the key. Reverse will reverse the sort order."},
+    {"splice", (PyCFunction)DoublyLinkedList_splice_locked, METH_VARARGS|METH_KEYWORDS,
+    "Move every node of other to the end of the list without copying, leaving other empty. With an index the nodes are moved after index, or before it if forward is false."},
+    {"split", (PyCFunction)DoublyLinkedList_split_locked, METH_VARARGS|METH_KEYWORDS,
+    "Detach the items from index to the end into a new list without copying and return it.\nRaises IndexError if index is out of range."},
+    {NULL, NULL, 0, NULL}
+};
+
+static PyMappingMethods DoublyLinkedList_map =
+{
+    .mp_subscript = DoublyLinkedList_subscript_locked,
+    .mp_ass_subscript = DoublyLinkedList_ass_subscript_locked
+};
+
+static PySequenceMethods DoublyLinkedList_sequence =
+{
+    .sq_length = DoublyLinkedList_len_locked,
+    .sq_item = DoublyLinkedList_item_locked,
+    .sq_ass_item = DoublyLinkedList_ass_item_locked,
+    .sq_concat = DoublyLinkedList_concat,
+    .sq_repeat = DoublyLinkedList_repeat_locked,
+    .sq_inplace_concat = DoublyLinkedList_inplace_concat_locked,
+    .sq_inplace_repeat = DoublyLinkedList_inplace_repeat_locked,
+    .sq_contains = DoublyLinkedList_contains_locked
+};
+
+// Type Definition
+
+static PyTypeObject DoublyLinkedListType =
+{
+    .ob_base = PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "py_doubly_linked_list.doubly_linked_list.DoublyLinkedList",
+    .tp_doc = PyDoc_STR("DoublyLinkedList class"),
+    .tp_basicsize = sizeof(DoublyLinkedList),
+    .tp_itemsize = 0,
+    .tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC,
+    .tp_new = (newfunc)DoublyLinkedList_new,
+    .tp_init = DoublyLinkedList_init_locked,
+    .tp_dealloc = (destructor)DoublyLinkedList_dealloc,
+    .tp_traverse = DoublyLinkedList_traverse,
+    .tp_clear = DoublyLinkedList_clear,
+    .tp_str = DoublyLinkedList_str_locked,
+    .tp_repr = DoublyLinkedList_repr_locked,
+    .tp_richcompare = DoublyLinkedList_rich_compare_locked,
+    .tp_iter = DoublyLinkedList_iter_locked,
+    .tp_methods = DoublyLinkedList_methods,
+    .tp_getset = DoublyLinkedList_getset,
+    .tp_as_sequence = &DoublyLinkedList_sequence,
+    .tp_as_mapping = &DoublyLinkedList_map
+};
+
+// - - - - - DoublyLinkedListIterator - - - - - //
+
+// Walks the node chain directly. The list's mod_count is checked before every step so a node
+// freed by a mutation is never touched. The iterator and its list are both locked while stepping.
+
+typedef struct
+{
+    PyObject_HEAD
+    DoublyLinkedList* list;
+    DLLNode* node;
+    Py_ssize_t remaining;
+    size_t mod_count;
+    int forward;
+} DoublyLinkedListIterator;
+
+static PyObject* DoublyLinkedListIterator_new(DoublyLinkedList* list, int forward)
+{
+    DoublyLinkedListIterator* self = PyObject_GC_New(DoublyLinkedListIterator, &DoublyLinkedListIteratorType);
+    if(!self) { return NULL; }
+    self->list = (DoublyLinkedList*)Py_NewRef((PyObject*)list);
+    self->node = forward ? list->head : list->tail;
+    self->remaining = list->length;
+    self->mod_count = list->mod_count;
+    self->forward = forward;
+    PyObject_GC_Track(self);
+    return (PyObject*)self;
+}
+
+static void DoublyLinkedListIterator_dealloc(PyObject* op)
+{
+    DoublyLinkedListIterator* self = (DoublyLinkedListIterator*)op;
+    PyObject_GC_UnTrack(op);
+    Py_XDECREF(self->list);
+    PyObject_GC_Del(self);
+}
+
+static int DoublyLinkedListIterator_traverse(PyObject* op, visitproc visit, void* arg)
+{
+    Py_VISIT(((DoublyLinkedListIterator*)op)->list);
+    return 0;
+}
+
+static int DoublyLinkedListIterator_clear(PyObject* op)
+{
+    DoublyLinkedListIterator* self = (DoublyLinkedListIterator*)op;
+    self->node = NULL;
+    self->remaining = 0;
+    Py_CLEAR(self->list);
+    return 0;
+}
+
+static PyObject* DoublyLinkedListIterator_next(PyObject* op)
+{
+    DoublyLinkedListIterator* self = (DoublyLinkedListIterator*)op;
+    if(!self->list) { return NULL; }
+    if(self->list->mod_count != self->mod_count)
+    {
+        self->node = NULL;
+        self->remaining = 0;
+        Py_CLEAR(self->list);
+        PyErr_SetString(PyExc_RuntimeError, "DoublyLinkedList changed during iteration");
+        return NULL;
+    }
+    DLLNode* node = self->node;
+    if(!node)
+    {
+        Py_CLEAR(self->list);
+        return NULL;
+    }
+    self->node = self->forward ? node->next : node->prev;
+    self->remaining -= 1;
+    return Py_NewRef(node->value);
+}
+
+static PyObject* DoublyLinkedListIterator_length_hint(PyObject* op, PyObject* Py_UNUSED(dummy))
+{
+    DoublyLinkedListIterator* self = (DoublyLinkedListIterator*)op;
+    if(!self->list || self->list->mod_count != self->mod_count) { return PyLong_FromSsize_t(0); }
+    return PyLong_FromSsize_t(self->remaining);
+}
+
+// Runs func with an iterator and the list it walks locked, the list is held in case func drops it
+static PyObject* DLLIterator_call_locked(PyObject* op, PyObject** list_field, PyObject* (*func)(PyObject*, PyObject*))
+{
+    PyObject* rslt;
+    Py_BEGIN_CRITICAL_SECTION(op);
+    PyObject* list = Py_XNewRef(*list_field);
+    if(!list) { rslt = func(op, NULL); }
+    else
+    {
+        Py_BEGIN_CRITICAL_SECTION(list);
+        rslt = func(op, NULL);
+        Py_END_CRITICAL_SECTION();
+        Py_DECREF(list);
+    }
+    Py_END_CRITICAL_SECTION();
+    return rslt;
+}
+
+static PyObject* DoublyLinkedListIterator_next_unlocked(PyObject* op, PyObject* Py_UNUSED(dummy))
+{
+    return DoublyLinkedListIterator_next(op);
+}
+
+static PyObject* DoublyLinkedListIterator_next_locked(PyObject* op)
+{
+    PyObject** list = (PyObject**)&((DoublyLinkedListIterator*)op)->list;
+    return DLLIterator_call_locked(op, list, DoublyLinkedListIterator_next_unlocked);
+}
+
+static PyObject* DoublyLinkedListIterator_length_hint_locked(PyObject* op, PyObject* Py_UNUSED(dummy))
+{
+    PyObject** list = (PyObject**)&((DoublyLinkedListIterator*)op)->list;
+    return DLLIterator_call_locked(op, list, DoublyLinkedListIterator_length_hint);
+}
+
+static PyObject* DoublyLinkedList_iter(PyObject* op)
+{
+    return DoublyLinkedListIterator_new((DoublyLinkedList*)op, 1);
+}
+
+static PyObject* DoublyLinkedList_reversed(PyObject* op, PyObject* Py_UNUSED(dummy))
+{
+    return DoublyLinkedListIterator_new((DoublyLinkedList*)op, 0);
+}
+
+static PyMethodDef DoublyLinkedListIterator_methods[] = {
+    {"__length_hint__", (PyCFunction)DoublyLinkedListIterator_length_hint_locked, METH_NOARGS,
+    "Private method returning an estimate of len(list(it))."},
+    {NULL, NULL, 0, NULL}
+};
+
+static PyTypeObject DoublyLinkedListIteratorType =
+{
+    .ob_base = PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "py_doubly_linked_list.doubly_linked_list.DoublyLinkedListIterator",
+    .tp_doc = PyDoc_STR("DoublyLinkedList iterator"),
+    .tp_basicsize = sizeof(DoublyLinkedListIterator),
+    .tp_itemsize = 0,
+    .tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC,
+    .tp_dealloc = (destructor)DoublyLinkedListIterator_dealloc,
+    .tp_traverse = DoublyLinkedListIterator_traverse,
+    .tp_clear = DoublyLinkedListIterator_clear,
+    .tp_iter = PyObject_SelfIter,
+    .tp_iternext = DoublyLinkedListIterator_next_locked,
+    .tp_methods = DoublyLinkedListIterator_methods
+};
+
+// - - - - - NodeHandle - - - - - //
+
+// A handle refers to a single node of a list so it can be removed or used as an insertion
+// point in O(1). Each node has at most one handle, and removing the node invalidates it.
+// A valid handle keeps its list alive. The node, the list's handle_count and node->handle are
+// only changed while holding the list's lock. handle->list can change under a list operation,
+// so it is also guarded by handle_mutex for handles that need to find and lock their list.
+
+static PyObject* NodeHandle_for(DoublyLinkedList* list, DLLNode* node)
+{
+    NodeHandle* handle = node->handle;
+    // On free-threaded builds a handle without references left may still be waiting in its
+    // dealloc for the list, it is replaced rather than revived
+    if(handle && Py_REFCNT(handle) > 0) { return Py_NewRef((PyObject*)handle); }
+    NodeHandle* self = PyObject_GC_New(NodeHandle, &NodeHandleType);
+    if(!self) { return NULL; }
+    if(handle) { handle->node = NULL; } else { list->handle_count += 1; }
+    self->node = node;
+    self->list = (DoublyLinkedList*)Py_NewRef((PyObject*)list);
+    node->handle = self;
+    PyObject_GC_Track(self);
+    return (PyObject*)self;
+}
+
+static void NodeHandle_invalidate(NodeHandle* self)
+{
+    DoublyLinkedList* list = self->list;
+    if(self->node)
+    {
+        self->node->handle = NULL;
+        list->handle_count -= 1;
+        self->node = NULL;
+    }
+    DLL_MUTEX_LOCK(handle_mutex);
+    self->list = NULL;
+    DLL_MUTEX_UNLOCK(handle_mutex);
+    Py_DECREF(list);
+}
+
+// Returns a new reference to the list of the handle, or NULL if its node was removed. The list
+// has to be locked and checked against handle->list again before the node is used.
+static DoublyLinkedList* NodeHandle_get_list(NodeHandle* self)
+{
+    DLL_MUTEX_LOCK(handle_mutex);
+    DoublyLinkedList* list = (DoublyLinkedList*)Py_XNewRef((PyObject*)self->list);
+    DLL_MUTEX_UNLOCK(handle_mutex);
+    return list;
+}
+
+// Detaches the handle from its node and drops the reference to the list
+static int NodeHandle_clear(PyObject* op)
+{
+    NodeHandle* self = (NodeHandle*)op;
+    DoublyLinkedList* list;
+    while((list = NodeHandle_get_list(self)) != NULL)
+    {
+        Py_BEGIN_CRITICAL_SECTION(list);
+        if(self->list == list) { NodeHandle_invalidate(self); }
+        Py_END_CRITICAL_SECTION();
+        Py_DECREF(list);
+    }
+    return 0;
+}
+
+static void NodeHandle_dealloc(PyObject* op)
+{
+    PyObject_GC_UnTrack(op);
+    NodeHandle_clear(op);
+    PyObject_GC_Del(op);
+}
+
+static int NodeHandle_traverse(PyObject* op, visitproc visit, void* arg)
+{
+    Py_VISIT(((NodeHandle*)op)->list);
+    return 0;
+}
+
+static PyObject* NodeHandle_get_value(PyObject* op, void* closure)
+{
+    NodeHandle* self = (NodeHandle*)op;
+    PyObject* value = NULL;
+    DoublyLinkedList* list;
+    while((list = NodeHandle_get_list(self)) != NULL)
+    {
+        int moved;
+        Py_BEGIN_CRITICAL_SECTION(list);
+        moved = self->list != list;
+        if(!moved && self->node) { value = Py_NewRef(self->node->value); }
+        Py_END_CRITICAL_SECTION();
+        Py_DECREF(list);
+        if(!moved) { break; }
+    }
+    if(!value) { PyErr_SetString(PyExc_ValueError, "Node has already been removed from its list"); }
+    return value;
+}
+
+static int NodeHandle_set_value(PyObject* op, PyObject* value, void* closure)
+{
+    NodeHandle* self = (NodeHandle*)op;
+    if(!value)
+    {
+        PyErr_SetString(PyExc_AttributeError, "Node value can not be deleted");
+        return -1;
+    }
+    PyObject* old_value = NULL;
+    int removed = 1;
+    DoublyLinkedList* list;
+    while((list = NodeHandle_get_list(self)) != NULL)
+    {
+        int moved;
+        Py_BEGIN_CRITICAL_SECTION(list);
+        moved = self->list != list;
+        if(!moved && self->node)
+        {
+            removed = 0;
+            old_value = DoublyLinkedList_swap_value(list, self->node, value);
+        }
+        Py_END_CRITICAL_SECTION();
+        Py_DECREF(list);
+        if(!moved) { break; }
+    }
+    if(removed)
+    {
+        PyErr_SetString(PyExc_ValueError, "Node has already been removed from its list");
+        return -1;
+    }
+    if(!old_value) { return -1; }
+    Py_DECREF(old_value);
+    return 0;
+}
+
+static PyObject* NodeHandle_get_valid(PyObject* op, void* closure)
+{
+    return PyBool_FromLong(((NodeHandle*)op)->node != NULL);
+}
+
+static PyObject* NodeHandle_repr(PyObject* op)
+{
+    PyObject* value = NodeHandle_get_value(op, NULL);
+    if(!value)
+    {
+        PyErr_Clear();
+        return PyUnicode_FromString("<NodeHandle removed>");
+    }
+    PyObject* repr = PyUnicode_FromFormat("<NodeHandle %R>", value);
+    Py_DECREF(value);
+    return repr;
+}
+
+static PyGetSetDef NodeHandle_getset[] = {
+    {"value", NodeHandle_get_value, NodeHandle_set_value,
+    "The item stored in the node.\nRaises ValueError if the node was removed from its list.", NULL},
+    {"valid", NodeHandle_get_valid, NULL,
+    "True while the node is still part of its list.", NULL},
+    {NULL}
+};
+
+static PyTypeObject NodeHandleType =
+{
+    .ob_base = PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "py_doubly_linked_list.doubly_linked_list.NodeHandle",
+    .tp_doc = PyDoc_STR("Handle to a single node of a DoublyLinkedList"),
+    .tp_basicsize = sizeof(NodeHandle),
+    .tp_itemsize = 0,
+    .tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC,
+    .tp_dealloc = (destructor)NodeHandle_dealloc,
+    .tp_traverse = NodeHandle_traverse,
+    .tp_clear = NodeHandle_clear,
+    .tp_repr = (reprfunc)NodeHandle_repr,
+    .tp_getset = NodeHandle_getset
+};
+
+// - - - - - Cursor - - - - - //
+
+// A cursor is a position in a list that Python code moves and edits through directly, each step
+// and edit is O(1). It sits on a node through the node's handle, so it notices when another
+// operation removes the node or splice moves it to another list and becomes invalid. A cursor
+// can also sit at the end of the list, one past the tail. The list keeps a chain of its cursors and
+// shifts their positions on every single insert and delete and on extend and splice, so positions
+// stay O(1) through edits anywhere. Bulk changes like sort or slice assignment make them be looked
+// up again, in O(log n) for indexed lists.
+// Methods lock the cursor and its list together.
+
+static PyTypeObject CursorType;
+
+static PyObject* Cursor_for(DoublyLinkedList* list, DLLNode* node, Py_ssize_t pos)
+{
+    Cursor* self = PyObject_GC_New(Cursor, &CursorType);
+    if(!self) { return NULL; }
+    self->list = (DoublyLinkedList*)Py_NewRef((PyObject*)list);
+    self->handle = node ? (NodeHandle*)NodeHandle_for(list, node) : NULL;
+    if(node && !self->handle) { Py_DECREF(self->list); PyObject_GC_Del(self); return NULL; }
+    self->pos = pos;
+    self->mod_count = list->mod_count;
+    self->prev = NULL;
+    self->next = list->cursors;
+    if(list->cursors) { list->cursors->prev = self; }
+    list->cursors = self;
+    PyObject_GC_Track(self);
+    return (PyObject*)self;
+}
+
+// Internal Methods
+
+// Sets node to the node of the cursor, or NULL at the end of the list. Raises ValueError if the node
+// was removed or moved to another list.
+static int Cursor_node(Cursor* self, DLLNode** node)
+{
+    *node = NULL;
+    if(!self->handle) { return 0; }
+    DLL_MUTEX_LOCK(handle_mutex);
+    int moved = self->handle->list != self->list;
+    DLL_MUTEX_UNLOCK(handle_mutex);
+    if(moved)
+    {
+        PyErr_SetString(PyExc_ValueError, "Cursor's node has been removed from its list");
+        return -1;
+    }
+    *node = self->handle->node;
+    return 0;
+}
+
+// Like Cursor_node, but raises IndexError at the end of the list
+static DLLNode* Cursor_current(Cursor* self)
+{
+    DLLNode* node;
+    if(Cursor_node(self, &node)) { return NULL; }
+    if(!node) { PyErr_SetString(PyExc_IndexError, "Cursor is at the end of the list"); }
+    return node;
+}
+
+// Lets go of the handle. One only the cursor holds is detached from its node first, so its dealloc
+// doesn't lock the list again.
+static void Cursor_drop_handle(Cursor* self)
+{
+    NodeHandle* handle = self->handle;
+    if(!handle) { return; }
+    self->handle = NULL;
+    if(Py_REFCNT(handle) == 1 && handle->list == self->list) { NodeHandle_invalidate(handle); }
+    Py_DECREF(handle);
+}
+
+// Moves the cursor to node, or to the end of the list if node is NULL. A handle only the cursor
+// holds moves along with it, so stepping through the list doesn't allocate.
+static int Cursor_move(Cursor* self, DLLNode* node)
+{
+    NodeHandle* handle = self->handle;
+    if(handle && node && !node->handle && handle->node && handle->list == self->list && Py_REFCNT(handle) == 1)
+    {
+        handle->node->handle = NULL;
+        handle->node = node;
+        node->handle = handle;
+        return 0;
+    }
+    NodeHandle* target = NULL;
+    if(node) { target = (NodeHandle*)NodeHandle_for(self->list, node); if(!target) { return -1; } }
+    Cursor_drop_handle(self);
+    self->handle = target;
+    return 0;
+}
+
+// Points the list's cursor at node for an insert or delete through the cursor. Returns 1 if the
+// position of node is known, otherwise the list's cursor has to be reset afterwards.
+static int Cursor_point_list(Cursor* self, DLLNode* node)
+{
+    DoublyLinkedList* list = self->list;
+    if(self->mod_count != list->mod_count)
+    {
+        if(list->cursor == node) { self->pos = list->cursor_pos; }
+        else if(list->index) { self->pos = DLLIndex_position(list->index, node); }
+        else
+        {
+            DoublyLinkedList_cursor_to_node(list, node);
+            return 0;
+        }
+        self->mod_count = list->mod_count;
+    }
+    list->cursor = node;
+    list->cursor_pos = self->pos;
+    return 1;
+}
+
+// Methods
+
+static PyObject* Cursor_next(PyObject* op, PyObject* Py_UNUSED(dummy))
+{
+    Cursor* self = (Cursor*)op;
+    DLLNode* node = Cursor_current(self); if(!node) { return NULL; }
+    if(Cursor_move(self, node->next)) { return NULL; }
+    self->pos += 1;
+    return Py_NewRef(Py_None);
+}
+
+static PyObject* Cursor_prev(PyObject* op, PyObject* Py_UNUSED(dummy))
+{
+    Cursor* self = (Cursor*)op;
+    DoublyLinkedList* list = self->list;
+    DLLNode* node;
+    if(Cursor_node(self, &node)) { return NULL; }
+    DLLNode* target = node ? node->prev : list->tail;
+    if(!target)
+    {
+        PyErr_SetString(PyExc_IndexError, "Cursor is at the start of the list");
+        return NULL;
+    }
+    if(Cursor_move(self, target)) { return NULL; }
+    // The tail's position is always known
+    if(!node)
+    {
+        self->pos = list->length - 1;
+        self->mod_count = list->mod_count;
+    }
+    else { self->pos -= 1; }
+    return Py_NewRef(Py_None);
+}
+
+static PyObject* Cursor_insert_at(Cursor* self, PyObject* object, int forward)
+{
+    DoublyLinkedList* list = self->list;
+    DLLNode* node;
+    if(Cursor_node(self, &node)) { return NULL; }
+    if(!node)
+    {
+        if(forward)
+        {
+            PyErr_SetString(PyExc_IndexError, "Cursor is at the end of the list");
+            return NULL;
+        }
+        // Inserting before the end appends
+        if(list->tail)
+        {
+            list->cursor = list->tail;
+            list->cursor_pos = list->length - 1;
+        }
+        if(DoublyLinkedList_cursor_insert((PyObject*)list, object, 1)) { return NULL; }
+        self->pos = list->length;
+        self->mod_count = list->mod_count;
+        return Py_NewRef(Py_None);
+    }
+    // The insert shifts the position of this cursor along with the others
+    int known = Cursor_point_list(self, node);
+    int rslt = DoublyLinkedList_cursor_insert((PyObject*)list, object, forward);
+    if(!known) { DoublyLinkedList_reset_cursor(list); }
+    if(rslt) { return NULL; }
+    return Py_NewRef(Py_None);
+}
+
+static PyObject* Cursor_insert_before(PyObject* op, PyObject* args, PyObject* kwds)
+{
+    static char* kwlist[] = {"object", NULL};
+    PyObject* object;
+    if(!PyArg_ParseTupleAndKeywords(args, kwds, "O", kwlist, &object)) { return NULL; }
+    return Cursor_insert_at((Cursor*)op, object, 0);
+}
+
+static PyObject* Cursor_insert_after(PyObject* op, PyObject* args, PyObject* kwds)
+{
+    static char* kwlist[] = {"object", NULL};
+    PyObject* object;
+    if(!PyArg_ParseTupleAndKeywords(args, kwds, "O", kwlist, &object)) { return NULL; }
+    return Cursor_insert_at((Cursor*)op, object, 1);
+}
+
+// The cursor moves to the next node before its node is deleted, so its handle can go along rather
+// than being invalidated. Deleting the tail leaves the cursor at the end of the list.
+static PyObject* Cursor_delete(PyObject* op, PyObject* Py_UNUSED(dummy))
+{
+    Cursor* self = (Cursor*)op;
+    DoublyLinkedList* list = self->list;
+    DLLNode* node = Cursor_current(self); if(!node) { return NULL; }
+    DLLNode* next = node->next;
+    if(next && Cursor_move(self, next)) { return NULL; }
+    PyObject* value = Py_NewRef(node->value);
+    int known = Cursor_point_list(self, node);
+    int rslt = DoublyLinkedList_cursor_delete((PyObject*)list);
+    if(!known) { DoublyLinkedList_reset_cursor(list); }
+    if(rslt)
+    {
+        // Going back usually finds the handle node kept or the one that moved, if it needs a new
+        // handle and can't get one the cursor stays on the next item
+        PyObject *type, *error, *traceback;
+        PyErr_Fetch(&type, &error, &traceback);
+        if(next && Cursor_move(self, node)) { PyErr_Clear(); }
+        PyErr_Restore(type, error, traceback);
+        Py_DECREF(value);
+        return NULL;
+    }
+    // The handle of a deleted tail was invalidated with it, releasing it doesn't lock the list
+    if(!next) { Cursor_drop_handle(self); }
+    return value;
+}
+
+// Getters and Setters
+
+static PyObject* Cursor_get_value(PyObject* op, void* closure)
+{
+    DLLNode* node = Cursor_current((Cursor*)op); if(!node) { return NULL; }
+    return Py_NewRef(node->value);
+}
+
+static int Cursor_set_value(PyObject* op, PyObject* value, void* closure)
+{
+    Cursor* self = (Cursor*)op;
+    if(!value)
+    {
+        PyErr_SetString(PyExc_AttributeError, "Cursor value can not be deleted");
+        return -1;
+    }
+    DLLNode* node = Cursor_current(self); if(!node) { return -1; }
+    PyObject* old_value = DoublyLinkedList_swap_value(self->list, node, value); if(!old_value) { return -1; }
+    Py_DECREF(old_value);
+    return 0;
+}
+
+static PyObject* Cursor_get_pos(PyObject* op, void* closure)
+{
+    Cursor* self = (Cursor*)op;
+    DoublyLinkedList* list = self->list;
+    DLLNode* node;
+    if(Cursor_node(self, &node)) { return NULL; }
+    if(!node) { return PyLong_FromSsize_t(list->length); }
+    if(self->mod_count != list->mod_count)
+    {
+        self->pos = DoublyLinkedList_position(list, node);
+        self->mod_count = list->mod_count;
+    }
+    return PyLong_FromSsize_t(self->pos);
+}
+
+static PyObject* Cursor_get_valid(PyObject* op, void* closure)
+{
+    Cursor* self = (Cursor*)op;
+    DLL_MUTEX_LOCK(handle_mutex);
+    int valid = !self->handle || self->handle->list == self->list;
+    DLL_MUTEX_UNLOCK(handle_mutex);
+    return PyBool_FromLong(valid);
+}
+
+// Initialization and deallocation
+
+static void Cursor_dealloc(PyObject* op)
+{
+    Cursor* self = (Cursor*)op;
+    PyObject_GC_UnTrack(op);
+    Py_BEGIN_CRITICAL_SECTION(self->list);
+    if(self->prev) { self->prev->next = self->next; } else { self->list->cursors = self->next; }
+    if(self->next) { self->next->prev = self->prev; }
+    Py_END_CRITICAL_SECTION();
+    Py_XDECREF(self->handle);
+    Py_XDECREF(self->list);
+    PyObject_GC_Del(op);
+}
+
+// Reference cycles through a cursor are broken by clearing its list
+static int Cursor_traverse(PyObject* op, visitproc visit, void* arg)
+{
+    Cursor* self = (Cursor*)op;
+    Py_VISIT(self->list);
+    Py_VISIT(self->handle);
+    return 0;
+}
+
+// Locked entry points
+
+#define CURSOR_LOCKED(rtype, func, params, call_args) \
+    static rtype func##_locked params \
+    { \
+        rtype rslt; \
+        Py_BEGIN_CRITICAL_SECTION2(op, (PyObject*)((Cursor*)op)->list); \
+        rslt = func call_args; \
+        Py_END_CRITICAL_SECTION2(); \
+        return rslt; \
+    }
+
+CURSOR_LOCKED(PyObject*, Cursor_next, (PyObject* op, PyObject* dummy), (op, dummy))
+CURSOR_LOCKED(PyObject*, Cursor_prev, (PyObject* op, PyObject* dummy), (op, dummy))
+CURSOR_LOCKED(PyObject*, Cursor_insert_before, (PyObject* op, PyObject* args, PyObject* kwds), (op, args, kwds))
+CURSOR_LOCKED(PyObject*, Cursor_insert_after, (PyObject* op, PyObject* args, PyObject* kwds), (op, args, kwds))
+CURSOR_LOCKED(PyObject*, Cursor_delete, (PyObject* op, PyObject* dummy), (op, dummy))
+CURSOR_LOCKED(PyObject*, Cursor_get_value, (PyObject* op, void* closure), (op, closure))
+CURSOR_LOCKED(int, Cursor_set_value, (PyObject* op, PyObject* value, void* closure), (op, value, closure))
+CURSOR_LOCKED(PyObject*, Cursor_get_pos, (PyObject* op, void* closure), (op, closure))
+CURSOR_LOCKED(PyObject*, Cursor_get_valid, (PyObject* op, void* closure), (op, closure))
+
+static PyMethodDef Cursor_methods[] = {
+    {"next", (PyCFunction)Cursor_next_locked, METH_NOARGS,
+    "Move to the next item, or to the end of the list from the last item.\nRaises IndexError at the end of the list."},
+    {"prev", (PyCFunction)Cursor_prev_locked, METH_NOARGS,
+    "Move to the previous item, or to the last item from the end of the list.\nRaises IndexError at the first item."},
+    {"insert_before", (PyCFunction)Cursor_insert_before_locked, METH_VARARGS|METH_KEYWORDS,
+    "Insert object before the cursor, the cursor stays on its item. At the end of the list object is appended."},
+    {"insert_after", (PyCFunction)Cursor_insert_after_locked, METH_VARARGS|METH_KEYWORDS,
+    "Insert object after the cursor, the cursor stays on its item.\nRaises IndexError at the end of the list."},
+    {"delete", (PyCFunction)Cursor_delete_locked, METH_NOARGS,
+    "Remove and return the item at the cursor and move to the next item.\nRaises IndexError at the end of the list."},
+    {NULL}
+};
+
+static PyGetSetDef Cursor_getset[] = {
+    {"value", Cursor_get_value_locked, Cursor_set_value_locked,
+    "The item at the cursor.\nRaises IndexError at the end of the list.", NULL},
+    {"pos", Cursor_get_pos_locked, NULL,
+    "Index of the cursor, the length of the list at its end.\nO(1) through inserts, deletes, extend and splice anywhere in the list. After bulk changes\nlike sort, reverse or slice assignment it is looked up again, in O(log n) for indexed lists\nand otherwise by walking to the nearest end of the list or known position, O(n) in the worst case.", NULL},
+    {"valid", Cursor_get_valid_locked, NULL,
+    "False once the item at the cursor was removed by something other than the cursor.", NULL},
+    {NULL}
+};
+
+static PyTypeObject CursorType =
+{
+    .ob_base = PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "py_doubly_linked_list.doubly_linked_list.Cursor",
+    .tp_doc = PyDoc_STR("Position in a DoublyLinkedList for O(1) navigation and editing"),
+    .tp_basicsize = sizeof(Cursor),
+    .tp_itemsize = 0,
+    .tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC,
+    .tp_dealloc = (destructor)Cursor_dealloc,
+    .tp_traverse = Cursor_traverse,
+    .tp_methods = Cursor_methods,
+    .tp_getset = Cursor_getset
+};
+
+// - - - - - UnrolledLinkedList - - - - - //
+
+// Same interface as DoublyLinkedList, but every node is a block holding up to block_size items,
+// so scans touch one cache line per few items instead of one node per item. Full blocks are split
+// in half on insert and sparse blocks are merged with a neighbour on delete.
+
+#define UNROLLED_DEFAULT_BLOCK 32
+#define UNROLLED_MIN_BLOCK 4
+#define UNROLLED_MAX_BLOCK 1024
+
+typedef struct DLLBlock
+{
+    struct DLLBlock* next;
+    struct DLLBlock* prev;
+    Py_ssize_t count;
+    PyObject* items[];
+} DLLBlock;
+
+typedef struct
+{
+    PyObject_HEAD
+    DLLBlock* head;
+    DLLBlock* tail;
+    DLLBlock* cursor; // Block of the last located position
+    Py_ssize_t cursor_start; // Position of the first item in the cursor block
+    Py_ssize_t length;
+    Py_ssize_t block_size;
+    Py_ssize_t block_count;
+    size_t mod_count;
+} UnrolledLinkedList;
+
+// A position inside the block chain
+typedef struct
+{
+    DLLBlock* block;
+    Py_ssize_t offset;
+} UnrolledPos;
+
+static PyTypeObject UnrolledLinkedListType;
+static PyTypeObject UnrolledLinkedListIteratorType;
+
+static PyObject* UnrolledLinkedList_new(PyTypeObject*, PyObject*, PyObject*);
+static int UnrolledLinkedList_extend_iterable(UnrolledLinkedList*, PyObject*, int);
+
+// Block helpers
+
+static DLLBlock* UnrolledLinkedList_new_block(UnrolledLinkedList* self)
+{
+    DLLBlock* block = PyMem_Malloc(sizeof(DLLBlock) + self->block_size * sizeof(PyObject*));
+    if(!block) { PyErr_NoMemory(); return NULL; }
+    block->next = NULL;
+    block->prev = NULL;
+    block->count = 0;
+    self->block_count += 1;
+    return block;
+}
+
+// Links block into the chain after prev, or at the head if prev is NULL
+static void UnrolledLinkedList_link_block(UnrolledLinkedList* self, DLLBlock* block, DLLBlock* prev)
+{
+    block->prev = prev;
+    block->next = prev ? prev->next : self->head;
+    if(block->next) { block->next->prev = block; } else { self->tail = block; }
+    if(prev) { prev->next = block; } else { self->head = block; }
+}
+
+static void UnrolledLinkedList_free_block(UnrolledLinkedList* self, DLLBlock* block)
+{
+    if(block->prev) { block->prev->next = block->next; } else { self->head = block->next; }
+    if(block->next) { block->next->prev = block->prev; } else { self->tail = block->prev; }
+    self->block_count -= 1;
+    PyMem_Free(block);
+}
+
+// Releases a detached block chain and the items in it
+static void UnrolledLinkedList_dealloc_chain(DLLBlock* block)
+{
+    while(block)
+    {
+        DLLBlock* next = block->next;
+        for(Py_ssize_t i = 0; i < block->count; i++) { Py_DECREF(block->items[i]); }
+        PyMem_Free(block);
+        block = next;
+    }
+}
+
+static void UnrolledPos_advance(UnrolledPos* pos, Py_ssize_t steps)
+{
+    Py_ssize_t offset = pos->offset + steps;
+    while(offset >= pos->block->count && pos->block->next)
+    {
+        offset -= pos->block->count;
+        pos->block = pos->block->next;
+    }
+    while(offset < 0 && pos->block->prev)
+    {
+        pos->block = pos->block->prev;
+        offset += pos->block->count;
+    }
+    pos->offset = offset;
+}
+
+// Internal Methods
+
+// Normalizes a possibly negative index, raising IndexError if it is out of range
+static int UnrolledLinkedList_check_index(UnrolledLinkedList* self, Py_ssize_t* index)
+{
+    if(*index < 0) { *index += self->length; }
+    if(*index < 0 || *index >= self->length)
+    {
+        PyErr_SetString(PyExc_IndexError, "Index out of bounds");
+        return -1;
+    }
+    return 0;
+}
+
+// Finds the block holding position (which must be in range) from the nearest of the cursor,
+// head and tail, and moves the cursor there
+static UnrolledPos UnrolledLinkedList_locate(UnrolledLinkedList* self, Py_ssize_t position)
+{
+    DLLBlock* block = self->head;
+    Py_ssize_t start = 0;
+    Py_ssize_t distance = position;
+    if(self->length - position < distance)
+    {
+        block = self->tail;
+        start = self->length - self->tail->count;
+        distance = self->length - position;
+    }
+    if(self->cursor)
+    {
+        Py_ssize_t cursor_distance = position - self->cursor_start;
+        if(cursor_distance < 0) { cursor_distance = -cursor_distance; }
+        if(cursor_distance < distance)
+        {
+            block = self->cursor;
+            start = self->cursor_start;
+        }
+    }
+    while(position < start)
+    {
+        block = block->prev;
+        start -= block->count;
+    }
+    while(position >= start + block->count)
+    {
+        start += block->count;
+        block = block->next;
+    }
+    self->cursor = block;
+    self->cursor_start = start;
+    UnrolledPos pos = {block, position - start};
+    return pos;
+}
+
+// Inserts object so that it ends up at position, 0 <= position <= length
+static int UnrolledLinkedList_insert_at(UnrolledLinkedList* self, Py_ssize_t position, PyObject* object)
+{
+    DLLBlock* block;
+    Py_ssize_t start, offset;
+    if(!self->head)
+    {
+        block = UnrolledLinkedList_new_block(self); if(!block) { return -1; }
+        UnrolledLinkedList_link_block(self, block, NULL);
+        start = 0;
+        offset = 0;
+    }
+    else if(position == self->length)
+    {
+        block = self->tail;
+        start = self->length - block->count;
+        offset = block->count;
+    }
+    else
+    {
+        UnrolledPos pos = UnrolledLinkedList_locate(self, position);
+        block = pos.block;
+        start = self->cursor_start;
+        offset = pos.offset;
+    }
+    if(block->count == self->block_size)
+    {
+        DLLBlock* new_block = UnrolledLinkedList_new_block(self); if(!new_block) { return -1; }
+        if(offset == block->count && !block->next)
+        {
+            // Appending to a full tail starts a new block
+            UnrolledLinkedList_link_block(self, new_block, block);
+            start += block->count;
+            block = new_block;
+            offset = 0;
+        }
+        else if(offset == 0 && !block->prev)
+        {
+            // Prepending to a full head starts a new block
+            UnrolledLinkedList_link_block(self, new_block, NULL);
+            block = new_block;
+        }
+        else
+        {
+            Py_ssize_t half = block->count / 2;
+            UnrolledLinkedList_link_block(self, new_block, block);
+            memcpy(new_block->items, &block->items[half], (block->count - half) * sizeof(PyObject*));
+            new_block->count = block->count - half;
+            block->count = half;
+            if(offset > half)
+            {
+                start += half;
+                offset -= half;
+                block = new_block;
+            }
+        }
+    }
+    memmove(&block->items[offset+1], &block->items[offset], (block->count - offset) * sizeof(PyObject*));
+    block->items[offset] = Py_NewRef(object);
+    block->count += 1;
+    self->length += 1;
+    self->mod_count += 1;
+    self->cursor = block;
+    self->cursor_start = start;
+    return 0;
+}
+
+// Removes the item at position (which must be in range) and returns it
+static PyObject* UnrolledLinkedList_take(UnrolledLinkedList* self, Py_ssize_t position)
+{
+    UnrolledPos pos = UnrolledLinkedList_locate(self, position);
+    DLLBlock* block = pos.block;
+    Py_ssize_t start = self->cursor_start;
+    PyObject* item = block->items[pos.offset];
+    memmove(&block->items[pos.offset], &block->items[pos.offset+1], (block->count - pos.offset - 1) * sizeof(PyObject*));
+    block->count -= 1;
+    self->length -= 1;
+    self->mod_count += 1;
+    if(block->count == 0)
+    {
+        DLLBlock* next = block->next;
+        DLLBlock* prev = block->prev;
+        UnrolledLinkedList_free_block(self, block);
+        if(next) { block = next; }
+        else if(prev) { block = prev; start -= prev->count; }
+        else { block = NULL; start = 0; }
+    }
+    else if(block->count <= self->block_size / 4)
+    {
+        // Merge sparse blocks so the chain stays dense
+        if(block->next && block->count + block->next->count <= self->block_size)
+        {
+            DLLBlock* next = block->next;
+            memcpy(&block->items[block->count], next->items, next->count * sizeof(PyObject*));
+            block->count += next->count;
+            UnrolledLinkedList_free_block(self, next);
+        }
+        else if(block->prev && block->count + block->prev->count <= self->block_size)
+        {
+            DLLBlock* prev = block->prev;
+            memcpy(&prev->items[prev->count], block->items, block->count * sizeof(PyObject*));
+            start -= prev->count;
+            prev->count += block->count;
+            UnrolledLinkedList_free_block(self, block);
+            block = prev;
+        }
+    }
+    self->cursor = block;
+    self->cursor_start = start;
+    return item;
+}
+
+static int UnrolledLinkedList_extend_iterable(UnrolledLinkedList* self, PyObject* iterable, int forward)
+{
+    // Extending a list with itself reads a snapshot, its own iterator would see it change
+    PyObject* source = Py_Is(iterable, (PyObject*)self) ? PySequence_List(iterable) : Py_NewRef(iterable); if(!source) { return -1; }
+    PyObject* iterator = PyObject_GetIter(source);
+    Py_DECREF(source);
+    if(!iterator) { return -1; }
+    PyObject* item;
+    while((item = PyIter_Next(iterator)) != NULL)
+    {
+        int rslt = UnrolledLinkedList_insert_at(self, forward ? self->length : 0, item);
+        Py_DECREF(item);
+        if(rslt) { Py_DECREF(iterator); return -1; }
+    }
+    Py_DECREF(iterator);
+    if(PyErr_Occurred()) { return -1; }
+    return 0;
+}
+
+// Moves the items of the block after block into it when both fit in one
+static void UnrolledLinkedList_merge_next(UnrolledLinkedList* self, DLLBlock* block)
+{
+    if(!block || !block->next || block->count + block->next->count > self->block_size) { return; }
+    DLLBlock* next = block->next;
+    memcpy(&block->items[block->count], next->items, next->count * sizeof(PyObject*));
+    block->count += next->count;
+    UnrolledLinkedList_free_block(self, next);
+}
+
+// Moves count items, step apart from start on (step > 0), out of the chain into removed. Each block
+// touched is compacted in place once and merged with its neighbours when they fit in one block.
+static void UnrolledLinkedList_unlink_slice(UnrolledLinkedList* self, Py_ssize_t start, Py_ssize_t step, Py_ssize_t count, PyObject** removed)
+{
+    if(count == 0) { return; }
+    UnrolledPos pos = UnrolledLinkedList_locate(self, start);
+    DLLBlock* block = pos.block;
+    Py_ssize_t offset = pos.offset; // Offset of the next item to remove, relative to block
+    Py_ssize_t taken = 0;
+    while(taken < count)
+    {
+        Py_ssize_t kept = offset < block->count ? offset : block->count;
+        for(Py_ssize_t i = kept; i < block->count; i++)
+        {
+            if(taken < count && i == offset) { removed[taken++] = block->items[i]; offset += step; }
+            else { block->items[kept++] = block->items[i]; }
+        }
+        offset -= block->count;
+        block->count = kept;
+        DLLBlock* next = block->next;
+        if(kept == 0) { UnrolledLinkedList_free_block(self, block); }
+        else if(block->prev && block->prev->count + kept <= self->block_size) { UnrolledLinkedList_merge_next(self, block->prev); }
+        block = next;
+    }
+    if(block) { UnrolledLinkedList_merge_next(self, block->prev); }
+    self->length -= count;
+    self->mod_count += 1;
+    self->cursor = NULL;
+}
+
+// Releases a detached chain made for this list
+static void UnrolledLinkedList_drop_chain(UnrolledLinkedList* self, DLLBlock* first)
+{
+    for(DLLBlock* block = first; block; block = block->next) { self->block_count -= 1; }
+    UnrolledLinkedList_dealloc_chain(first);
+}
+
+// Copies count items into a detached chain of full blocks
+static int UnrolledLinkedList_chain_from_array(UnrolledLinkedList* self, PyObject** items, Py_ssize_t count, DLLBlock** first, DLLBlock** last)
+{
+    *first = NULL; *last = NULL;
+    for(Py_ssize_t i = 0; i < count; i++)
+    {
+        if(!*last || (*last)->count == self->block_size)
+        {
+            DLLBlock* block = UnrolledLinkedList_new_block(self);
+            if(!block) { UnrolledLinkedList_drop_chain(self, *first); return -1; }
+            block->prev = *last;
+            if(*last) { (*last)->next = block; } else { *first = block; }
+            *last = block;
+        }
+        (*last)->items[(*last)->count++] = Py_NewRef(items[i]);
+    }
+    return 0;
+}
+
+// Links a detached chain holding count items in at position, 0 <= position <= length. Spare is an
+// allocated block used to split the block at position when it lands inside one, it is freed if unused.
+static void UnrolledLinkedList_link_chain(UnrolledLinkedList* self, DLLBlock* first, DLLBlock* last, Py_ssize_t count, Py_ssize_t position, DLLBlock* spare)
+{
+    DLLBlock* prev = NULL;
+    if(position == self->length) { prev = self->tail; }
+    else if(position > 0)
+    {
+        UnrolledPos pos = UnrolledLinkedList_locate(self, position);
+        prev = pos.block;
+        if(pos.offset == 0) { prev = prev->prev; }
+        else
+        {
+            memcpy(spare->items, &prev->items[pos.offset], (prev->count - pos.offset) * sizeof(PyObject*));
+            spare->count = prev->count - pos.offset;
+            prev->count = pos.offset;
+            UnrolledLinkedList_link_block(self, spare, prev);
+            spare = NULL;
+        }
+    }
+    if(spare) { PyMem_Free(spare); self->block_count -= 1; }
+    first->prev = prev;
+    last->next = prev ? prev->next : self->head;
+    if(last->next) { last->next->prev = last; } else { self->tail = last; }
+    if(prev) { prev->next = first; } else { self->head = first; }
+    UnrolledLinkedList_merge_next(self, last);
+    UnrolledLinkedList_merge_next(self, prev);
+    self->length += count;
+    self->mod_count += 1;
+    self->cursor = NULL;
+}
+
+// Initialization and deallocation
+
+static void UnrolledLinkedList_dealloc(PyObject* op)
+{
+    UnrolledLinkedList* self = (UnrolledLinkedList*)op;
+    PyObject_GC_UnTrack(op);
+    Py_TRASHCAN_BEGIN(op, UnrolledLinkedList_dealloc)
+    UnrolledLinkedList_dealloc_chain(self->head);
+    Py_TYPE(self)->tp_free(self);
+    Py_TRASHCAN_END
+}
+
+static int UnrolledLinkedList_traverse(PyObject* op, visitproc visit, void* arg)
+{
+    UnrolledLinkedList* self = (UnrolledLinkedList*)op;
+    for(DLLBlock* block = self->head; block; block = block->next)
+    {
+        for(Py_ssize_t i = 0; i < block->count; i++) { Py_VISIT(block->items[i]); }
+    }
+    return 0;
+}
+
+static int UnrolledLinkedList_clear(PyObject* op)
+{
+    UnrolledLinkedList* self = (UnrolledLinkedList*)op;
+    DLLBlock* head = self->head;
+    self->head = NULL; self->tail = NULL; self->cursor = NULL;
+    self->length = 0; self->cursor_start = 0; self->block_count = 0;
+    self->mod_count += 1;
+    UnrolledLinkedList_dealloc_chain(head);
+    return 0;
+}
+
+static PyObject* UnrolledLinkedList_new(PyTypeObject* type, PyObject* args, PyObject* kwds)
+{
+    UnrolledLinkedList* self = (UnrolledLinkedList*)type->tp_alloc(type, 0);
+    if(self)
+    {
+        self->head = NULL;
+        self->tail = NULL;
+        self->cursor = NULL;
+        self->cursor_start = 0;
+        self->length = 0;
+        self->block_size = UNROLLED_DEFAULT_BLOCK;
+        self->block_count = 0;
+        self->mod_count = 0;
+    }
+    return (PyObject*)self;
+}
+
+static int UnrolledLinkedList_init(PyObject* op, PyObject* args, PyObject* kwds)
+{
+    UnrolledLinkedList* self = (UnrolledLinkedList*)op;
+    static char* kwlist[] = {"", "block_size", NULL};
+    PyObject* iterable = NULL;
+    Py_ssize_t block_size = UNROLLED_DEFAULT_BLOCK;
+    if(!PyArg_ParseTupleAndKeywords(args, kwds, "|O$n", kwlist, &iterable, &block_size)) { return -1; }
+    if(block_size < UNROLLED_MIN_BLOCK || block_size > UNROLLED_MAX_BLOCK)
+    {
+        PyErr_Format(PyExc_ValueError, "block_size must be between %d and %d", UNROLLED_MIN_BLOCK, UNROLLED_MAX_BLOCK);
+        return -1;
+    }
+    if(self->head && block_size != self->block_size)
+    {
+        PyErr_SetString(PyExc_ValueError, "block_size can not be changed once the list has items");
+        return -1;
+    }
+    self->block_size = block_size;
+    if(iterable && UnrolledLinkedList_extend_iterable(self, iterable, 1)) { return -1; }
+    return 0;
+}
+
+// Methods
+
+static PyObject* UnrolledLinkedList_append(PyObject* op, PyObject* args, PyObject* kwds)
+{
+    UnrolledLinkedList* self = (UnrolledLinkedList*)op;
+    static char* kwlist[] = {"object", "forward", NULL};
+    PyObject* object;
+    int forward = 1;
+    if(!PyArg_ParseTupleAndKeywords(args, kwds, "O|i", kwlist, &object, &forward)) { return NULL; }
+    if(UnrolledLinkedList_insert_at(self, forward ? self->length : 0, object)) { return NULL; }
+    return Py_NewRef(Py_None);
+}
+
+static PyObject* UnrolledLinkedList_insert(PyObject* op, PyObject* args, PyObject* kwds)
+{
+    UnrolledLinkedList* self = (UnrolledLinkedList*)op;
+    static char* kwlist[] = {"object", "index", "forward", NULL};
+    PyObject* object;
+    Py_ssize_t index;
+    int forward = 1;
+    if(!PyArg_ParseTupleAndKeywords(args, kwds, "On|i", kwlist, &object, &index, &forward)) { return NULL; }
+    if(UnrolledLinkedList_check_index(self, &index)) { return NULL; }
+    if(UnrolledLinkedList_insert_at(self, forward ? index + 1 : index, object)) { return NULL; }
+    return Py_NewRef(Py_None);
+}
+
+static PyObject* UnrolledLinkedList_pop(PyObject* op, PyObject* args, PyObject* kwds)
+{
+    UnrolledLinkedList* self = (UnrolledLinkedList*)op;
+    static char* kwlist[] = {"index", NULL};
+    Py_ssize_t index = -1;
+    if(!PyArg_ParseTupleAndKeywords(args, kwds, "|n", kwlist, &index)) { return NULL; }
+    if(UnrolledLinkedList_check_index(self, &index)) { return NULL; }
+    return UnrolledLinkedList_take(self, index);
+}
+
+// Returns the position of the first item equal to value in [start, stop), -1 if there is none or -2 on error
+static Py_ssize_t UnrolledLinkedList_find(UnrolledLinkedList* self, PyObject* value, Py_ssize_t start, Py_ssize_t stop)
+{
+    if(start < 0) { start += self->length; if(start < 0) { start = 0; } }
+    if(stop < 0) { stop += self->length; if(stop < 0) { stop = 0; } }
+    if(stop > self->length) { stop = self->length; }
+    if(start >= stop) { return -1; }
+    UnrolledPos pos = UnrolledLinkedList_locate(self, start);
+    DLLBlock* block = pos.block;
+    Py_ssize_t offset = pos.offset;
+    DLLMatcher matcher;
+    DLLMatcher_init(&matcher, value);
+    size_t mod_count = self->mod_count;
+    for(Py_ssize_t i = start; i < stop; i++)
+    {
+        if(offset == block->count) { block = block->next; offset = 0; }
+        int rslt = DLLMatcher_match(&matcher, block->items[offset]);
+        if(rslt == -1) { return -2; }
+        if(rslt) { return i; }
+        if(mod_count != self->mod_count)
+        {
+            PyErr_SetString(PyExc_RuntimeError, "UnrolledLinkedList changed during search");
+            return -2;
+        }
+        offset += 1;
+    }
+    return -1;
+}
+
+static PyObject* UnrolledLinkedList_index(PyObject* op, PyObject* args, PyObject* kwds)
+{
+    UnrolledLinkedList* self = (UnrolledLinkedList*)op;
+    static char* kwlist[] = {"value", "start", "stop", NULL};
+    PyObject* value; Py_ssize_t start = 0; Py_ssize_t stop = PY_SSIZE_T_MAX;
+    if(!PyArg_ParseTupleAndKeywords(args, kwds, "O|nn", kwlist, &value, &start, &stop)) { return NULL; }
+    Py_ssize_t index = UnrolledLinkedList_find(self, value, start, stop);
+    if(index == -2) { return NULL; }
+    if(index == -1) { PyErr_Format(PyExc_ValueError, "%R is not in list", value); return NULL; }
+    return PyLong_FromSsize_t(index);
+}
+
+static PyObject* UnrolledLinkedList_remove(PyObject* op, PyObject* args, PyObject* kwds)
+{
+    UnrolledLinkedList* self = (UnrolledLinkedList*)op;
+    static char* kwlist[] = {"value", "start", "stop", NULL};
+    PyObject* value; Py_ssize_t start = 0; Py_ssize_t stop = PY_SSIZE_T_MAX;
+    if(!PyArg_ParseTupleAndKeywords(args, kwds, "O|nn", kwlist, &value, &start, &stop)) { return NULL; }
+    Py_ssize_t index = UnrolledLinkedList_find(self, value, start, stop);
+    if(index == -2) { return NULL; }
+    if(index == -1) { PyErr_Format(PyExc_ValueError, "%R is not in list", value); return NULL; }
+    Py_DECREF(UnrolledLinkedList_take(self, index));
+    return Py_NewRef(Py_None);
+}
+
+static PyObject* UnrolledLinkedList_count(PyObject* op, PyObject* args, PyObject* kwds)
+{
+    UnrolledLinkedList* self = (UnrolledLinkedList*)op;
+    static char* kwlist[] = {"value", NULL};
+    PyObject* value;
+    if(!PyArg_ParseTupleAndKeywords(args, kwds, "O", kwlist, &value)) { return NULL; }
+    Py_ssize_t count = 0;
+    DLLMatcher matcher;
+    DLLMatcher_init(&matcher, value);
+    size_t mod_count = self->mod_count;
+    for(DLLBlock* block = self->head; block; block = block->next)
+    {
+        for(Py_ssize_t i = 0; i < block->count; i++)
+        {
+            int rslt = DLLMatcher_match(&matcher, block->items[i]);
+            if(rslt == -1) { return NULL; }
+            count += rslt;
+            if(mod_count != self->mod_count)
+            {
+                PyErr_SetString(PyExc_RuntimeError, "UnrolledLinkedList changed during count");
+                return NULL;
+            }
+        }
+    }
+    return PyLong_FromSsize_t(count);
+}
+
+static PyObject* UnrolledLinkedList_extend(PyObject* op, PyObject* args, PyObject* kwds)
+{
+    UnrolledLinkedList* self = (UnrolledLinkedList*)op;
+    static char* kwlist[] = {"iterable", "forward", NULL};
+    PyObject* iterable;
+    int forward = 1;
+    if(!PyArg_ParseTupleAndKeywords(args, kwds, "O|i", kwlist, &iterable, &forward)) { return NULL; }
+    if(UnrolledLinkedList_extend_iterable(self, iterable, forward)) { return NULL; }
+    return Py_NewRef(Py_None);
+}
+
+static UnrolledLinkedList* UnrolledLinkedList_empty_like(UnrolledLinkedList* self)
+{
+    UnrolledLinkedList* list = (UnrolledLinkedList*)UnrolledLinkedList_new(&UnrolledLinkedListType, NULL, NULL);
+    if(list) { list->block_size = self->block_size; }
+    return list;
+}
+
+static PyObject* UnrolledLinkedList_copy(PyObject* op)
+{
+    UnrolledLinkedList* self = (UnrolledLinkedList*)op;
+    UnrolledLinkedList* copy = UnrolledLinkedList_empty_like(self); if(!copy) { return NULL; }
+    DLLBlock* prev = NULL;
+    for(DLLBlock* block = self->head; block; block = block->next)
+    {
+        DLLBlock* new_block = UnrolledLinkedList_new_block(copy);
+        if(!new_block) { Py_DECREF(copy); return NULL; }
+        for(Py_ssize_t i = 0; i < block->count; i++) { new_block->items[i] = Py_NewRef(block->items[i]); }
+        new_block->count = block->count;
+        UnrolledLinkedList_link_block(copy, new_block, prev);
+        copy->length += block->count;
+        prev = new_block;
+    }
+    return (PyObject*)copy;
+}
+
+static PyObject* UnrolledLinkedList_reverse(PyObject* op)
+{
+    UnrolledLinkedList* self = (UnrolledLinkedList*)op;
+    DLLBlock* block = self->head;
+    while(block)
+    {
+        DLLBlock* next = block->next;
+        for(Py_ssize_t i = 0, j = block->count - 1; i < j; i++, j--)
+        {
+            PyObject* temp = block->items[i];
+            block->items[i] = block->items[j];
+            block->items[j] = temp;
+        }
+        block->next = block->prev;
+        block->prev = next;
+        block = next;
+    }
+    block = self->head;
+    self->head = self->tail;
+    self->tail = block;
+    self->cursor = NULL;
+    self->mod_count += 1;
+    return Py_NewRef(Py_None);
+}
+
+static PyObject* UnrolledLinkedList_clear_method(PyObject* op)
+{
+    UnrolledLinkedList_clear(op);
+    return Py_NewRef(Py_None);
+}
+
+// Sorts a flat copy of the item pointers with list.sort and writes the order back into the blocks.
+// Key and reverse are parsed here since the key may be passed positionally like DoublyLinkedList.sort.
+static PyObject* UnrolledLinkedList_sort(PyObject* op, PyObject* args, PyObject* kwds)
+{
+    UnrolledLinkedList* self = (UnrolledLinkedList*)op;
+    char* kwlist[] = {"key", "reverse", NULL};
+    PyObject* key = Py_None; int reverse = 0;
+    if(!PyArg_ParseTupleAndKeywords(args, kwds, "|Oi", kwlist, &key, &reverse)) { return NULL; }
+    if(!Py_IsNone(key) && !PyCallable_Check(key)) { PyErr_SetString(PyExc_TypeError, "Key must be a callable"); return NULL; }
+    PyObject* items = PyList_New(self->length); if(!items) { return NULL; }
+    Py_ssize_t i = 0;
+    for(DLLBlock* block = self->head; block; block = block->next)
+    {
+        for(Py_ssize_t j = 0; j < block->count; j++) { PyList_SET_ITEM(items, i++, Py_NewRef(block->items[j])); }
+    }
+    size_t mod_count = self->mod_count;
+    PyObject* sort_args = PyTuple_New(0);
+    PyObject* sort_kwds = Py_BuildValue("{s:O,s:O}", "key", key, "reverse", reverse ? Py_True : Py_False);
+    PyObject* sort = PyObject_GetAttrString(items, "sort");
+    PyObject* rslt = sort && sort_args && sort_kwds ? PyObject_Call(sort, sort_args, sort_kwds) : NULL;
+    Py_XDECREF(sort); Py_XDECREF(sort_args); Py_XDECREF(sort_kwds);
+    if(mod_count != self->mod_count)
+    {
+        Py_XDECREF(rslt);
+        Py_DECREF(items);
+        PyErr_SetString(PyExc_ValueError, "list modified during sort");
+        return NULL;
+    }
+    // The list holds the same objects, so the pointers can be swapped in without touching refcounts
+    if(PyList_GET_SIZE(items) == self->length)
+    {
+        i = 0;
+        for(DLLBlock* block = self->head; block; block = block->next)
+        {
+            for(Py_ssize_t j = 0; j < block->count; j++)
+            {
+                PyObject* item = PyList_GET_ITEM(items, i);
+                PyList_SET_ITEM(items, i++, block->items[j]);
+                block->items[j] = item;
+            }
+        }
+    }
+    Py_DECREF(items);
+    self->mod_count += 1;
+    return rslt;
+}
+
+static PyObject* UnrolledLinkedList_sizeof(PyObject* op, PyObject* Py_UNUSED(dummy))
+{
+    UnrolledLinkedList* self = (UnrolledLinkedList*)op;
+    Py_ssize_t block_bytes = sizeof(DLLBlock) + self->block_size * sizeof(PyObject*);
+    return PyLong_FromSsize_t(Py_TYPE(self)->tp_basicsize + self->block_count * block_bytes);
+}
+
+static PyObject* UnrolledLinkedList_reduce(PyObject* op, PyObject* Py_UNUSED(dummy))
+{
+    UnrolledLinkedList* self = (UnrolledLinkedList*)op;
+    if(self->block_size == UNROLLED_DEFAULT_BLOCK) { return DLL_reduce_streamed(op, NULL); }
+    PyObject* settings = Py_BuildValue("{sn}", "block_size", self->block_size); if(!settings) { return NULL; }
+    PyObject* rslt = DLL_reduce_streamed(op, settings);
+    Py_DECREF(settings);
+    return rslt;
+}
+
+static PyObject* UnrolledLinkedList_get_block_size(PyObject* op, void* closure)
+{
+    return PyLong_FromSsize_t(((UnrolledLinkedList*)op)->block_size);
+}
+
+// Compares like list does, finding the first items that differ and ordering those, or the lengths if
+// there are none. Ordering is only supported against UnrolledLinkedLists, lists and tuples, equality
+// against any iterable.
+static PyObject* UnrolledLinkedList_rich_compare(PyObject* op, PyObject* other, int compare_op)
+{
+    UnrolledLinkedList* self = (UnrolledLinkedList*)op;
+    int equality = compare_op == Py_EQ || compare_op == Py_NE;
+    if(op == other) { Py_RETURN_RICHCOMPARE(0, 0, compare_op); }
+    if(!equality && !PyObject_TypeCheck(other, &UnrolledLinkedListType) && !PyList_CheckExact(other) && !PyTuple_CheckExact(other))
+    {
+        Py_RETURN_NOTIMPLEMENTED;
+    }
+    PyObject* iterator = PyObject_GetIter(other);
+    if(!iterator)
+    {
+        PyErr_Clear();
+        Py_RETURN_NOTIMPLEMENTED;
+    }
+    size_t mod_count = self->mod_count;
+    PyObject* own = NULL;
+    PyObject* item = NULL;
+    Py_ssize_t compared = 0;
+    int done = 0;
+    for(DLLBlock* block = self->head; block && !done; block = block->next)
+    {
+        for(Py_ssize_t i = 0; i < block->count; i++)
+        {
+            item = PyIter_Next(iterator);
+            if(!item)
+            {
+                if(PyErr_Occurred()) { goto error; }
+                done = 1;
+                break;
+            }
+            own = Py_NewRef(block->items[i]);
+            int rslt = DLL_items_equal(own, item); if(rslt == -1) { goto error; }
+            if(mod_count != self->mod_count)
+            {
+                PyErr_SetString(PyExc_RuntimeError, "UnrolledLinkedList changed during comparison");
+                goto error;
+            }
+            if(!rslt) { done = 1; break; }
+            Py_CLEAR(own);
+            Py_CLEAR(item);
+            compared += 1;
+        }
+    }
+    PyObject* rtn;
+    if(own)
+    {
+        if(compare_op == Py_EQ) { rtn = Py_NewRef(Py_False); }
+        else if(compare_op == Py_NE) { rtn = Py_NewRef(Py_True); }
+        else { rtn = DLL_items_order(own, item, compare_op); }
+        Py_DECREF(own);
+        Py_DECREF(item);
+        Py_DECREF(iterator);
+        return rtn;
+    }
+    // All compared items are equal, so the longer side is greater
+    int self_longer = compared < self->length;
+    int other_longer = 0;
+    if(!self_longer)
+    {
+        item = PyIter_Next(iterator);
+        if(!item && PyErr_Occurred()) { goto error; }
+        other_longer = item != NULL;
+        Py_CLEAR(item);
+    }
+    Py_DECREF(iterator);
+    Py_RETURN_RICHCOMPARE(self_longer, other_longer, compare_op);
+
+error:
+    Py_XDECREF(own);
+    Py_XDECREF(item);
+    Py_DECREF(iterator);
+    return NULL;
+}
+
+// Mapping Methods
+
+static PyObject* UnrolledLinkedList_subscript(PyObject* op, PyObject* item)
+{
+    UnrolledLinkedList* self = (UnrolledLinkedList*)op;
+    if(PySlice_Check(item))
+    {
+        Py_ssize_t start, stop, step;
+        if(PySlice_Unpack(item, &start, &stop, &step) == -1) { return NULL; }
+        Py_ssize_t slice_length = PySlice_AdjustIndices(self->length, &start, &stop, step);
+        UnrolledLinkedList* slice = UnrolledLinkedList_empty_like(self); if(!slice) { return NULL; }
+        if(slice_length == 0) { return (PyObject*)slice; }
+        UnrolledPos pos = UnrolledLinkedList_locate(self, start);
+        DLLBlock* block = NULL;
+        for(Py_ssize_t i = 0; i < slice_length; i++)
+        {
+            if(!block || block->count == slice->block_size)
+            {
+                DLLBlock* new_block = UnrolledLinkedList_new_block(slice);
+                if(!new_block) { Py_DECREF(slice); return NULL; }
+                UnrolledLinkedList_link_block(slice, new_block, block);
+                block = new_block;
+            }
+            block->items[block->count++] = Py_NewRef(pos.block->items[pos.offset]);
+            slice->length += 1;
+            if(i + 1 < slice_length) { UnrolledPos_advance(&pos, step); }
+        }
+        return (PyObject*)slice;
+    }
+    else if(PyIndex_Check(item))
+    {
+        Py_ssize_t index = PyNumber_AsSsize_t(item, PyExc_IndexError); if(index == -1 && PyErr_Occurred()) { return NULL; }
+        if(UnrolledLinkedList_check_index(self, &index)) { return NULL; }
+        UnrolledPos pos = UnrolledLinkedList_locate(self, index);
+        return Py_NewRef(pos.block->items[pos.offset]);
+    }
+    PyErr_SetString(PyExc_TypeError, "Index must be an integer or slice");
+    return NULL;
+}
+
+// The sequence slot gets negative indexes with the length already added and would add it again
+static int UnrolledLinkedList_ass_item(PyObject*, Py_ssize_t, PyObject*);
+
+static int UnrolledLinkedList_ass_subscript(PyObject* op, PyObject* item, PyObject* value)
+{
+    UnrolledLinkedList* self = (UnrolledLinkedList*)op;
+    if(!PySlice_Check(item))
+    {
+        if(!PyIndex_Check(item))
+        {
+            PyErr_SetString(PyExc_TypeError, "Index must be an integer or slice");
+            return -1;
+        }
+        Py_ssize_t index = PyNumber_AsSsize_t(item, PyExc_IndexError); if(index == -1 && PyErr_Occurred()) { return -1; }
+        return UnrolledLinkedList_ass_item(op, index, value);
+    }
+    Py_ssize_t start, stop, step;
+    if(PySlice_Unpack(item, &start, &stop, &step) == -1) { return -1; }
+    Py_ssize_t slice_length = PySlice_AdjustIndices(self->length, &start, &stop, step);
+    // Walk negative steps forwards from the lowest index, the same items are affected
+    Py_ssize_t walk_start = step < 0 && slice_length > 0 ? start + (slice_length - 1) * step : start;
+    Py_ssize_t walk_step = step < 0 ? -step : step;
+    // Removed and replaced items are released once the chain is whole again, their destructors may use the list
+    PyObject** old_values = NULL;
+    if(slice_length > 0)
+    {
+        old_values = PyMem_Malloc(slice_length * sizeof(PyObject*));
+        if(!old_values) { PyErr_NoMemory(); return -1; }
+    }
+    if(!value)
+    {
+        UnrolledLinkedList_unlink_slice(self, walk_start, walk_step, slice_length, old_values);
+    }
+    else
+    {
+        // Copy first, value may be this list or depend on it
+        PyObject* items = PySequence_Fast(value, "can only assign an iterable");
+        if(!items) { PyMem_Free(old_values); return -1; }
+        int rslt = 0;
+        Py_ssize_t item_count;
+        DLL_BEGIN_CRITICAL_SECTION_SEQUENCE_FAST(value);
+        item_count = PySequence_Fast_GET_SIZE(items);
+        PyObject** item_array = PySequence_Fast_ITEMS(items);
+        if(step == 1)
+        {
+            // The new items and a block to split the chain with are allocated before anything is unlinked
+            DLLBlock* first = NULL; DLLBlock* last = NULL; DLLBlock* spare = NULL;
+            rslt = UnrolledLinkedList_chain_from_array(self, item_array, item_count, &first, &last);
+            if(!rslt && first)
+            {
+                spare = UnrolledLinkedList_new_block(self);
+                if(!spare) { UnrolledLinkedList_drop_chain(self, first); rslt = -1; }
+            }
+            if(!rslt)
+            {
+                UnrolledLinkedList_unlink_slice(self, start, 1, slice_length, old_values);
+                if(first) { UnrolledLinkedList_link_chain(self, first, last, item_count, start, spare); }
+            }
+        }
+        else if(item_count != slice_length)
+        {
+            PyErr_Format(PyExc_ValueError, "attempt to assign sequence of size %zd to extended slice of size %zd", item_count, slice_length);
+            rslt = -1;
+        }
+        else if(slice_length > 0)
+        {
+            UnrolledPos pos = UnrolledLinkedList_locate(self, start);
+            for(Py_ssize_t i = 0; i < slice_length; i++)
+            {
+                if(i > 0) { UnrolledPos_advance(&pos, step); }
+                old_values[i] = pos.block->items[pos.offset];
+                pos.block->items[pos.offset] = Py_NewRef(item_array[i]);
+            }
+        }
+        DLL_END_CRITICAL_SECTION_SEQUENCE_FAST();
+        Py_DECREF(items);
+        if(rslt) { PyMem_Free(old_values); return -1; }
+    }
+    for(Py_ssize_t i = 0; i < slice_length; i++) { Py_DECREF(old_values[i]); }
+    PyMem_Free(old_values);
+    return 0;
+}
+
+// Sequence Methods
+
+static Py_ssize_t UnrolledLinkedList_len(PyObject* op)
+{
+    return ((UnrolledLinkedList*)op)->length;
+}
+
+static PyObject* UnrolledLinkedList_item(PyObject* op, Py_ssize_t index)
+{
+    UnrolledLinkedList* self = (UnrolledLinkedList*)op;
+    if(UnrolledLinkedList_check_index(self, &index)) { return NULL; }
+    UnrolledPos pos = UnrolledLinkedList_locate(self, index);
+    return Py_NewRef(pos.block->items[pos.offset]);
+}
+
+static int UnrolledLinkedList_ass_item(PyObject* op, Py_ssize_t index, PyObject* value)
+{
+    UnrolledLinkedList* self = (UnrolledLinkedList*)op;
+    if(UnrolledLinkedList_check_index(self, &index)) { return -1; }
+    if(!value)
+    {
+        Py_DECREF(UnrolledLinkedList_take(self, index));
+        return 0;
+    }
+    UnrolledPos pos = UnrolledLinkedList_locate(self, index);
+    Py_SETREF(pos.block->items[pos.offset], Py_NewRef(value));
+    return 0;
+}
+
+static PyObject* UnrolledLinkedList_concat(PyObject* op, PyObject* other)
+{
+    PyObject* copy = UnrolledLinkedList_copy(op); if(!copy) { return NULL; }
+    if(UnrolledLinkedList_extend_iterable((UnrolledLinkedList*)copy, other, 1)) { Py_DECREF(copy); return NULL; }
+    return copy;
+}
+
+static PyObject* UnrolledLinkedList_inplace_concat(PyObject* op, PyObject* other)
+{
+    if(UnrolledLinkedList_extend_iterable((UnrolledLinkedList*)op, other, 1)) { return NULL; }
+    return Py_NewRef(op);
+}
+
+static int UnrolledLinkedList_contains(PyObject* op, PyObject* value)
+{
+    UnrolledLinkedList* self = (UnrolledLinkedList*)op;
+    Py_ssize_t index = UnrolledLinkedList_find(self, value, 0, self->length);
+    if(index == -2) { return -1; }
+    return index >= 0;
+}
+
+// __Methods__
+
+static PyObject* UnrolledLinkedList_str(PyObject* op)
+{
+    return DLL_write_repr(op, ((UnrolledLinkedList*)op)->length, NULL, NULL, -1);
+}
+
+static PyObject* UnrolledLinkedList_write_repr(PyObject* op, Py_ssize_t max_items)
+{
+    UnrolledLinkedList* self = (UnrolledLinkedList*)op;
+    char settings[48] = "";
+    if(self->block_size != UNROLLED_DEFAULT_BLOCK) { PyOS_snprintf(settings, sizeof(settings), ", block_size=%zd", self->block_size); }
+    return DLL_write_repr(op, self->length, "UnrolledLinkedList", settings, max_items);
+}
+
+static PyObject* UnrolledLinkedList_repr(PyObject* op)
+{
+    return UnrolledLinkedList_write_repr(op, -1);
+}
+
+static PyObject* UnrolledLinkedList_repr_limited(PyObject* op, PyObject* args, PyObject* kwds)
+{
+    Py_ssize_t max_items;
+    if(DLL_parse_max_items(args, kwds, &max_items)) { return NULL; }
+    return UnrolledLinkedList_write_repr(op, max_items);
+}
+
+// Iterator
+
+typedef struct
+{
+    PyObject_HEAD
+    UnrolledLinkedList* list;
+    DLLBlock* block;
+    Py_ssize_t offset;
+    Py_ssize_t remaining;
+    size_t mod_count;
+    int forward;
+} UnrolledLinkedListIterator;
+
+static PyObject* UnrolledLinkedListIterator_new(UnrolledLinkedList* list, int forward)
+{
+    UnrolledLinkedListIterator* self = PyObject_GC_New(UnrolledLinkedListIterator, &UnrolledLinkedListIteratorType);
+    if(!self) { return NULL; }
+    self->list = (UnrolledLinkedList*)Py_NewRef((PyObject*)list);
+    self->block = forward ? list->head : list->tail;
+    self->offset = forward || !list->tail ? 0 : list->tail->count - 1;
+    self->remaining = list->length;
+    self->mod_count = list->mod_count;
+    self->forward = forward;
+    PyObject_GC_Track(self);
+    return (PyObject*)self;
+}
+
+static void UnrolledLinkedListIterator_dealloc(PyObject* op)
+{
+    UnrolledLinkedListIterator* self = (UnrolledLinkedListIterator*)op;
+    PyObject_GC_UnTrack(op);
+    Py_XDECREF(self->list);
+    PyObject_GC_Del(self);
+}
+
+static int UnrolledLinkedListIterator_traverse(PyObject* op, visitproc visit, void* arg)
+{
+    Py_VISIT(((UnrolledLinkedListIterator*)op)->list);
+    return 0;
+}
+
+static int UnrolledLinkedListIterator_clear(PyObject* op)
+{
+    UnrolledLinkedListIterator* self = (UnrolledLinkedListIterator*)op;
+    self->block = NULL;
+    self->remaining = 0;
+    Py_CLEAR(self->list);
+    return 0;
+}
+
+static PyObject* UnrolledLinkedListIterator_next(PyObject* op)
+{
+    UnrolledLinkedListIterator* self = (UnrolledLinkedListIterator*)op;
+    if(!self->list) { return NULL; }
+    if(self->list->mod_count != self->mod_count)
+    {
+        self->block = NULL;
+        self->remaining = 0;
+        Py_CLEAR(self->list);
+        PyErr_SetString(PyExc_RuntimeError, "UnrolledLinkedList changed during iteration");
+        return NULL;
+    }
+    if(self->remaining == 0)
+    {
+        Py_CLEAR(self->list);
+        return NULL;
+    }
+    PyObject* item = self->block->items[self->offset];
+    self->remaining -= 1;
+    if(self->forward)
+    {
+        if(++self->offset == self->block->count) { self->block = self->block->next; self->offset = 0; }
+    }
+    else if(--self->offset < 0 && self->block->prev)
+    {
+        self->block = self->block->prev;
+        self->offset = self->block->count - 1;
+    }
+    return Py_NewRef(item);
+}
+
+static PyObject* UnrolledLinkedListIterator_length_hint(PyObject* op, PyObject* Py_UNUSED(dummy))
+{
+    UnrolledLinkedListIterator* self = (UnrolledLinkedListIterator*)op;
+    if(!self->list || self->list->mod_count != self->mod_count) { return PyLong_FromSsize_t(0); }
+    return PyLong_FromSsize_t(self->remaining);
+}
+
+static PyObject* UnrolledLinkedListIterator_next_unlocked(PyObject* op, PyObject* Py_UNUSED(dummy))
+{
+    return UnrolledLinkedListIterator_next(op);
+}
+
+static PyObject* UnrolledLinkedListIterator_next_locked(PyObject* op)
+{
+    PyObject** list = (PyObject**)&((UnrolledLinkedListIterator*)op)->list;
+    return DLLIterator_call_locked(op, list, UnrolledLinkedListIterator_next_unlocked);
+}
+
+static PyObject* UnrolledLinkedListIterator_length_hint_locked(PyObject* op, PyObject* Py_UNUSED(dummy))
+{
+    PyObject** list = (PyObject**)&((UnrolledLinkedListIterator*)op)->list;
+    return DLLIterator_call_locked(op, list, UnrolledLinkedListIterator_length_hint);
+}
+
+static PyObject* UnrolledLinkedList_iter(PyObject* op)
+{
+    return UnrolledLinkedListIterator_new((UnrolledLinkedList*)op, 1);
+}
+
+static PyObject* UnrolledLinkedList_reversed(PyObject* op, PyObject* Py_UNUSED(dummy))
+{
+    return UnrolledLinkedListIterator_new((UnrolledLinkedList*)op, 0);
+}
+
+static PyMethodDef UnrolledLinkedListIterator_methods[] = {
+    {"__length_hint__", (PyCFunction)UnrolledLinkedListIterator_length_hint_locked, METH_NOARGS,
+    "Private method returning an estimate of len(list(it))."},
+    {NULL, NULL, 0, NULL}
+};
+
+static PyTypeObject UnrolledLinkedListIteratorType =
+{
+    .ob_base = PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "py_doubly_linked_list.doubly_linked_list.UnrolledLinkedListIterator",
+    .tp_doc = PyDoc_STR("UnrolledLinkedList iterator"),
+    .tp_basicsize = sizeof(UnrolledLinkedListIterator),
+    .tp_itemsize = 0,
+    .tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC,
+    .tp_dealloc = (destructor)UnrolledLinkedListIterator_dealloc,
+    .tp_traverse = UnrolledLinkedListIterator_traverse,
+    .tp_clear = UnrolledLinkedListIterator_clear,
+    .tp_iter = PyObject_SelfIter,
+    .tp_iternext = UnrolledLinkedListIterator_next_locked,
+    .tp_methods = UnrolledLinkedListIterator_methods
+};
+
+// Locked entry points
+
+DLL_LOCKED(int, UnrolledLinkedList_init, (PyObject* op, PyObject* args, PyObject* kwds), (op, args, kwds))
+DLL_LOCKED_KWARGS(UnrolledLinkedList_append)
+DLL_LOCKED_UNARY(UnrolledLinkedList_clear_method)
+DLL_LOCKED_UNARY(UnrolledLinkedList_copy)
+DLL_LOCKED_KWARGS(UnrolledLinkedList_count)
+DLL_LOCKED_KWARGS(UnrolledLinkedList_extend)
+DLL_LOCKED_KWARGS(UnrolledLinkedList_index)
+DLL_LOCKED_KWARGS(UnrolledLinkedList_insert)
+DLL_LOCKED_KWARGS(UnrolledLinkedList_pop)
+DLL_LOCKED_KWARGS(UnrolledLinkedList_remove)
+DLL_LOCKED_UNARY(UnrolledLinkedList_reverse)
+DLL_LOCKED_KWARGS(UnrolledLinkedList_sort)
+DLL_LOCKED_NOARGS(UnrolledLinkedList_reversed)
+DLL_LOCKED_NOARGS(UnrolledLinkedList_sizeof)
+DLL_LOCKED_NOARGS(UnrolledLinkedList_reduce)
+DLL_LOCKED_UNARY(UnrolledLinkedList_iter)
+DLL_LOCKED_UNARY(UnrolledLinkedList_str)
+DLL_LOCKED_UNARY(UnrolledLinkedList_repr)
+DLL_LOCKED_KWARGS(UnrolledLinkedList_repr_limited)
+DLL_LOCKED(PyObject*, UnrolledLinkedList_rich_compare, (PyObject* op, PyObject* other, int compare_op), (op, other, compare_op))
+DLL_LOCKED(PyObject*, UnrolledLinkedList_get_block_size, (PyObject* op, void* closure), (op, closure))
+DLL_LOCKED_BINARY(UnrolledLinkedList_subscript)
+DLL_LOCKED(int, UnrolledLinkedList_ass_subscript, (PyObject* op, PyObject* item, PyObject* value), (op, item, value))
+DLL_LOCKED(Py_ssize_t, UnrolledLinkedList_len, (PyObject* op), (op))
+DLL_LOCKED(PyObject*, UnrolledLinkedList_item, (PyObject* op, Py_ssize_t index), (op, index))
+DLL_LOCKED(int, UnrolledLinkedList_ass_item, (PyObject* op, Py_ssize_t index, PyObject* value), (op, index, value))
+DLL_LOCKED_BINARY(UnrolledLinkedList_concat)
+DLL_LOCKED_BINARY(UnrolledLinkedList_inplace_concat)
+DLL_LOCKED(int, UnrolledLinkedList_contains, (PyObject* op, PyObject* value), (op, value))
+
+static PyMethodDef UnrolledLinkedList_methods[] = {
+    {"append", (PyCFunction)UnrolledLinkedList_append_locked, METH_VARARGS|METH_KEYWORDS,
+    "Append object to the end of the list. Set forward to false to append to the start."},
+    {"clear", (PyCFunction)UnrolledLinkedList_clear_method_locked, METH_NOARGS,
+    "Remove all items from the list."},
+    {"copy", (PyCFunction)UnrolledLinkedList_copy_locked, METH_NOARGS,
+    "Return a shallow copy of the list."},
+    {"count", (PyCFunction)UnrolledLinkedList_count_locked, METH_VARARGS|METH_KEYWORDS,
+    "Return number of occurrences of value in the list."},
+    {"extend", (PyCFunction)UnrolledLinkedList_extend_locked, METH_VARARGS|METH_KEYWORDS,
+    "Extend list by appending elements from the iterable. Set forward to false to extend from the start."},
+    {"index", (PyCFunction)UnrolledLinkedList_index_locked, METH_VARARGS|METH_KEYWORDS,
+    "Return first index of value.\nRaises ValueError if the value is not present."},
+    {"insert", (PyCFunction)UnrolledLinkedList_insert_locked, METH_VARARGS|METH_KEYWORDS,
+     "Insert object after index. Set forward to false to insert before index."},
+    {"pop", (PyCFunction)UnrolledLinkedList_pop_locked, METH_VARARGS|METH_KEYWORDS,
+    "Remove and return item at index (default last).\nRaises IndexError if list is empty or index is out of range."},
+    {"remove", (PyCFunction)UnrolledLinkedList_remove_locked, METH_VARARGS|METH_KEYWORDS,
+    "Remove first occurence of value between start and stop.\nRaises ValueError if the value is not present."},
+    {"repr_limited", (PyCFunction)UnrolledLinkedList_repr_limited_locked, METH_VARARGS|METH_KEYWORDS,
+    "Return the repr of the list with at most max_items items written out, followed by the number left out."},
+    {"reverse", (PyCFunction)UnrolledLinkedList_reverse_locked, METH_NOARGS,
+    "Reverse the order of the list."},
+    {"sort", (PyCFunction)UnrolledLinkedList_sort_locked, METH_VARARGS|METH_KEYWORDS,
+    "In-place sort in ascending order, equal objects are not swapped. Key can be applied to values and the list will be sorted based on the result of applying the key. Reverse will reverse the sort order."},
+    {"__reversed__", (PyCFunction)UnrolledLinkedList_reversed_locked, METH_NOARGS,
+    "Return a reverse iterator over the list."},
+    {"__reduce__", (PyCFunction)UnrolledLinkedList_reduce_locked, METH_NOARGS,
+    "Return state for pickle, the items are streamed from an iterator."},
+    {"__sizeof__", (PyCFunction)UnrolledLinkedList_sizeof_locked, METH_NOARGS,
+    "Return the size of the list in memory, in bytes, including its blocks."},
+    {NULL, NULL, 0, NULL}
+};
+
+static PyGetSetDef UnrolledLinkedList_getset[] = {
+    {"block_size", UnrolledLinkedList_get_block_size_locked, NULL, "Number of items each block can hold.", NULL},
+    {NULL}
+};
+
+static PyMappingMethods UnrolledLinkedList_map =
+{
+    .mp_subscript = UnrolledLinkedList_subscript_locked,
+    .mp_ass_subscript = UnrolledLinkedList_ass_subscript_locked
+};
+
+static PySequenceMethods UnrolledLinkedList_sequence =
+{
+    .sq_length = UnrolledLinkedList_len_locked,
+    .sq_item = UnrolledLinkedList_item_locked,
+    .sq_ass_item = UnrolledLinkedList_ass_item_locked,
+    .sq_concat = UnrolledLinkedList_concat_locked,
+    .sq_inplace_concat = UnrolledLinkedList_inplace_concat_locked,
+    .sq_contains = UnrolledLinkedList_contains_locked
+};
+
+// Type Definition
+
+static PyTypeObject UnrolledLinkedListType =
+{
+    .ob_base = PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "py_doubly_linked_list.doubly_linked_list.UnrolledLinkedList",
+    .tp_doc = PyDoc_STR("UnrolledLinkedList class, a DoublyLinkedList storing its items in blocks"),
+    .tp_basicsize = sizeof(UnrolledLinkedList),
+    .tp_itemsize = 0,
+    .tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC,
+    .tp_new = (newfunc)UnrolledLinkedList_new,
+    .tp_init = UnrolledLinkedList_init_locked,
+    .tp_dealloc = (destructor)UnrolledLinkedList_dealloc,
+    .tp_traverse = UnrolledLinkedList_traverse,
+    .tp_clear = UnrolledLinkedList_clear,
+    .tp_str = UnrolledLinkedList_str_locked,
+    .tp_repr = UnrolledLinkedList_repr_locked,
+    .tp_richcompare = UnrolledLinkedList_rich_compare_locked,
+    .tp_iter = UnrolledLinkedList_iter_locked,
+    .tp_methods = UnrolledLinkedList_methods,
+    .tp_getset = UnrolledLinkedList_getset,
+    .tp_as_sequence = &UnrolledLinkedList_sequence,
+    .tp_as_mapping = &UnrolledLinkedList_map
+};
+
+// - - - - - Typed lists - - - - - //
+
+// DoublyLinkedListI64 and DoublyLinkedListF64 keep raw 64 bit ints or doubles in unrolled blocks
+// instead of object pointers. Scans run over plain arrays in loops the compiler can vectorize and
+// the values can be exported through the buffer protocol. Both types share this implementation,
+// kind says which member of DLLValue the blocks hold.
+
+#define TYPED_DEFAULT_BLOCK 256
+#define TYPED_SCAN_CHUNK 64 // index counts matches over this many values before looking for the first one
+#define TYPED_EXTEND_BATCH 64 // Values extend converts before pushing them together
+#define TYPED_SUM_FLUSH ((Py_ssize_t)1 << 30) // Values summed before the partial int64 sums are folded into the total
+
+// Baseline x86-64 has no 64 bit integer compares in SSE2, so on glibc the scan kernels get an extra
+// AVX2 build that is picked at load time on CPUs that support it
+#if defined(__x86_64__) && defined(__GLIBC__) && defined(__has_attribute)
+    #if __has_attribute(target_clones)
+        #define DLL_SCAN_KERNEL __attribute__((target_clones("avx2", "default")))
+    #endif
+#endif
+#ifndef DLL_SCAN_KERNEL
+    #define DLL_SCAN_KERNEL
+#endif
+
+typedef enum { DLL_KIND_I64, DLL_KIND_F64 } DLLValueKind;
+
+typedef union
+{
+    int64_t i64;
+    double f64;
+} DLLValue;
+
+typedef struct DLLValueBlock
+{
+    struct DLLValueBlock* next;
+    struct DLLValueBlock* prev;
+    Py_ssize_t count;
+    DLLValue items[];
+} DLLValueBlock;
+
+typedef struct
+{
+    PyObject_HEAD
+    DLLValueBlock* head;
+    DLLValueBlock* tail;
+    DLLValueBlock* cursor; // Block of the last located position
+    Py_ssize_t cursor_start; // Position of the first value in the cursor block
+    Py_ssize_t length;
+    Py_ssize_t block_size;
+    Py_ssize_t block_count;
+    size_t mod_count;
+    DLLValueKind kind;
+    Py_ssize_t exports; // Buffers handed out, the list can't change while there are any
+    DLLValue* export_values; // Contiguous copy of the values the exported buffers point into
+} TypedLinkedList;
+
+// A position inside the block chain
+typedef struct
+{
+    DLLValueBlock* block;
+    Py_ssize_t offset;
+} TypedPos;
+
+static PyTypeObject DoublyLinkedListI64Type;
+static PyTypeObject DoublyLinkedListF64Type;
+static PyTypeObject TypedLinkedListIteratorType;
+
+static PyObject* TypedLinkedList_new(PyTypeObject*, PyObject*, PyObject*);
+static int TypedLinkedList_extend_iterable(TypedLinkedList*, PyObject*, int);
+
+#define TypedLinkedList_Check(op) (PyObject_TypeCheck((op), &DoublyLinkedListI64Type) || PyObject_TypeCheck((op), &DoublyLinkedListF64Type))
+
+// Value helpers
+
+static inline PyObject* TypedLinkedList_box(TypedLinkedList* self, DLLValue value)
+{
+    return self->kind == DLL_KIND_I64 ? PyLong_FromLongLong(value.i64) : PyFloat_FromDouble(value.f64);
+}
+
+// Converts object for storage, raising TypeError or OverflowError if it doesn't fit the list's type
+static int TypedLinkedList_unbox(TypedLinkedList* self, PyObject* object, DLLValue* value)
+{
+    if(self->kind == DLL_KIND_I64)
+    {
+        long long i = PyLong_AsLongLong(object);
+        if(i == -1 && PyErr_Occurred()) { return -1; }
+        value->i64 = i;
+    }
+    else
+    {
+        double f = PyFloat_AsDouble(object);
+        if(f == -1.0 && PyErr_Occurred()) { return -1; }
+        value->f64 = f;
+    }
+    return 0;
+}
+
+// Finds the stored value that compares equal to object, for count, index and remove. Returns 1 and
+// sets value, 0 if no value of the list's type can equal object, -1 if object has to be compared
+// with each boxed item instead or -2 on error.
+static int TypedLinkedList_match(TypedLinkedList* self, PyObject* object, DLLValue* value)
+{
+    if(self->kind == DLL_KIND_I64)
+    {
+        if(PyFloat_Check(object))
+        {
+            // Only whole floats in range can equal an int64
+            double f = PyFloat_AS_DOUBLE(object);
+            if(!(f >= -9223372036854775808.0 && f < 9223372036854775808.0) || f != floor(f)) { return 0; }
+            value->i64 = (int64_t)f;
+            return 1;
+        }
+        if(!PyIndex_Check(object)) { return -1; }
+        PyObject* index = PyNumber_Index(object); if(!index) { return -2; }
+        int overflow;
+        long long i = PyLong_AsLongLongAndOverflow(index, &overflow);
+        Py_DECREF(index);
+        if(i == -1 && PyErr_Occurred()) { return -2; }
+        if(overflow) { return 0; }
+        value->i64 = i;
+        return 1;
+    }
+    if(PyFloat_Check(object))
+    {
+        value->f64 = PyFloat_AS_DOUBLE(object);
+        return 1;
+    }
+    if(!PyIndex_Check(object)) { return -1; }
+    PyObject* index = PyNumber_Index(object); if(!index) { return -2; }
+    double f = PyLong_AsDouble(index);
+    if(f == -1.0 && PyErr_Occurred())
+    {
+        Py_DECREF(index);
+        if(!PyErr_ExceptionMatches(PyExc_OverflowError)) { return -2; }
+        PyErr_Clear();
+        return 0;
+    }
+    // Ints past 2**53 only equal the double they round to if the rounding was exact
+    PyObject* rounded = PyFloat_FromDouble(f);
+    int exact = rounded ? PyObject_RichCompareBool(index, rounded, Py_EQ) : -1;
+    Py_XDECREF(rounded);
+    Py_DECREF(index);
+    if(exact == -1) { return -2; }
+    value->f64 = f;
+    return exact;
+}
+
+// Scan kernels, plain loops over the values of one block that the compiler vectorizes
+
+DLL_SCAN_KERNEL static Py_ssize_t DLLValue_count(const DLLValue* items, Py_ssize_t n, DLLValue value, DLLValueKind kind)
+{
+    Py_ssize_t count = 0;
+    if(kind == DLL_KIND_I64)
+    {
+        const int64_t target = value.i64;
+        for(Py_ssize_t i = 0; i < n; i++) { count += items[i].i64 == target; }
+    }
+    else
+    {
+        const double target = value.f64;
+        for(Py_ssize_t i = 0; i < n; i++) { count += items[i].f64 == target; }
+    }
+    return count;
+}
+
+// Returns the offset of the first value equal to value, or -1
+static Py_ssize_t DLLValue_find(const DLLValue* items, Py_ssize_t n, DLLValue value, DLLValueKind kind)
+{
+    for(Py_ssize_t start = 0; start < n; start += TYPED_SCAN_CHUNK)
+    {
+        Py_ssize_t stop = n - start < TYPED_SCAN_CHUNK ? n : start + TYPED_SCAN_CHUNK;
+        if(!DLLValue_count(&items[start], stop - start, value, kind)) { continue; }
+        for(Py_ssize_t i = start; i < stop; i++)
+        {
+            if(kind == DLL_KIND_I64 ? items[i].i64 == value.i64 : items[i].f64 == value.f64) { return i; }
+        }
+    }
+    return -1;
+}
+
+// Adds the values to the high and low 32 bit halves of an exact int64 sum, neither can overflow
+// before TYPED_SUM_FLUSH values
+DLL_SCAN_KERNEL static void DLLValue_sum_i64(const DLLValue* items, Py_ssize_t n, int64_t* high, uint64_t* low)
+{
+    int64_t h = *high;
+    uint64_t l = *low;
+    for(Py_ssize_t i = 0; i < n; i++)
+    {
+        h += items[i].i64 >> 32;
+        l += (uint32_t)items[i].i64;
+    }
+    *high = h;
+    *low = l;
+}
+
+// Adds the values to four running sums, interleaved so the additions don't wait on each other
+DLL_SCAN_KERNEL static void DLLValue_sum_f64(const DLLValue* items, Py_ssize_t n, double* lanes)
+{
+    double a = lanes[0], b = lanes[1], c = lanes[2], d = lanes[3];
+    Py_ssize_t i = 0;
+    for(; i + 4 <= n; i += 4)
+    {
+        a += items[i].f64;
+        b += items[i+1].f64;
+        c += items[i+2].f64;
+        d += items[i+3].f64;
+    }
+    for(; i < n; i++) { a += items[i].f64; }
+    lanes[0] = a; lanes[1] = b; lanes[2] = c; lanes[3] = d;
+}
+
+// Updates extreme with the smallest, or largest, of the values. Like min and max a value only
+// replaces it when it compares smaller or larger, so NaNs are skipped unless they come first.
+DLL_SCAN_KERNEL static void DLLValue_extreme(const DLLValue* items, Py_ssize_t n, DLLValueKind kind, int largest, DLLValue* extreme)
+{
+    if(kind == DLL_KIND_I64)
+    {
+        int64_t e = extreme->i64;
+        if(largest) { for(Py_ssize_t i = 0; i < n; i++) { e = items[i].i64 > e ? items[i].i64 : e; } }
+        else { for(Py_ssize_t i = 0; i < n; i++) { e = items[i].i64 < e ? items[i].i64 : e; } }
+        extreme->i64 = e;
+        return;
+    }
+    // Doubles are compared in four interleaved lanes, the compiler won't reorder a float reduction itself
+    double a = extreme->f64, b = a, c = a, d = a;
+    Py_ssize_t i = 0;
+    if(largest)
+    {
+        for(; i + 4 <= n; i += 4)
+        {
+            a = items[i].f64 > a ? items[i].f64 : a;
+            b = items[i+1].f64 > b ? items[i+1].f64 : b;
+            c = items[i+2].f64 > c ? items[i+2].f64 : c;
+            d = items[i+3].f64 > d ? items[i+3].f64 : d;
+        }
+        for(; i < n; i++) { a = items[i].f64 > a ? items[i].f64 : a; }
+        a = b > a ? b : a; a = c > a ? c : a; a = d > a ? d : a;
+    }
+    else
+    {
+        for(; i + 4 <= n; i += 4)
+        {
+            a = items[i].f64 < a ? items[i].f64 : a;
+            b = items[i+1].f64 < b ? items[i+1].f64 : b;
+            c = items[i+2].f64 < c ? items[i+2].f64 : c;
+            d = items[i+3].f64 < d ? items[i+3].f64 : d;
+        }
+        for(; i < n; i++) { a = items[i].f64 < a ? items[i].f64 : a; }
+        a = b < a ? b : a; a = c < a ? c : a; a = d < a ? d : a;
+    }
+    extreme->f64 = a;
+}
+
+// Block helpers
+
+static DLLValueBlock* TypedLinkedList_new_block(TypedLinkedList* self)
+{
+    DLLValueBlock* block = PyMem_Malloc(sizeof(DLLValueBlock) + self->block_size * sizeof(DLLValue));
+    if(!block) { PyErr_NoMemory(); return NULL; }
+    block->next = NULL;
+    block->prev = NULL;
+    block->count = 0;
+    self->block_count += 1;
+    return block;
+}
+
+// Links block into the chain after prev, or at the head if prev is NULL
+static void TypedLinkedList_link_block(TypedLinkedList* self, DLLValueBlock* block, DLLValueBlock* prev)
+{
+    block->prev = prev;
+    block->next = prev ? prev->next : self->head;
+    if(block->next) { block->next->prev = block; } else { self->tail = block; }
+    if(prev) { prev->next = block; } else { self->head = block; }
+}
+
+static void TypedLinkedList_free_block(TypedLinkedList* self, DLLValueBlock* block)
+{
+    if(block->prev) { block->prev->next = block->next; } else { self->head = block->next; }
+    if(block->next) { block->next->prev = block->prev; } else { self->tail = block->prev; }
+    self->block_count -= 1;
+    PyMem_Free(block);
+}
+
+static void TypedLinkedList_dealloc_chain(DLLValueBlock* block)
+{
+    while(block)
+    {
+        DLLValueBlock* next = block->next;
+        PyMem_Free(block);
+        block = next;
+    }
+}
+
+static void TypedPos_advance(TypedPos* pos, Py_ssize_t steps)
+{
+    Py_ssize_t offset = pos->offset + steps;
+    while(offset >= pos->block->count && pos->block->next)
+    {
+        offset -= pos->block->count;
+        pos->block = pos->block->next;
+    }
+    while(offset < 0 && pos->block->prev)
+    {
+        pos->block = pos->block->prev;
+        offset += pos->block->count;
+    }
+    pos->offset = offset;
+}
+
+// Internal Methods
+
+// Values can't change while a buffer is exported, consumers read the copy taken on export
+static int TypedLinkedList_check_exports(TypedLinkedList* self)
+{
+    if(self->exports == 0) { return 0; }
+    PyErr_SetString(PyExc_BufferError, "Existing exports of data: list can not be changed");
+    return -1;
+}
+
+static int TypedLinkedList_check_index(TypedLinkedList* self, Py_ssize_t* index)
+{
+    if(*index < 0) { *index += self->length; }
+    if(*index < 0 || *index >= self->length)
+    {
+        PyErr_SetString(PyExc_IndexError, "Index out of bounds");
+        return -1;
+    }
+    return 0;
+}
+
+// Finds the block holding position (which must be in range) from the nearest of the cursor,
+// head and tail, and moves the cursor there
+static TypedPos TypedLinkedList_locate(TypedLinkedList* self, Py_ssize_t position)
+{
+    DLLValueBlock* block = self->head;
+    Py_ssize_t start = 0;
+    Py_ssize_t distance = position;
+    if(self->length - position < distance)
+    {
+        block = self->tail;
+        start = self->length - self->tail->count;
+        distance = self->length - position;
+    }
+    if(self->cursor)
+    {
+        Py_ssize_t cursor_distance = position - self->cursor_start;
+        if(cursor_distance < 0) { cursor_distance = -cursor_distance; }
+        if(cursor_distance < distance)
+        {
+            block = self->cursor;
+            start = self->cursor_start;
+        }
+    }
+    while(position < start)
+    {
+        block = block->prev;
+        start -= block->count;
+    }
+    while(position >= start + block->count)
+    {
+        start += block->count;
+        block = block->next;
+    }
+    self->cursor = block;
+    self->cursor_start = start;
+    TypedPos pos = {block, position - start};
+    return pos;
+}
+
+// Inserts value so that it ends up at position, 0 <= position <= length
+static int TypedLinkedList_insert_at(TypedLinkedList* self, Py_ssize_t position, DLLValue value)
+{
+    DLLValueBlock* block;
+    Py_ssize_t start, offset;
+    if(!self->head)
+    {
+        block = TypedLinkedList_new_block(self); if(!block) { return -1; }
+        TypedLinkedList_link_block(self, block, NULL);
+        start = 0;
+        offset = 0;
+    }
+    else if(position == self->length)
+    {
+        block = self->tail;
+        start = self->length - block->count;
+        offset = block->count;
+    }
+    else
+    {
+        TypedPos pos = TypedLinkedList_locate(self, position);
+        block = pos.block;
+        start = self->cursor_start;
+        offset = pos.offset;
+    }
+    if(block->count == self->block_size)
+    {
+        DLLValueBlock* new_block = TypedLinkedList_new_block(self); if(!new_block) { return -1; }
+        if(offset == block->count && !block->next)
+        {
+            // Appending to a full tail starts a new block
+            TypedLinkedList_link_block(self, new_block, block);
+            start += block->count;
+            block = new_block;
+            offset = 0;
+        }
+        else if(offset == 0 && !block->prev)
+        {
+            // Prepending to a full head starts a new block
+            TypedLinkedList_link_block(self, new_block, NULL);
+            block = new_block;
+        }
+        else
+        {
+            Py_ssize_t half = block->count / 2;
+            TypedLinkedList_link_block(self, new_block, block);
+            memcpy(new_block->items, &block->items[half], (block->count - half) * sizeof(DLLValue));
+            new_block->count = block->count - half;
+            block->count = half;
+            if(offset > half)
+            {
+                start += half;
+                offset -= half;
+                block = new_block;
+            }
+        }
+    }
+    memmove(&block->items[offset+1], &block->items[offset], (block->count - offset) * sizeof(DLLValue));
+    block->items[offset] = value;
+    block->count += 1;
+    self->length += 1;
+    self->mod_count += 1;
+    self->cursor = block;
+    self->cursor_start = start;
+    return 0;
+}
+
+// Appends n values at the end, filling the tail block before starting new ones
+static int TypedLinkedList_push_values(TypedLinkedList* self, const DLLValue* values, Py_ssize_t n)
+{
+    self->mod_count += 1;
+    while(n > 0)
+    {
+        DLLValueBlock* block = self->tail;
+        if(!block || block->count == self->block_size)
+        {
+            block = TypedLinkedList_new_block(self); if(!block) { return -1; }
+            TypedLinkedList_link_block(self, block, self->tail);
+        }
+        Py_ssize_t copied = self->block_size - block->count < n ? self->block_size - block->count : n;
+        memcpy(&block->items[block->count], values, copied * sizeof(DLLValue));
+        block->count += copied;
+        self->length += copied;
+        values += copied;
+        n -= copied;
+    }
+    return 0;
+}
+
+// Removes the value at position (which must be in range) and returns it
+static DLLValue TypedLinkedList_take(TypedLinkedList* self, Py_ssize_t position)
+{
+    TypedPos pos = TypedLinkedList_locate(self, position);
+    DLLValueBlock* block = pos.block;
+    Py_ssize_t start = self->cursor_start;
+    DLLValue value = block->items[pos.offset];
+    memmove(&block->items[pos.offset], &block->items[pos.offset+1], (block->count - pos.offset - 1) * sizeof(DLLValue));
+    block->count -= 1;
+    self->length -= 1;
+    self->mod_count += 1;
+    if(block->count == 0)
+    {
+        DLLValueBlock* next = block->next;
+        DLLValueBlock* prev = block->prev;
+        TypedLinkedList_free_block(self, block);
+        if(next) { block = next; }
+        else if(prev) { block = prev; start -= prev->count; }
+        else { block = NULL; start = 0; }
+    }
+    else if(block->count <= self->block_size / 4)
+    {
+        // Merge sparse blocks so the chain stays dense
+        if(block->next && block->count + block->next->count <= self->block_size)
+        {
+            DLLValueBlock* next = block->next;
+            memcpy(&block->items[block->count], next->items, next->count * sizeof(DLLValue));
+            block->count += next->count;
+            TypedLinkedList_free_block(self, next);
+        }
+        else if(block->prev && block->count + block->prev->count <= self->block_size)
+        {
+            DLLValueBlock* prev = block->prev;
+            memcpy(&prev->items[prev->count], block->items, block->count * sizeof(DLLValue));
+            start -= prev->count;
+            prev->count += block->count;
+            TypedLinkedList_free_block(self, block);
+            block = prev;
+        }
+    }
+    self->cursor = block;
+    self->cursor_start = start;
+    return value;
+}
+
+// Moves the values of the block after block into it when both fit in one
+static void TypedLinkedList_merge_next(TypedLinkedList* self, DLLValueBlock* block)
+{
+    if(!block || !block->next || block->count + block->next->count > self->block_size) { return; }
+    DLLValueBlock* next = block->next;
+    memcpy(&block->items[block->count], next->items, next->count * sizeof(DLLValue));
+    block->count += next->count;
+    TypedLinkedList_free_block(self, next);
+}
+
+// Removes count values, step apart from start on (step > 0). Each block touched is compacted in place
+// once and merged with its neighbours when they fit in one block.
+static void TypedLinkedList_unlink_slice(TypedLinkedList* self, Py_ssize_t start, Py_ssize_t step, Py_ssize_t count)
+{
+    if(count == 0) { return; }
+    TypedPos pos = TypedLinkedList_locate(self, start);
+    DLLValueBlock* block = pos.block;
+    Py_ssize_t offset = pos.offset; // Offset of the next value to remove, relative to block
+    Py_ssize_t taken = 0;
+    while(taken < count)
+    {
+        Py_ssize_t kept = offset < block->count ? offset : block->count;
+        for(Py_ssize_t i = kept; i < block->count; i++)
+        {
+            if(taken < count && i == offset) { taken += 1; offset += step; }
+            else { block->items[kept++] = block->items[i]; }
+        }
+        offset -= block->count;
+        block->count = kept;
+        DLLValueBlock* next = block->next;
+        if(kept == 0) { TypedLinkedList_free_block(self, block); }
+        else if(block->prev && block->prev->count + kept <= self->block_size) { TypedLinkedList_merge_next(self, block->prev); }
+        block = next;
+    }
+    if(block) { TypedLinkedList_merge_next(self, block->prev); }
+    self->length -= count;
+    self->mod_count += 1;
+    self->cursor = NULL;
+}
+
+// Frees a detached chain made for this list
+static void TypedLinkedList_drop_chain(TypedLinkedList* self, DLLValueBlock* first)
+{
+    for(DLLValueBlock* block = first; block; block = block->next) { self->block_count -= 1; }
+    TypedLinkedList_dealloc_chain(first);
+}
+
+// Copies count values into a detached chain of full blocks
+static int TypedLinkedList_chain_from_array(TypedLinkedList* self, const DLLValue* values, Py_ssize_t count, DLLValueBlock** first, DLLValueBlock** last)
+{
+    *first = NULL; *last = NULL;
+    while(count > 0)
+    {
+        DLLValueBlock* block = TypedLinkedList_new_block(self);
+        if(!block) { TypedLinkedList_drop_chain(self, *first); return -1; }
+        block->prev = *last;
+        if(*last) { (*last)->next = block; } else { *first = block; }
+        *last = block;
+        Py_ssize_t copied = self->block_size < count ? self->block_size : count;
+        memcpy(block->items, values, copied * sizeof(DLLValue));
+        block->count = copied;
+        values += copied;
+        count -= copied;
+    }
+    return 0;
+}
+
+// Links a detached chain holding count values in at position, 0 <= position <= length. Spare is an
+// allocated block used to split the block at position when it lands inside one, it is freed if unused.
+static void TypedLinkedList_link_chain(TypedLinkedList* self, DLLValueBlock* first, DLLValueBlock* last, Py_ssize_t count, Py_ssize_t position, DLLValueBlock* spare)
+{
+    DLLValueBlock* prev = NULL;
+    if(position == self->length) { prev = self->tail; }
+    else if(position > 0)
+    {
+        TypedPos pos = TypedLinkedList_locate(self, position);
+        prev = pos.block;
+        if(pos.offset == 0) { prev = prev->prev; }
+        else
+        {
+            memcpy(spare->items, &prev->items[pos.offset], (prev->count - pos.offset) * sizeof(DLLValue));
+            spare->count = prev->count - pos.offset;
+            prev->count = pos.offset;
+            TypedLinkedList_link_block(self, spare, prev);
+            spare = NULL;
+        }
+    }
+    if(spare) { PyMem_Free(spare); self->block_count -= 1; }
+    first->prev = prev;
+    last->next = prev ? prev->next : self->head;
+    if(last->next) { last->next->prev = last; } else { self->tail = last; }
+    if(prev) { prev->next = first; } else { self->head = first; }
+    TypedLinkedList_merge_next(self, last);
+    TypedLinkedList_merge_next(self, prev);
+    self->length += count;
+    self->mod_count += 1;
+    self->cursor = NULL;
+}
+
+// Copies every value into values, which must have room for length of them
+static void TypedLinkedList_gather(TypedLinkedList* self, DLLValue* values)
+{
+    for(DLLValueBlock* block = self->head; block; block = block->next)
+    {
+        memcpy(values, block->items, block->count * sizeof(DLLValue));
+        values += block->count;
+    }
+}
+
+// Writes values back over the list in order, the list must hold length of them
+static void TypedLinkedList_scatter(TypedLinkedList* self, const DLLValue* values)
+{
+    for(DLLValueBlock* block = self->head; block; block = block->next)
+    {
+        memcpy(block->items, values, block->count * sizeof(DLLValue));
+        values += block->count;
+    }
+}
+
+// Returns 1 if the buffer holds values the list can copy in directly
+static int TypedLinkedList_buffer_matches(TypedLinkedList* self, Py_buffer* view)
+{
+    if(view->itemsize != sizeof(DLLValue) || !view->format) { return 0; }
+    const char* format = view->format;
+    if(*format == '@' || *format == '=') { format++; }
+    if(self->kind == DLL_KIND_I64) { return strcmp(format, "q") == 0 || strcmp(format, "l") == 0; }
+    return strcmp(format, "d") == 0;
+}
+
+// Converts the items of value into a new array of raw values, a typed list of the same type is copied as it is
+static DLLValue* TypedLinkedList_unbox_all(TypedLinkedList* self, PyObject* value, Py_ssize_t* count)
+{
+    DLLValue* values;
+    if(TypedLinkedList_Check(value) && ((TypedLinkedList*)value)->kind == self->kind)
+    {
+        TypedLinkedList* other = (TypedLinkedList*)value;
+        *count = other->length;
+        values = PyMem_Malloc((*count ? *count : 1) * sizeof(DLLValue));
+        if(!values) { PyErr_NoMemory(); return NULL; }
+        TypedLinkedList_gather(other, values);
+        return values;
+    }
+    PyObject* items = PySequence_Fast(value, "can only assign an iterable"); if(!items) { return NULL; }
+    int rslt = 0;
+    DLL_BEGIN_CRITICAL_SECTION_SEQUENCE_FAST(value);
+    *count = PySequence_Fast_GET_SIZE(items);
+    values = PyMem_Malloc((*count ? *count : 1) * sizeof(DLLValue));
+    if(!values) { PyErr_NoMemory(); rslt = -1; }
+    for(Py_ssize_t i = 0; i < *count && !rslt; i++) { rslt = TypedLinkedList_unbox(self, PySequence_Fast_GET_ITEM(items, i), &values[i]); }
+    DLL_END_CRITICAL_SECTION_SEQUENCE_FAST();
+    Py_DECREF(items);
+    if(rslt) { PyMem_Free(values); return NULL; }
+    return values;
+}
+
+static int TypedLinkedList_extend_iterable(TypedLinkedList* self, PyObject* iterable, int forward)
+{
+    if(TypedLinkedList_Check(iterable) && ((TypedLinkedList*)iterable)->kind == self->kind)
+    {
+        // Values of the same type are copied block by block, self is copied first so it doesn't grow under the loop
+        TypedLinkedList* other = (TypedLinkedList*)iterable;
+        Py_ssize_t count = other->length;
+        DLLValue* values = PyMem_Malloc((count ? count : 1) * sizeof(DLLValue));
+        if(!values) { PyErr_NoMemory(); return -1; }
+        TypedLinkedList_gather(other, values);
+        int rslt = 0;
+        if(forward) { rslt = TypedLinkedList_push_values(self, values, count); }
+        else
+        {
+            for(Py_ssize_t i = 0; i < count && !rslt; i++) { rslt = TypedLinkedList_insert_at(self, 0, values[i]); }
+        }
+        PyMem_Free(values);
+        return rslt;
+    }
+    if(forward && !TypedLinkedList_Check(iterable) && PyObject_CheckBuffer(iterable))
+    {
+        // Arrays of the same type, like array('q') or a numpy float64 array, are copied in one go
+        Py_buffer view;
+        if(PyObject_GetBuffer(iterable, &view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) == 0)
+        {
+            if(TypedLinkedList_buffer_matches(self, &view))
+            {
+                int rslt = TypedLinkedList_push_values(self, (DLLValue*)view.buf, view.len / view.itemsize);
+                PyBuffer_Release(&view);
+                return rslt;
+            }
+            PyBuffer_Release(&view);
+        }
+        else { PyErr_Clear(); }
+    }
+    PyObject* iterator = PyObject_GetIter(iterable); if(!iterator) { return -1; }
+    // Values are converted into a small batch and pushed together
+    DLLValue batch[TYPED_EXTEND_BATCH];
+    Py_ssize_t batched = 0;
+    PyObject* item;
+    while((item = PyIter_Next(iterator)) != NULL)
+    {
+        DLLValue value;
+        int rslt = TypedLinkedList_unbox(self, item, &value);
+        Py_DECREF(item);
+        if(rslt) { break; }
+        if(!forward)
+        {
+            if(TypedLinkedList_insert_at(self, 0, value)) { break; }
+            continue;
+        }
+        batch[batched++] = value;
+        if(batched == TYPED_EXTEND_BATCH)
+        {
+            if(TypedLinkedList_push_values(self, batch, batched)) { batched = 0; break; }
+            batched = 0;
+        }
+    }
+    Py_DECREF(iterator);
+    // Values converted before an error are kept, like list.extend does
+    if(batched && TypedLinkedList_push_values(self, batch, batched)) { return -1; }
+    if(PyErr_Occurred()) { return -1; }
+    return 0;
+}
+
+// Returns the position of the first value equal to object in [start, stop), -1 if there is none or -2 on error
+static Py_ssize_t TypedLinkedList_find(TypedLinkedList* self, PyObject* object, Py_ssize_t start, Py_ssize_t stop)
+{
+    if(start < 0) { start += self->length; if(start < 0) { start = 0; } }
+    if(stop < 0) { stop += self->length; if(stop < 0) { stop = 0; } }
+    if(stop > self->length) { stop = self->length; }
+    if(start >= stop) { return -1; }
+    DLLValue value;
+    int match = TypedLinkedList_match(self, object, &value);
+    if(match == -2) { return -2; }
+    if(match == 0) { return -1; }
+    TypedPos pos = TypedLinkedList_locate(self, start);
+    DLLValueBlock* block = pos.block;
+    Py_ssize_t offset = pos.offset;
+    Py_ssize_t position = start;
+    while(block && position < stop)
+    {
+        Py_ssize_t n = block->count - offset < stop - position ? block->count - offset : stop - position;
+        if(match == 1)
+        {
+            Py_ssize_t found = DLLValue_find(&block->items[offset], n, value, self->kind);
+            if(found >= 0) { return position + found; }
+        }
+        else
+        {
+            for(Py_ssize_t i = 0; i < n; i++)
+            {
+                PyObject* item = TypedLinkedList_box(self, block->items[offset + i]); if(!item) { return -2; }
+                int rslt = PyObject_RichCompareBool(item, object, Py_EQ);
+                Py_DECREF(item);
+                if(rslt == -1) { return -2; }
+                if(rslt) { return position + i; }
+            }
+        }
+        position += n;
+        block = block->next;
+        offset = 0;
+    }
+    return -1;
+}
+
+// Initialization and deallocation
+
+static void TypedLinkedList_dealloc(PyObject* op)
+{
+    TypedLinkedList* self = (TypedLinkedList*)op;
+    TypedLinkedList_dealloc_chain(self->head);
+    PyMem_Free(self->export_values);
+    Py_TYPE(self)->tp_free(self);
+}
+
+static PyObject* TypedLinkedList_new(PyTypeObject* type, PyObject* args, PyObject* kwds)
+{
+    TypedLinkedList* self = (TypedLinkedList*)type->tp_alloc(type, 0);
+    if(self)
+    {
+        self->head = NULL;
+        self->tail = NULL;
+        self->cursor = NULL;
+        self->cursor_start = 0;
+        self->length = 0;
+        self->block_size = TYPED_DEFAULT_BLOCK;
+        self->block_count = 0;
+        self->mod_count = 0;
+        self->kind = PyType_IsSubtype(type, &DoublyLinkedListF64Type) ? DLL_KIND_F64 : DLL_KIND_I64;
+        self->exports = 0;
+        self->export_values = NULL;
+    }
+    return (PyObject*)self;
+}
+
+static int TypedLinkedList_init(PyObject* op, PyObject* args, PyObject* kwds)
+{
+    TypedLinkedList* self = (TypedLinkedList*)op;
+    static char* kwlist[] = {"", "block_size", NULL};
+    PyObject* iterable = NULL;
+    Py_ssize_t block_size = TYPED_DEFAULT_BLOCK;
+    if(!PyArg_ParseTupleAndKeywords(args, kwds, "|O$n", kwlist, &iterable, &block_size)) { return -1; }
+    if(block_size < UNROLLED_MIN_BLOCK || block_size > UNROLLED_MAX_BLOCK)
+    {
+        PyErr_Format(PyExc_ValueError, "block_size must be between %d and %d", UNROLLED_MIN_BLOCK, UNROLLED_MAX_BLOCK);
+        return -1;
+    }
+    if(self->head && block_size != self->block_size)
+    {
+        PyErr_SetString(PyExc_ValueError, "block_size can not be changed once the list has items");
+        return -1;
+    }
+    if(TypedLinkedList_check_exports(self)) { return -1; }
+    self->block_size = block_size;
+    if(iterable && TypedLinkedList_extend_iterable(self, iterable, 1)) { return -1; }
+    return 0;
+}
+
+// Methods
+
+static PyObject* TypedLinkedList_append(PyObject* op, PyObject* args, PyObject* kwds)
+{
+    TypedLinkedList* self = (TypedLinkedList*)op;
+    static char* kwlist[] = {"object", "forward", NULL};
+    PyObject* object;
+    int forward = 1;
+    DLLValue value;
+    if(!PyArg_ParseTupleAndKeywords(args, kwds, "O|i", kwlist, &object, &forward)) { return NULL; }
+    if(TypedLinkedList_check_exports(self) || TypedLinkedList_unbox(self, object, &value)) { return NULL; }
+    if(TypedLinkedList_insert_at(self, forward ? self->length : 0, value)) { return NULL; }
+    return Py_NewRef(Py_None);
+}
+
+static PyObject* TypedLinkedList_insert(PyObject* op, PyObject* args, PyObject* kwds)
+{
+    TypedLinkedList* self = (TypedLinkedList*)op;
+    static char* kwlist[] = {"object", "index", "forward", NULL};
+    PyObject* object;
+    Py_ssize_t index;
+    int forward = 1;
+    DLLValue value;
+    if(!PyArg_ParseTupleAndKeywords(args, kwds, "On|i", kwlist, &object, &index, &forward)) { return NULL; }
+    if(TypedLinkedList_check_exports(self) || TypedLinkedList_unbox(self, object, &value)) { return NULL; }
+    if(TypedLinkedList_check_index(self, &index)) { return NULL; }
+    if(TypedLinkedList_insert_at(self, forward ? index + 1 : index, value)) { return NULL; }
+    return Py_NewRef(Py_None);
+}
+
+static PyObject* TypedLinkedList_pop(PyObject* op, PyObject* args, PyObject* kwds)
+{
+    TypedLinkedList* self = (TypedLinkedList*)op;
+    static char* kwlist[] = {"index", NULL};
+    Py_ssize_t index = -1;
+    if(!PyArg_ParseTupleAndKeywords(args, kwds, "|n", kwlist, &index)) { return NULL; }
+    if(TypedLinkedList_check_exports(self) || TypedLinkedList_check_index(self, &index)) { return NULL; }
+    return TypedLinkedList_box(self, TypedLinkedList_take(self, index));
+}
+
+static PyObject* TypedLinkedList_index(PyObject* op, PyObject* args, PyObject* kwds)
+{
+    TypedLinkedList* self = (TypedLinkedList*)op;
+    static char* kwlist[] = {"value", "start", "stop", NULL};
+    PyObject* value; Py_ssize_t start = 0; Py_ssize_t stop = PY_SSIZE_T_MAX;
+    if(!PyArg_ParseTupleAndKeywords(args, kwds, "O|nn", kwlist, &value, &start, &stop)) { return NULL; }
+    Py_ssize_t index = TypedLinkedList_find(self, value, start, stop);
+    if(index == -2) { return NULL; }
+    if(index == -1) { PyErr_Format(PyExc_ValueError, "%R is not in list", value); return NULL; }
+    return PyLong_FromSsize_t(index);
+}
+
+static PyObject* TypedLinkedList_remove(PyObject* op, PyObject* args, PyObject* kwds)
+{
+    TypedLinkedList* self = (TypedLinkedList*)op;
+    static char* kwlist[] = {"value", "start", "stop", NULL};
+    PyObject* value; Py_ssize_t start = 0; Py_ssize_t stop = PY_SSIZE_T_MAX;
+    if(!PyArg_ParseTupleAndKeywords(args, kwds, "O|nn", kwlist, &value, &start, &stop)) { return NULL; }
+    if(TypedLinkedList_check_exports(self)) { return NULL; }
+    Py_ssize_t index = TypedLinkedList_find(self, value, start, stop);
+    if(index == -2) { return NULL; }
+    if(index == -1) { PyErr_Format(PyExc_ValueError, "%R is not in list", value); return NULL; }
+    TypedLinkedList_take(self, index);
+    return Py_NewRef(Py_None);
+}
+
+static PyObject* TypedLinkedList_count(PyObject* op, PyObject* args, PyObject* kwds)
+{
+    TypedLinkedList* self = (TypedLinkedList*)op;
+    static char* kwlist[] = {"value", NULL};
+    PyObject* object;
+    if(!PyArg_ParseTupleAndKeywords(args, kwds, "O", kwlist, &object)) { return NULL; }
+    DLLValue value;
+    int match = TypedLinkedList_match(self, object, &value);
+    if(match == -2) { return NULL; }
+    Py_ssize_t count = 0;
+    for(DLLValueBlock* block = self->head; block && match; block = block->next)
+    {
+        if(match == 1)
+        {
+            count += DLLValue_count(block->items, block->count, value, self->kind);
+            continue;
+        }
+        for(Py_ssize_t i = 0; i < block->count; i++)
+        {
+            PyObject* item = TypedLinkedList_box(self, block->items[i]); if(!item) { return NULL; }
+            int rslt = PyObject_RichCompareBool(item, object, Py_EQ);
+            Py_DECREF(item);
+            if(rslt == -1) { return NULL; }
+            count += rslt;
+        }
+    }
+    return PyLong_FromSsize_t(count);
+}
+
+// Folds the partial int64 sums into total, replacing it
+static int TypedLinkedList_fold_sum(PyObject** total, int64_t high, uint64_t low)
+{
+    PyObject* part;
+    if(high >= -((int64_t)1 << 30) && high < ((int64_t)1 << 30) && low < ((uint64_t)1 << 62))
+    {
+        // high * 2**32 + low still fits an int64
+        part = PyLong_FromLongLong(high * ((int64_t)1 << 32) + (int64_t)low);
+    }
+    else
+    {
+        PyObject* high_part = PyLong_FromLongLong(high);
+        PyObject* shift = PyLong_FromLong(32);
+        PyObject* shifted = high_part && shift ? PyNumber_Lshift(high_part, shift) : NULL;
+        PyObject* low_part = PyLong_FromUnsignedLongLong(low);
+        part = shifted && low_part ? PyNumber_Add(shifted, low_part) : NULL;
+        Py_XDECREF(high_part); Py_XDECREF(shift); Py_XDECREF(shifted); Py_XDECREF(low_part);
+    }
+    if(!part) { return -1; }
+    PyObject* sum = PyNumber_Add(*total, part);
+    Py_DECREF(part);
+    if(!sum) { return -1; }
+    Py_SETREF(*total, sum);
+    return 0;
+}
+
+static PyObject* TypedLinkedList_sum(PyObject* op, PyObject* Py_UNUSED(dummy))
+{
+    TypedLinkedList* self = (TypedLinkedList*)op;
+    if(self->kind == DLL_KIND_F64)
+    {
+        double lanes[4] = {0.0, 0.0, 0.0, 0.0};
+        for(DLLValueBlock* block = self->head; block; block = block->next) { DLLValue_sum_f64(block->items, block->count, lanes); }
+        return PyFloat_FromDouble((lanes[0] + lanes[1]) + (lanes[2] + lanes[3]));
+    }
+    PyObject* total = PyLong_FromLong(0); if(!total) { return NULL; }
+    int64_t high = 0;
+    uint64_t low = 0;
+    Py_ssize_t pending = 0;
+    for(DLLValueBlock* block = self->head; block; block = block->next)
+    {
+        DLLValue_sum_i64(block->items, block->count, &high, &low);
+        pending += block->count;
+        if(pending >= TYPED_SUM_FLUSH || !block->next)
+        {
+            if(TypedLinkedList_fold_sum(&total, high, low)) { Py_DECREF(total); return NULL; }
+            high = 0; low = 0; pending = 0;
+        }
+    }
+    return total;
+}
+
+static PyObject* TypedLinkedList_extreme(TypedLinkedList* self, int largest)
+{
+    if(!self->head)
+    {
+        PyErr_Format(PyExc_ValueError, "%s() arg is an empty sequence", largest ? "max" : "min");
+        return NULL;
+    }
+    DLLValue extreme = self->head->items[0];
+    for(DLLValueBlock* block = self->head; block; block = block->next)
+    {
+        DLLValue_extreme(block->items, block->count, self->kind, largest, &extreme);
+    }
+    return TypedLinkedList_box(self, extreme);
+}
+
+static PyObject* TypedLinkedList_min(PyObject* op, PyObject* Py_UNUSED(dummy))
+{
+    return TypedLinkedList_extreme((TypedLinkedList*)op, 0);
+}
+
+static PyObject* TypedLinkedList_max(PyObject* op, PyObject* Py_UNUSED(dummy))
+{
+    return TypedLinkedList_extreme((TypedLinkedList*)op, 1);
+}
+
+static PyObject* TypedLinkedList_extend(PyObject* op, PyObject* args, PyObject* kwds)
+{
+    TypedLinkedList* self = (TypedLinkedList*)op;
+    static char* kwlist[] = {"iterable", "forward", NULL};
+    PyObject* iterable;
+    int forward = 1;
+    if(!PyArg_ParseTupleAndKeywords(args, kwds, "O|i", kwlist, &iterable, &forward)) { return NULL; }
+    if(TypedLinkedList_check_exports(self)) { return NULL; }
+    if(TypedLinkedList_extend_iterable(self, iterable, forward)) { return NULL; }
+    return Py_NewRef(Py_None);
+}
+
+static TypedLinkedList* TypedLinkedList_empty_like(TypedLinkedList* self)
+{
+    TypedLinkedList* list = (TypedLinkedList*)TypedLinkedList_new(Py_TYPE(self), NULL, NULL);
+    if(list) { list->block_size = self->block_size; }
+    return list;
+}
+
+static PyObject* TypedLinkedList_copy(PyObject* op)
+{
+    TypedLinkedList* self = (TypedLinkedList*)op;
+    TypedLinkedList* copy = TypedLinkedList_empty_like(self); if(!copy) { return NULL; }
+    DLLValueBlock* prev = NULL;
+    for(DLLValueBlock* block = self->head; block; block = block->next)
+    {
+        DLLValueBlock* new_block = TypedLinkedList_new_block(copy);
+        if(!new_block) { Py_DECREF(copy); return NULL; }
+        memcpy(new_block->items, block->items, block->count * sizeof(DLLValue));
+        new_block->count = block->count;
+        TypedLinkedList_link_block(copy, new_block, prev);
+        copy->length += block->count;
+        prev = new_block;
+    }
+    return (PyObject*)copy;
+}
+
+static PyObject* TypedLinkedList_reverse(PyObject* op)
+{
+    TypedLinkedList* self = (TypedLinkedList*)op;
+    if(TypedLinkedList_check_exports(self)) { return NULL; }
+    DLLValueBlock* block = self->head;
+    while(block)
+    {
+        DLLValueBlock* next = block->next;
+        for(Py_ssize_t i = 0, j = block->count - 1; i < j; i++, j--)
+        {
+            DLLValue temp = block->items[i];
+            block->items[i] = block->items[j];
+            block->items[j] = temp;
+        }
+        block->next = block->prev;
+        block->prev = next;
+        block = next;
+    }
+    block = self->head;
+    self->head = self->tail;
+    self->tail = block;
+    self->cursor = NULL;
+    self->mod_count += 1;
+    return Py_NewRef(Py_None);
+}
+
+static PyObject* TypedLinkedList_clear_method(PyObject* op)
+{
+    TypedLinkedList* self = (TypedLinkedList*)op;
+    if(TypedLinkedList_check_exports(self)) { return NULL; }
+    DLLValueBlock* head = self->head;
+    self->head = NULL; self->tail = NULL; self->cursor = NULL;
+    self->length = 0; self->cursor_start = 0; self->block_count = 0;
+    self->mod_count += 1;
+    TypedLinkedList_dealloc_chain(head);
+    return Py_NewRef(Py_None);
+}
+
+// Returns 1 if a sorts strictly before b
+static inline int DLLValue_before(DLLValue a, DLLValue b, DLLValueKind kind, int reverse)
+{
+    if(kind == DLL_KIND_I64) { return reverse ? b.i64 < a.i64 : a.i64 < b.i64; }
+    return reverse ? b.f64 < a.f64 : a.f64 < b.f64;
+}
+
+// Stable bottom up merge sort of n values, using scratch as the second buffer. Returns the buffer
+// the sorted values ended up in.
+static DLLValue* DLLValue_merge_sort(DLLValue* values, DLLValue* scratch, Py_ssize_t n, DLLValueKind kind, int reverse)
+{
+    for(Py_ssize_t width = 1; width < n; width *= 2)
+    {
+        for(Py_ssize_t left = 0; left < n; left += 2 * width)
+        {
+            Py_ssize_t middle = left + width < n ? left + width : n;
+            Py_ssize_t right = middle + width < n ? middle + width : n;
+            Py_ssize_t i = left, j = middle, k = left;
+            // Taking from the right run only when it is strictly before keeps equal values in order
+            while(i < middle && j < right) { scratch[k++] = DLLValue_before(values[j], values[i], kind, reverse) ? values[j++] : values[i++]; }
+            while(i < middle) { scratch[k++] = values[i++]; }
+            while(j < right) { scratch[k++] = values[j++]; }
+        }
+        DLLValue* temp = values;
+        values = scratch;
+        scratch = temp;
+    }
+    return values;
+}
+
+// Sorts the raw values directly, with a key the values are boxed and sorted with list.sort
+static PyObject* TypedLinkedList_sort(PyObject* op, PyObject* args, PyObject* kwds)
+{
+    TypedLinkedList* self = (TypedLinkedList*)op;
+    char* kwlist[] = {"key", "reverse", NULL};
+    PyObject* key = NULL; int reverse = 0;
+    if(!PyArg_ParseTupleAndKeywords(args, kwds, "|Oi", kwlist, &key, &reverse)) { return NULL; }
+    if(Py_IsNone(key)) { key = NULL; }
+    if(key && !PyCallable_Check(key)) { PyErr_SetString(PyExc_TypeError, "Key must be a callable"); return NULL; }
+    if(TypedLinkedList_check_exports(self)) { return NULL; }
+    if(self->length < 2) { return Py_NewRef(Py_None); }
+    if(!key)
+    {
+        DLLValue* values = PyMem_Malloc(2 * self->length * sizeof(DLLValue));
+        if(!values) { return PyErr_NoMemory(); }
+        TypedLinkedList_gather(self, values);
+        TypedLinkedList_scatter(self, DLLValue_merge_sort(values, values + self->length, self->length, self->kind, reverse));
+        PyMem_Free(values);
+        self->mod_count += 1;
+        return Py_NewRef(Py_None);
+    }
+    PyObject* items = PyList_New(self->length); if(!items) { return NULL; }
+    Py_ssize_t i = 0;
+    for(DLLValueBlock* block = self->head; block; block = block->next)
+    {
+        for(Py_ssize_t j = 0; j < block->count; j++)
+        {
+            PyObject* item = TypedLinkedList_box(self, block->items[j]); if(!item) { Py_DECREF(items); return NULL; }
+            PyList_SET_ITEM(items, i++, item);
+        }
+    }
+    size_t mod_count = self->mod_count;
+    PyObject* sort_args = PyTuple_New(0);
+    PyObject* sort_kwds = Py_BuildValue("{s:O,s:O}", "key", key, "reverse", reverse ? Py_True : Py_False);
+    PyObject* sort = PyObject_GetAttrString(items, "sort");
+    PyObject* rslt = sort && sort_args && sort_kwds ? PyObject_Call(sort, sort_args, sort_kwds) : NULL;
+    Py_XDECREF(sort); Py_XDECREF(sort_args); Py_XDECREF(sort_kwds);
+    if(rslt && (mod_count != self->mod_count || PyList_GET_SIZE(items) != self->length))
+    {
+        Py_CLEAR(rslt);
+        PyErr_SetString(PyExc_ValueError, "list modified during sort");
+    }
+    if(rslt)
+    {
+        // The boxed items came from the list, so they convert back without error
+        i = 0;
+        for(DLLValueBlock* block = self->head; block; block = block->next)
+        {
+            for(Py_ssize_t j = 0; j < block->count; j++) { TypedLinkedList_unbox(self, PyList_GET_ITEM(items, i++), &block->items[j]); }
+        }
+        self->mod_count += 1;
+    }
+    Py_DECREF(items);
+    return rslt;
+}
+
+static PyObject* TypedLinkedList_sizeof(PyObject* op, PyObject* Py_UNUSED(dummy))
+{
+    TypedLinkedList* self = (TypedLinkedList*)op;
+    Py_ssize_t block_bytes = sizeof(DLLValueBlock) + self->block_size * sizeof(DLLValue);
+    return PyLong_FromSsize_t(Py_TYPE(self)->tp_basicsize + self->block_count * block_bytes);
+}
+
+static PyObject* TypedLinkedList_reduce(PyObject* op, PyObject* Py_UNUSED(dummy))
+{
+    TypedLinkedList* self = (TypedLinkedList*)op;
+    if(self->block_size == TYPED_DEFAULT_BLOCK) { return DLL_reduce_streamed(op, NULL); }
+    PyObject* settings = Py_BuildValue("{sn}", "block_size", self->block_size); if(!settings) { return NULL; }
+    PyObject* rslt = DLL_reduce_streamed(op, settings);
+    Py_DECREF(settings);
+    return rslt;
+}
+
+static PyObject* TypedLinkedList_get_block_size(PyObject* op, void* closure)
+{
+    return PyLong_FromSsize_t(((TypedLinkedList*)op)->block_size);
+}
+
+// Compares like list does, finding the first values that differ and ordering those, or the lengths
+// if there are none. Typed lists of the same kind compare their raw values. Ordering is only
+// supported against typed lists, lists and tuples, equality against any iterable.
+static PyObject* TypedLinkedList_rich_compare(PyObject* op, PyObject* other, int compare_op)
+{
+    TypedLinkedList* self = (TypedLinkedList*)op;
+    int equality = compare_op == Py_EQ || compare_op == Py_NE;
+    if(op == other) { Py_RETURN_RICHCOMPARE(0, 0, compare_op); }
+    if(TypedLinkedList_Check(other) && ((TypedLinkedList*)other)->kind == self->kind)
+    {
+        // Compare the raw values block against block
+        TypedLinkedList* list = (TypedLinkedList*)other;
+        if(equality && self->length != list->length) { return PyBool_FromLong(compare_op == Py_NE); }
+        Py_ssize_t length = self->length < list->length ? self->length : list->length;
+        TypedPos a = {self->head, 0}, b = {list->head, 0};
+        for(Py_ssize_t i = 0; i < length; i++)
+        {
+            if(a.offset == a.block->count) { a.block = a.block->next; a.offset = 0; }
+            if(b.offset == b.block->count) { b.block = b.block->next; b.offset = 0; }
+            DLLValue x = a.block->items[a.offset++], y = b.block->items[b.offset++];
+            if(self->kind == DLL_KIND_I64)
+            {
+                if(x.i64 != y.i64) { Py_RETURN_RICHCOMPARE(x.i64, y.i64, compare_op); }
+            }
+            else if(!(x.f64 == y.f64)) { Py_RETURN_RICHCOMPARE(x.f64, y.f64, compare_op); }
+        }
+        Py_RETURN_RICHCOMPARE(self->length, list->length, compare_op);
+    }
+    if(!equality && !TypedLinkedList_Check(other) && !PyList_CheckExact(other) && !PyTuple_CheckExact(other))
+    {
+        Py_RETURN_NOTIMPLEMENTED;
+    }
+    PyObject* iterator = PyObject_GetIter(other);
+    if(!iterator)
+    {
+        PyErr_Clear();
+        Py_RETURN_NOTIMPLEMENTED;
+    }
+    size_t mod_count = self->mod_count;
+    PyObject* own = NULL;
+    PyObject* item = NULL;
+    Py_ssize_t compared = 0;
+    int done = 0;
+    for(DLLValueBlock* block = self->head; block && !done; block = block->next)
+    {
+        for(Py_ssize_t i = 0; i < block->count; i++)
+        {
+            item = PyIter_Next(iterator);
+            if(!item)
+            {
+                if(PyErr_Occurred()) { goto error; }
+                done = 1;
+                break;
+            }
+            own = TypedLinkedList_box(self, block->items[i]); if(!own) { goto error; }
+            int rslt = DLL_items_equal(own, item); if(rslt == -1) { goto error; }
+            if(mod_count != self->mod_count)
+            {
+                PyErr_Format(PyExc_RuntimeError, "%s changed during comparison", Py_TYPE(self)->tp_name);
+                goto error;
+            }
+            if(!rslt) { done = 1; break; }
+            Py_CLEAR(own);
+            Py_CLEAR(item);
+            compared += 1;
+        }
+    }
+    PyObject* rtn;
+    if(own)
+    {
+        if(compare_op == Py_EQ) { rtn = Py_NewRef(Py_False); }
+        else if(compare_op == Py_NE) { rtn = Py_NewRef(Py_True); }
+        else { rtn = DLL_items_order(own, item, compare_op); }
+        Py_DECREF(own);
+        Py_DECREF(item);
+        Py_DECREF(iterator);
+        return rtn;
+    }
+    // All compared values are equal, so the longer side is greater
+    int self_longer = compared < self->length;
+    int other_longer = 0;
+    if(!self_longer)
+    {
+        item = PyIter_Next(iterator);
+        if(!item && PyErr_Occurred()) { goto error; }
+        other_longer = item != NULL;
+        Py_CLEAR(item);
+    }
+    Py_DECREF(iterator);
+    Py_RETURN_RICHCOMPARE(self_longer, other_longer, compare_op);
+
+error:
+    Py_XDECREF(own);
+    Py_XDECREF(item);
+    Py_DECREF(iterator);
+    return NULL;
+}
+
+// Buffer Methods
+
+// Exports a read-only copy of the values in one contiguous array, shared by all exports
+static int TypedLinkedList_getbuffer(PyObject* op, Py_buffer* view, int flags)
+{
+    TypedLinkedList* self = (TypedLinkedList*)op;
+    if(flags & PyBUF_WRITABLE)
+    {
+        PyErr_SetString(PyExc_BufferError, "Typed list buffers are read-only");
+        view->obj = NULL;
+        return -1;
+    }
+    if(self->exports == 0)
+    {
+        DLLValue* values = PyMem_Malloc((self->length ? self->length : 1) * sizeof(DLLValue));
+        if(!values) { PyErr_NoMemory(); view->obj = NULL; return -1; }
+        TypedLinkedList_gather(self, values);
+        self->export_values = values;
+    }
+    self->exports += 1;
+    view->obj = Py_NewRef(op);
+    view->buf = self->export_values;
+    view->len = self->length * sizeof(DLLValue);
+    view->readonly = 1;
+    view->itemsize = sizeof(DLLValue);
+    view->format = (flags & PyBUF_FORMAT) ? (self->kind == DLL_KIND_I64 ? "q" : "d") : NULL;
+    view->ndim = 1;
+    view->shape = (flags & PyBUF_ND) ? &self->length : NULL; // length can't change while exported
+    view->strides = (flags & PyBUF_STRIDES) ? &view->itemsize : NULL;
+    view->suboffsets = NULL;
+    view->internal = NULL;
+    return 0;
+}
+
+static void TypedLinkedList_releasebuffer(PyObject* op, Py_buffer* view)
+{
+    TypedLinkedList* self = (TypedLinkedList*)op;
+    self->exports -= 1;
+    if(self->exports == 0)
+    {
+        PyMem_Free(self->export_values);
+        self->export_values = NULL;
+    }
+}
+
+// Mapping Methods
+
+static PyObject* TypedLinkedList_subscript(PyObject* op, PyObject* item)
+{
+    TypedLinkedList* self = (TypedLinkedList*)op;
+    if(PySlice_Check(item))
+    {
+        Py_ssize_t start, stop, step;
+        if(PySlice_Unpack(item, &start, &stop, &step) == -1) { return NULL; }
+        Py_ssize_t slice_length = PySlice_AdjustIndices(self->length, &start, &stop, step);
+        TypedLinkedList* slice = TypedLinkedList_empty_like(self); if(!slice) { return NULL; }
+        if(slice_length == 0) { return (PyObject*)slice; }
+        TypedPos pos = TypedLinkedList_locate(self, start);
+        DLLValueBlock* block = NULL;
+        for(Py_ssize_t i = 0; i < slice_length; i++)
+        {
+            if(!block || block->count == slice->block_size)
+            {
+                DLLValueBlock* new_block = TypedLinkedList_new_block(slice);
+                if(!new_block) { Py_DECREF(slice); return NULL; }
+                TypedLinkedList_link_block(slice, new_block, block);
+                block = new_block;
+            }
+            block->items[block->count++] = pos.block->items[pos.offset];
+            slice->length += 1;
+            if(i + 1 < slice_length) { TypedPos_advance(&pos, step); }
+        }
+        return (PyObject*)slice;
+    }
+    else if(PyIndex_Check(item))
+    {
+        Py_ssize_t index = PyNumber_AsSsize_t(item, PyExc_IndexError); if(index == -1 && PyErr_Occurred()) { return NULL; }
+        if(TypedLinkedList_check_index(self, &index)) { return NULL; }
+        TypedPos pos = TypedLinkedList_locate(self, index);
+        return TypedLinkedList_box(self, pos.block->items[pos.offset]);
+    }
+    PyErr_SetString(PyExc_TypeError, "Index must be an integer or slice");
+    return NULL;
+}
+
+// The sequence slot gets negative indexes with the length already added and would add it again
+static int TypedLinkedList_ass_item(PyObject*, Py_ssize_t, PyObject*);
+
+static int TypedLinkedList_ass_subscript(PyObject* op, PyObject* item, PyObject* value)
+{
+    TypedLinkedList* self = (TypedLinkedList*)op;
+    if(!PySlice_Check(item))
+    {
+        if(!PyIndex_Check(item))
+        {
+            PyErr_SetString(PyExc_TypeError, "Index must be an integer or slice");
+            return -1;
+        }
+        Py_ssize_t index = PyNumber_AsSsize_t(item, PyExc_IndexError); if(index == -1 && PyErr_Occurred()) { return -1; }
+        return TypedLinkedList_ass_item(op, index, value);
+    }
+    Py_ssize_t start, stop, step;
+    if(PySlice_Unpack(item, &start, &stop, &step) == -1) { return -1; }
+    // Values are converted before the slice is fitted to the length, converting can run Python code
+    Py_ssize_t count = 0;
+    DLLValue* values = NULL;
+    if(value) { values = TypedLinkedList_unbox_all(self, value, &count); if(!values) { return -1; } }
+    if(TypedLinkedList_check_exports(self)) { PyMem_Free(values); return -1; }
+    Py_ssize_t slice_length = PySlice_AdjustIndices(self->length, &start, &stop, step);
+    int rslt = 0;
+    if(!value)
+    {
+        // Walk negative steps forwards from the lowest index, the same values are removed
+        Py_ssize_t walk_start = step < 0 && slice_length > 0 ? start + (slice_length - 1) * step : start;
+        TypedLinkedList_unlink_slice(self, walk_start, step < 0 ? -step : step, slice_length);
+    }
+    else if(step == 1)
+    {
+        // The new blocks and a block to split the chain with are allocated before anything is removed
+        DLLValueBlock* first; DLLValueBlock* last; DLLValueBlock* spare = NULL;
+        rslt = TypedLinkedList_chain_from_array(self, values, count, &first, &last);
+        if(!rslt && first)
+        {
+            spare = TypedLinkedList_new_block(self);
+            if(!spare) { TypedLinkedList_drop_chain(self, first); rslt = -1; }
+        }
+        if(!rslt)
+        {
+            TypedLinkedList_unlink_slice(self, start, 1, slice_length);
+            if(first) { TypedLinkedList_link_chain(self, first, last, count, start, spare); }
+        }
+    }
+    else if(count != slice_length)
+    {
+        PyErr_Format(PyExc_ValueError, "attempt to assign sequence of size %zd to extended slice of size %zd", count, slice_length);
+        rslt = -1;
+    }
+    else if(slice_length > 0)
+    {
+        TypedPos pos = TypedLinkedList_locate(self, start);
+        for(Py_ssize_t i = 0; i < slice_length; i++)
+        {
+            if(i > 0) { TypedPos_advance(&pos, step); }
+            pos.block->items[pos.offset] = values[i];
+        }
+    }
+    PyMem_Free(values);
+    return rslt;
+}
+
+// Sequence Methods
+
+static Py_ssize_t TypedLinkedList_len(PyObject* op)
+{
+    return ((TypedLinkedList*)op)->length;
+}
+
+static PyObject* TypedLinkedList_item(PyObject* op, Py_ssize_t index)
+{
+    TypedLinkedList* self = (TypedLinkedList*)op;
+    if(TypedLinkedList_check_index(self, &index)) { return NULL; }
+    TypedPos pos = TypedLinkedList_locate(self, index);
+    return TypedLinkedList_box(self, pos.block->items[pos.offset]);
+}
+
+static int TypedLinkedList_ass_item(PyObject* op, Py_ssize_t index, PyObject* value)
+{
+    TypedLinkedList* self = (TypedLinkedList*)op;
+    DLLValue converted;
+    if(TypedLinkedList_check_exports(self) || TypedLinkedList_check_index(self, &index)) { return -1; }
+    if(!value)
+    {
+        TypedLinkedList_take(self, index);
+        return 0;
+    }
+    if(TypedLinkedList_unbox(self, value, &converted)) { return -1; }
+    TypedPos pos = TypedLinkedList_locate(self, index);
+    pos.block->items[pos.offset] = converted;
+    return 0;
+}
+
+static PyObject* TypedLinkedList_concat(PyObject* op, PyObject* other)
+{
+    PyObject* copy = TypedLinkedList_copy(op); if(!copy) { return NULL; }
+    if(TypedLinkedList_extend_iterable((TypedLinkedList*)copy, other, 1)) { Py_DECREF(copy); return NULL; }
+    return copy;
+}
+
+static PyObject* TypedLinkedList_inplace_concat(PyObject* op, PyObject* other)
+{
+    if(TypedLinkedList_check_exports((TypedLinkedList*)op)) { return NULL; }
+    if(TypedLinkedList_extend_iterable((TypedLinkedList*)op, other, 1)) { return NULL; }
+    return Py_NewRef(op);
+}
+
+static int TypedLinkedList_contains(PyObject* op, PyObject* value)
+{
+    TypedLinkedList* self = (TypedLinkedList*)op;
+    Py_ssize_t index = TypedLinkedList_find(self, value, 0, self->length);
+    if(index == -2) { return -1; }
+    return index >= 0;
+}
+
+// __Methods__
+
+static PyObject* TypedLinkedList_str(PyObject* op)
+{
+    return DLL_write_repr(op, ((TypedLinkedList*)op)->length, NULL, NULL, -1);
+}
+
+static PyObject* TypedLinkedList_write_repr(PyObject* op, Py_ssize_t max_items)
+{
+    TypedLinkedList* self = (TypedLinkedList*)op;
+    char settings[48] = "";
+    if(self->block_size != TYPED_DEFAULT_BLOCK) { PyOS_snprintf(settings, sizeof(settings), ", block_size=%zd", self->block_size); }
+    const char* name = self->kind == DLL_KIND_F64 ? "DoublyLinkedListF64" : "DoublyLinkedListI64";
+    return DLL_write_repr(op, self->length, name, settings, max_items);
+}
+
+static PyObject* TypedLinkedList_repr(PyObject* op)
+{
+    return TypedLinkedList_write_repr(op, -1);
+}
+
+static PyObject* TypedLinkedList_repr_limited(PyObject* op, PyObject* args, PyObject* kwds)
+{
+    Py_ssize_t max_items;
+    if(DLL_parse_max_items(args, kwds, &max_items)) { return NULL; }
+    return TypedLinkedList_write_repr(op, max_items);
+}
+
+// Iterator
+
+typedef struct
+{
+    PyObject_HEAD
+    TypedLinkedList* list;
+    DLLValueBlock* block;
+    Py_ssize_t offset;
+    Py_ssize_t remaining;
+    size_t mod_count;
+    int forward;
+} TypedLinkedListIterator;
+
+// The lists hold no objects, so neither they nor their iterators can be part of a reference cycle
+static PyObject* TypedLinkedListIterator_new(TypedLinkedList* list, int forward)
+{
+    TypedLinkedListIterator* self = PyObject_New(TypedLinkedListIterator, &TypedLinkedListIteratorType);
+    if(!self) { return NULL; }
+    self->list = (TypedLinkedList*)Py_NewRef((PyObject*)list);
+    self->block = forward ? list->head : list->tail;
+    self->offset = forward || !list->tail ? 0 : list->tail->count - 1;
+    self->remaining = list->length;
+    self->mod_count = list->mod_count;
+    self->forward = forward;
+    return (PyObject*)self;
+}
+
+static void TypedLinkedListIterator_dealloc(PyObject* op)
+{
+    TypedLinkedListIterator* self = (TypedLinkedListIterator*)op;
+    Py_XDECREF(self->list);
+    PyObject_Del(self);
+}
+
+static PyObject* TypedLinkedListIterator_next(PyObject* op)
+{
+    TypedLinkedListIterator* self = (TypedLinkedListIterator*)op;
+    if(!self->list) { return NULL; }
+    if(self->list->mod_count != self->mod_count)
+    {
+        self->block = NULL;
+        self->remaining = 0;
+        PyErr_Format(PyExc_RuntimeError, "%s changed during iteration", Py_TYPE(self->list)->tp_name);
+        Py_CLEAR(self->list);
+        return NULL;
+    }
+    if(self->remaining == 0)
+    {
+        Py_CLEAR(self->list);
+        return NULL;
+    }
+    DLLValue value = self->block->items[self->offset];
+    self->remaining -= 1;
+    if(self->forward)
+    {
+        if(++self->offset == self->block->count) { self->block = self->block->next; self->offset = 0; }
+    }
+    else if(--self->offset < 0 && self->block->prev)
+    {
+        self->block = self->block->prev;
+        self->offset = self->block->count - 1;
+    }
+    return TypedLinkedList_box(self->list, value);
+}
+
+static PyObject* TypedLinkedListIterator_length_hint(PyObject* op, PyObject* Py_UNUSED(dummy))
+{
+    TypedLinkedListIterator* self = (TypedLinkedListIterator*)op;
+    if(!self->list || self->list->mod_count != self->mod_count) { return PyLong_FromSsize_t(0); }
+    return PyLong_FromSsize_t(self->remaining);
+}
+
+static PyObject* TypedLinkedListIterator_next_unlocked(PyObject* op, PyObject* Py_UNUSED(dummy))
+{
+    return TypedLinkedListIterator_next(op);
+}
+
+static PyObject* TypedLinkedListIterator_next_locked(PyObject* op)
+{
+    PyObject** list = (PyObject**)&((TypedLinkedListIterator*)op)->list;
+    return DLLIterator_call_locked(op, list, TypedLinkedListIterator_next_unlocked);
+}
+
+static PyObject* TypedLinkedListIterator_length_hint_locked(PyObject* op, PyObject* Py_UNUSED(dummy))
+{
+    PyObject** list = (PyObject**)&((TypedLinkedListIterator*)op)->list;
+    return DLLIterator_call_locked(op, list, TypedLinkedListIterator_length_hint);
+}
+
+static PyObject* TypedLinkedList_iter(PyObject* op)
+{
+    return TypedLinkedListIterator_new((TypedLinkedList*)op, 1);
+}
+
+static PyObject* TypedLinkedList_reversed(PyObject* op, PyObject* Py_UNUSED(dummy))
+{
+    return TypedLinkedListIterator_new((TypedLinkedList*)op, 0);
+}
+
+static PyMethodDef TypedLinkedListIterator_methods[] = {
+    {"__length_hint__", (PyCFunction)TypedLinkedListIterator_length_hint_locked, METH_NOARGS,
+    "Private method returning an estimate of len(list(it))."},
+    {NULL, NULL, 0, NULL}
+};
+
+static PyTypeObject TypedLinkedListIteratorType =
+{
+    .ob_base = PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "py_doubly_linked_list.doubly_linked_list.TypedLinkedListIterator",
+    .tp_doc = PyDoc_STR("DoublyLinkedListI64 and DoublyLinkedListF64 iterator"),
+    .tp_basicsize = sizeof(TypedLinkedListIterator),
+    .tp_itemsize = 0,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_dealloc = (destructor)TypedLinkedListIterator_dealloc,
+    .tp_iter = PyObject_SelfIter,
+    .tp_iternext = TypedLinkedListIterator_next_locked,
+    .tp_methods = TypedLinkedListIterator_methods
+};
+
+// Locked entry points
+
+DLL_LOCKED(int, TypedLinkedList_init, (PyObject* op, PyObject* args, PyObject* kwds), (op, args, kwds))
+DLL_LOCKED_KWARGS(TypedLinkedList_append)
+DLL_LOCKED_UNARY(TypedLinkedList_clear_method)
+DLL_LOCKED_UNARY(TypedLinkedList_copy)
+DLL_LOCKED_KWARGS(TypedLinkedList_count)
+DLL_LOCKED_KWARGS(TypedLinkedList_extend)
+DLL_LOCKED_KWARGS(TypedLinkedList_index)
+DLL_LOCKED_KWARGS(TypedLinkedList_insert)
+DLL_LOCKED_NOARGS(TypedLinkedList_max)
+DLL_LOCKED_NOARGS(TypedLinkedList_min)
+DLL_LOCKED_KWARGS(TypedLinkedList_pop)
+DLL_LOCKED_KWARGS(TypedLinkedList_remove)
+DLL_LOCKED_UNARY(TypedLinkedList_reverse)
+DLL_LOCKED_KWARGS(TypedLinkedList_sort)
+DLL_LOCKED_NOARGS(TypedLinkedList_sum)
+DLL_LOCKED_NOARGS(TypedLinkedList_reversed)
+DLL_LOCKED_NOARGS(TypedLinkedList_sizeof)
+DLL_LOCKED_NOARGS(TypedLinkedList_reduce)
+DLL_LOCKED_UNARY(TypedLinkedList_iter)
+DLL_LOCKED_UNARY(TypedLinkedList_str)
+DLL_LOCKED_UNARY(TypedLinkedList_repr)
+DLL_LOCKED_KWARGS(TypedLinkedList_repr_limited)
+DLL_LOCKED(PyObject*, TypedLinkedList_rich_compare, (PyObject* op, PyObject* other, int compare_op), (op, other, compare_op))
+DLL_LOCKED(PyObject*, TypedLinkedList_get_block_size, (PyObject* op, void* closure), (op, closure))
+DLL_LOCKED(int, TypedLinkedList_getbuffer, (PyObject* op, Py_buffer* view, int flags), (op, view, flags))
+DLL_LOCKED_BINARY(TypedLinkedList_subscript)
+DLL_LOCKED(int, TypedLinkedList_ass_subscript, (PyObject* op, PyObject* item, PyObject* value), (op, item, value))
+DLL_LOCKED(Py_ssize_t, TypedLinkedList_len, (PyObject* op), (op))
+DLL_LOCKED(PyObject*, TypedLinkedList_item, (PyObject* op, Py_ssize_t index), (op, index))
+DLL_LOCKED(int, TypedLinkedList_ass_item, (PyObject* op, Py_ssize_t index, PyObject* value), (op, index, value))
+DLL_LOCKED_BINARY(TypedLinkedList_concat)
+DLL_LOCKED_BINARY(TypedLinkedList_inplace_concat)
+DLL_LOCKED(int, TypedLinkedList_contains, (PyObject* op, PyObject* value), (op, value))
+
+static void TypedLinkedList_releasebuffer_locked(PyObject* op, Py_buffer* view)
+{
+    Py_BEGIN_CRITICAL_SECTION(op);
+    TypedLinkedList_releasebuffer(op, view);
+    Py_END_CRITICAL_SECTION();
+}
+
+static PyMethodDef TypedLinkedList_methods[] = {
+    {"append", (PyCFunction)TypedLinkedList_append_locked, METH_VARARGS|METH_KEYWORDS,
+    "Append object to the end of the list. Set forward to false to append to the start."},
+    {"clear", (PyCFunction)TypedLinkedList_clear_method_locked, METH_NOARGS,
+    "Remove all items from the list."},
+    {"copy", (PyCFunction)TypedLinkedList_copy_locked, METH_NOARGS,
+    "Return a shallow copy of the list."},
+    {"count", (PyCFunction)TypedLinkedList_count_locked, METH_VARARGS|METH_KEYWORDS,
+    "Return number of occurrences of value in the list."},
+    {"extend", (PyCFunction)TypedLinkedList_extend_locked, METH_VARARGS|METH_KEYWORDS,
+    "Extend list by appending elements from the iterable. Set forward to false to extend from the start."},
+    {"index", (PyCFunction)TypedLinkedList_index_locked, METH_VARARGS|METH_KEYWORDS,
+    "Return first index of value.\nRaises ValueError if the value is not present."},
+    {"insert", (PyCFunction)TypedLinkedList_insert_locked, METH_VARARGS|METH_KEYWORDS,
+     "Insert object after index. Set forward to false to insert before index."},
+    {"max", (PyCFunction)TypedLinkedList_max_locked, METH_NOARGS,
+    "Return the largest value.\nRaises ValueError if the list is empty."},
+    {"min", (PyCFunction)TypedLinkedList_min_locked, METH_NOARGS,
+    "Return the smallest value.\nRaises ValueError if the list is empty."},
+    {"pop", (PyCFunction)TypedLinkedList_pop_locked, METH_VARARGS|METH_KEYWORDS,
+    "Remove and return item at index (default last).\nRaises IndexError if list is empty or index is out of range."},
+    {"remove", (PyCFunction)TypedLinkedList_remove_locked, METH_VARARGS|METH_KEYWORDS,
+    "Remove first occurence of value between start and stop.\nRaises ValueError if the value is not present."},
+    {"repr_limited", (PyCFunction)TypedLinkedList_repr_limited_locked, METH_VARARGS|METH_KEYWORDS,
+    "Return the repr of the list with at most max_items items written out, followed by the number left out."},
+    {"reverse", (PyCFunction)TypedLinkedList_reverse_locked, METH_NOARGS,
+    "Reverse the order of the list."},
+    {"sort", (PyCFunction)TypedLinkedList_sort_locked, METH_VARARGS|METH_KEYWORDS,
+    "In-place sort in ascending order, equal values are not swapped. Key can be applied to values and the list will be sorted based on the result of applying the key. Reverse will reverse the sort order."},
+    {"sum", (PyCFunction)TypedLinkedList_sum_locked, METH_NOARGS,
+    "Return the sum of the values, exact for DoublyLinkedListI64."},
+    {"__reversed__", (PyCFunction)TypedLinkedList_reversed_locked, METH_NOARGS,
+    "Return a reverse iterator over the list."},
+    {"__reduce__", (PyCFunction)TypedLinkedList_reduce_locked, METH_NOARGS,
+    "Return state for pickle, the items are streamed from an iterator."},
+    {"__sizeof__", (PyCFunction)TypedLinkedList_sizeof_locked, METH_NOARGS,
+    "Return the size of the list in memory, in bytes, including its blocks."},
+    {NULL, NULL, 0, NULL}
+};
+
+static PyGetSetDef TypedLinkedList_getset[] = {
+    {"block_size", TypedLinkedList_get_block_size_locked, NULL, "Number of values each block can hold.", NULL},
+    {NULL}
+};
+
+static PyMappingMethods TypedLinkedList_map =
+{
+    .mp_subscript = TypedLinkedList_subscript_locked,
+    .mp_ass_subscript = TypedLinkedList_ass_subscript_locked
+};
+
+static PySequenceMethods TypedLinkedList_sequence =
+{
+    .sq_length = TypedLinkedList_len_locked,
+    .sq_item = TypedLinkedList_item_locked,
+    .sq_ass_item = TypedLinkedList_ass_item_locked,
+    .sq_concat = TypedLinkedList_concat_locked,
+    .sq_inplace_concat = TypedLinkedList_inplace_concat_locked,
+    .sq_contains = TypedLinkedList_contains_locked
+};
+
+static PyBufferProcs TypedLinkedList_buffer =
+{
+    .bf_getbuffer = TypedLinkedList_getbuffer_locked,
+    .bf_releasebuffer = TypedLinkedList_releasebuffer_locked
+};
+
+// Type Definitions
+
+static PyTypeObject DoublyLinkedListI64Type =
+{
+    .ob_base = PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "py_doubly_linked_list.doubly_linked_list.DoublyLinkedListI64",
+    .tp_doc = PyDoc_STR("DoublyLinkedListI64 class, a linked list of 64 bit integers stored unboxed in blocks"),
+    .tp_basicsize = sizeof(TypedLinkedList),
+    .tp_itemsize = 0,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_new = (newfunc)TypedLinkedList_new,
+    .tp_init = TypedLinkedList_init_locked,
+    .tp_dealloc = (destructor)TypedLinkedList_dealloc,
+    .tp_str = TypedLinkedList_str_locked,
+    .tp_repr = TypedLinkedList_repr_locked,
+    .tp_richcompare = TypedLinkedList_rich_compare_locked,
+    .tp_iter = TypedLinkedList_iter_locked,
+    .tp_methods = TypedLinkedList_methods,
+    .tp_getset = TypedLinkedList_getset,
+    .tp_as_sequence = &TypedLinkedList_sequence,
+    .tp_as_mapping = &TypedLinkedList_map,
+    .tp_as_buffer = &TypedLinkedList_buffer
+};
+
+static PyTypeObject DoublyLinkedListF64Type =
+{
+    .ob_base = PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "py_doubly_linked_list.doubly_linked_list.DoublyLinkedListF64",
+    .tp_doc = PyDoc_STR("DoublyLinkedListF64 class, a linked list of doubles stored unboxed in blocks"),
+    .tp_basicsize = sizeof(TypedLinkedList),
+    .tp_itemsize = 0,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_new = (newfunc)TypedLinkedList_new,
+    .tp_init = TypedLinkedList_init_locked,
+    .tp_dealloc = (destructor)TypedLinkedList_dealloc,
+    .tp_str = TypedLinkedList_str_locked,
+    .tp_repr = TypedLinkedList_repr_locked,
+    .tp_richcompare = TypedLinkedList_rich_compare_locked,
+    .tp_iter = TypedLinkedList_iter_locked,
+    .tp_methods = TypedLinkedList_methods,
+    .tp_getset = TypedLinkedList_getset,
+    .tp_as_sequence = &TypedLinkedList_sequence,
+    .tp_as_mapping = &TypedLinkedList_map,
+    .tp_as_buffer = &TypedLinkedList_buffer
+};
+
+// - - - - - MappedLinkedList - - - - - //
+
+// A doubly linked list whose nodes live in a memory mapped file, for lists that don't fit in memory.
+// Links are file offsets rather than pointers, and the header at the start of the file holds the
+// head, tail, length and free lists, so an existing file is reopened without reading its nodes.
+// Nodes are allocated in power of two size classes and freed nodes are kept on a free list per
+// class. Values are stored serialized, which limits them to None, bool, int (64 bit), float, bytes
+// and str. Recently used nodes keep their decoded value in a small cache, so reading back what was
+// just written near the cursor or at either end doesn't rebuild the object.
+
+#define MAPPED_MAGIC "PDLLMAP1"
+#define MAPPED_CLASSES 32
+#define MAPPED_MIN_NODE 32 // Size of the smallest class, including the node header
+#define MAPPED_DATA_START 512 // The first node comes after the header
+#define MAPPED_MIN_SIZE 65536 // Size of a new file, it grows by doubling
+#define MAPPED_CACHE 64
+
+enum {MAPPED_NONE, MAPPED_FALSE, MAPPED_TRUE, MAPPED_INT, MAPPED_FLOAT, MAPPED_BYTES, MAPPED_STR};
+
+// Offset 0 is the header, so it doubles as the null link. Fields are in native byte order.
+typedef struct
+{
+    char magic[8];
+    uint64_t head;
+    uint64_t tail;
+    uint64_t length;
+    uint64_t end; // Offset of the first byte no node was ever allocated from
+    uint64_t free[MAPPED_CLASSES]; // Free list of every size class, linked through next
+} MappedHeader;
+
+typedef struct
+{
+    uint64_t prev;
+    uint64_t next;
+    uint32_t size; // Bytes of the serialized value that follows the node
+    uint8_t tag;
+    uint8_t size_class;
+    uint16_t reserved;
+} MappedNode;
+
+typedef struct
+{
+    uint64_t offset;
+    PyObject* value;
+} MappedCacheEntry;
+
+typedef struct
+{
+    PyObject_HEAD
+    PyObject* file; // Unbuffered file object, NULL once closed
+    PyObject* map; // mmap.mmap over the whole file
+    Py_buffer view; // Writable view of map, the start of the file is view.buf
+    uint64_t cursor; // Node of the last located position, 0 if there is none
+    Py_ssize_t cursor_pos;
+    size_t mod_count;
+    MappedCacheEntry cache[MAPPED_CACHE]; // Decoded values by node offset
+} MappedLinkedList;
+
+// The serialized form of a value, data points into the object or at scratch
+typedef struct
+{
+    uint8_t tag;
+    const char* data;
+    Py_ssize_t size;
+    char scratch[8];
+} MappedValue;
+
+static PyTypeObject MappedLinkedListType;
+static PyTypeObject MappedLinkedListIteratorType;
+
+// Mapping helpers
+
+static inline MappedHeader* MappedLinkedList_header(MappedLinkedList* self)
+{
+    return (MappedHeader*)self->view.buf;
+}
+
+static inline MappedNode* MappedLinkedList_node(MappedLinkedList* self, uint64_t offset)
+{
+    return (MappedNode*)((char*)self->view.buf + offset);
+}
+
+static inline Py_ssize_t MappedLinkedList_length(MappedLinkedList* self)
+{
+    return (Py_ssize_t)MappedLinkedList_header(self)->length;
+}
+
+static int MappedLinkedList_check_open(MappedLinkedList* self)
+{
+    if(self->map) { return 0; }
+    PyErr_SetString(PyExc_ValueError, "I/O operation on closed MappedLinkedList");
+    return -1;
+}
+
+// Maps the whole file and takes a writable view of it
+static int MappedLinkedList_map(MappedLinkedList* self)
+{
+    PyObject* mmap_type = DLL_import_attr("mmap", "mmap"); if(!mmap_type) { return -1; }
+    PyObject* fileno = PyObject_CallMethod(self->file, "fileno", NULL);
+    self->map = fileno ? PyObject_CallFunction(mmap_type, "On", fileno, (Py_ssize_t)0) : NULL;
+    Py_XDECREF(fileno); Py_DECREF(mmap_type);
+    if(!self->map) { return -1; }
+    if(PyObject_GetBuffer(self->map, &self->view, PyBUF_WRITABLE)) { Py_CLEAR(self->map); return -1; }
+    return 0;
+}
+
+static int MappedLinkedList_unmap(MappedLinkedList* self)
+{
+    if(!self->map) { return 0; }
+    PyBuffer_Release(&self->view);
+    PyObject* rslt = PyObject_CallMethod(self->map, "close", NULL);
+    Py_CLEAR(self->map);
+    if(!rslt) { return -1; }
+    Py_DECREF(rslt);
+    return 0;
+}
+
+static void MappedLinkedList_cache_clear(MappedLinkedList* self)
+{
+    for(int i = 0; i < MAPPED_CACHE; i++)
+    {
+        self->cache[i].offset = 0;
+        Py_CLEAR(self->cache[i].value);
+    }
+}
+
+// Unmaps and closes the file, every later operation raises ValueError
+static int MappedLinkedList_close_file(MappedLinkedList* self)
+{
+    MappedLinkedList_cache_clear(self);
+    self->cursor = 0;
+    self->mod_count += 1;
+    int rslt = MappedLinkedList_unmap(self);
+    if(self->file && !rslt)
+    {
+        PyObject* closed = PyObject_CallMethod(self->file, "close", NULL);
+        if(!closed) { rslt = -1; }
+        Py_XDECREF(closed);
+    }
+    Py_CLEAR(self->file);
+    return rslt;
+}
+
+// Closes the list after an error, keeping the error that is already set
+static void MappedLinkedList_abort(MappedLinkedList* self)
+{
+    PyObject *type, *value, *traceback;
+    PyErr_Fetch(&type, &value, &traceback);
+    if(MappedLinkedList_close_file(self)) { PyErr_Clear(); }
+    PyErr_Restore(type, value, traceback);
+}
+
+// Resizes the file to size bytes and maps it again. The mapping can move, so pointers into it have
+// to be looked up again from their offsets afterwards. The list is closed if it can't be remapped.
+static int MappedLinkedList_resize(MappedLinkedList* self, uint64_t size)
+{
+    if(MappedLinkedList_unmap(self)) { MappedLinkedList_abort(self); return -1; }
+    PyObject* rslt = PyObject_CallMethod(self->file, "truncate", "K", (unsigned long long)size);
+    Py_XDECREF(rslt);
+    if(!rslt)
+    {
+        // Keep the list usable at its old size
+        PyObject *type, *value, *traceback;
+        PyErr_Fetch(&type, &value, &traceback);
+        if(MappedLinkedList_map(self)) { Py_XDECREF(type); Py_XDECREF(value); Py_XDECREF(traceback); MappedLinkedList_abort(self); return -1; }
+        PyErr_Restore(type, value, traceback);
+        return -1;
+    }
+    if(MappedLinkedList_map(self)) { MappedLinkedList_abort(self); return -1; }
+    return 0;
+}
+
+static void MappedLinkedList_format(MappedLinkedList* self)
+{
+    MappedHeader* header = MappedLinkedList_header(self);
+    memset(header, 0, sizeof(MappedHeader));
+    memcpy(header->magic, MAPPED_MAGIC, 8);
+    header->end = MAPPED_DATA_START;
+}
+
+// Opens path, creating it if it doesn't exist, and maps it. An existing file only has its header checked.
+static int MappedLinkedList_open(MappedLinkedList* self, PyObject* path)
+{
+    PyObject* io_open = DLL_import_attr("io", "open"); if(!io_open) { return -1; }
+    self->file = PyObject_CallFunction(io_open, "Osi", path, "r+b", 0);
+    if(!self->file && PyErr_ExceptionMatches(PyExc_FileNotFoundError))
+    {
+        PyErr_Clear();
+        self->file = PyObject_CallFunction(io_open, "Osi", path, "w+b", 0);
+    }
+    Py_DECREF(io_open);
+    if(!self->file) { return -1; }
+    PyObject* end = PyObject_CallMethod(self->file, "seek", "ii", 0, 2);
+    long long size = end ? PyLong_AsLongLong(end) : -1;
+    Py_XDECREF(end);
+    if(size == -1 && PyErr_Occurred()) { MappedLinkedList_abort(self); return -1; }
+    if(size == 0)
+    {
+        PyObject* rslt = PyObject_CallMethod(self->file, "truncate", "i", MAPPED_MIN_SIZE);
+        Py_XDECREF(rslt);
+        if(!rslt || MappedLinkedList_map(self)) { MappedLinkedList_abort(self); return -1; }
+        MappedLinkedList_format(self);
+        return 0;
+    }
+    if(size < MAPPED_DATA_START || MappedLinkedList_map(self))
+    {
+        if(!PyErr_Occurred()) { PyErr_Format(PyExc_ValueError, "%R is not a MappedLinkedList file", path); }
+        MappedLinkedList_abort(self);
+        return -1;
+    }
+    MappedHeader* header = MappedLinkedList_header(self);
+    if(memcmp(header->magic, MAPPED_MAGIC, 8) || header->end < MAPPED_DATA_START || header->end > (uint64_t)size
+       || header->head >= header->end || header->tail >= header->end || !header->head != !header->tail)
+    {
+        PyErr_Format(PyExc_ValueError, "%R is not a MappedLinkedList file", path);
+        MappedLinkedList_abort(self);
+        return -1;
+    }
+    return 0;
+}
+
+// Value helpers
+
+static int MappedValue_from_object(MappedValue* value, PyObject* object)
+{
+    value->data = value->scratch;
+    value->size = 0;
+    if(Py_IsNone(object)) { value->tag = MAPPED_NONE; }
+    else if(PyBool_Check(object)) { value->tag = Py_Is(object, Py_True) ? MAPPED_TRUE : MAPPED_FALSE; }
+    else if(PyLong_Check(object))
+    {
+        int overflow;
+        long long number = PyLong_AsLongLongAndOverflow(object, &overflow);
+        if(overflow) { PyErr_SetString(PyExc_OverflowError, "MappedLinkedList ints must fit in 64 bits"); return -1; }
+        if(number == -1 && PyErr_Occurred()) { return -1; }
+        int64_t stored = number;
+        memcpy(value->scratch, &stored, 8);
+        value->tag = MAPPED_INT; value->size = 8;
+    }
+    else if(PyFloat_Check(object))
+    {
+        double number = PyFloat_AS_DOUBLE(object);
+        memcpy(value->scratch, &number, 8);
+        value->tag = MAPPED_FLOAT; value->size = 8;
+    }
+    else if(PyBytes_Check(object))
+    {
+        value->tag = MAPPED_BYTES;
+        value->data = PyBytes_AS_STRING(object);
+        value->size = PyBytes_GET_SIZE(object);
+    }
+    else if(PyUnicode_Check(object))
+    {
+        value->tag = MAPPED_STR;
+        value->data = PyUnicode_AsUTF8AndSize(object, &value->size); if(!value->data) { return -1; }
+    }
+    else
+    {
+        PyErr_Format(PyExc_TypeError, "MappedLinkedList can only store None, bool, int, float, bytes and str, not %.200s", Py_TYPE(object)->tp_name);
+        return -1;
+    }
+    if((uint64_t)value->size > UINT32_MAX - sizeof(MappedNode))
+    {
+        PyErr_SetString(PyExc_OverflowError, "value is too large for a MappedLinkedList node");
+        return -1;
+    }
+    return 0;
+}
+
+static inline MappedCacheEntry* MappedLinkedList_cache_entry(MappedLinkedList* self, uint64_t offset)
+{
+    return &self->cache[(offset / MAPPED_MIN_NODE) % MAPPED_CACHE];
+}
+
+static void MappedLinkedList_cache_drop(MappedLinkedList* self, uint64_t offset)
+{
+    MappedCacheEntry* entry = MappedLinkedList_cache_entry(self, offset);
+    if(entry->offset == offset) { entry->offset = 0; Py_CLEAR(entry->value); }
+}
+
+// Only exact builtin types are cached, they are immutable and decode to an equal object of the same type
+static void MappedLinkedList_cache_store(MappedLinkedList* self, uint64_t offset, PyObject* object)
+{
+    MappedCacheEntry* entry = MappedLinkedList_cache_entry(self, offset);
+    if(!PyLong_CheckExact(object) && !PyFloat_CheckExact(object) && !PyBytes_CheckExact(object) && !PyUnicode_CheckExact(object))
+    {
+        if(entry->offset == offset) { entry->offset = 0; Py_CLEAR(entry->value); }
+        return;
+    }
+    entry->offset = offset;
+    Py_XSETREF(entry->value, Py_NewRef(object));
+}
+
+// Returns a new reference to the value of the node at offset
+static PyObject* MappedLinkedList_value(MappedLinkedList* self, uint64_t offset)
+{
+    MappedCacheEntry* entry = MappedLinkedList_cache_entry(self, offset);
+    if(entry->offset == offset && entry->value) { return Py_NewRef(entry->value); }
+    MappedNode* node = MappedLinkedList_node(self, offset);
+    const char* data = (const char*)(node + 1);
+    PyObject* object;
+    switch(node->tag)
+    {
+        case MAPPED_NONE: return Py_NewRef(Py_None);
+        case MAPPED_FALSE: return Py_NewRef(Py_False);
+        case MAPPED_TRUE: return Py_NewRef(Py_True);
+        case MAPPED_INT:
+        {
+            int64_t number; memcpy(&number, data, 8);
+            object = PyLong_FromLongLong(number);
+            break;
+        }
+        case MAPPED_FLOAT:
+        {
+            double number; memcpy(&number, data, 8);
+            object = PyFloat_FromDouble(number);
+            break;
+        }
+        case MAPPED_BYTES: object = PyBytes_FromStringAndSize(data, node->size); break;
+        case MAPPED_STR: object = PyUnicode_DecodeUTF8(data, node->size, "strict"); break;
+        default:
+            PyErr_SetString(PyExc_ValueError, "MappedLinkedList file is corrupt");
+            return NULL;
+    }
+    if(object) { MappedLinkedList_cache_store(self, offset, object); }
+    return object;
+}
+
+// Node helpers
+
+// Returns the offset of an unlinked node with room for value, growing the file if needed, or 0 on error
+static uint64_t MappedLinkedList_alloc(MappedLinkedList* self, MappedValue* value)
+{
+    int size_class = 0;
+    while(((uint64_t)MAPPED_MIN_NODE << size_class) < sizeof(MappedNode) + (uint64_t)value->size) { size_class++; }
+    MappedHeader* header = MappedLinkedList_header(self);
+    uint64_t offset = header->free[size_class];
+    if(offset) { header->free[size_class] = MappedLinkedList_node(self, offset)->next; }
+    else
+    {
+        uint64_t bytes = (uint64_t)MAPPED_MIN_NODE << size_class;
+        uint64_t capacity = (uint64_t)self->view.len;
+        if(header->end + bytes > capacity)
+        {
+            while(capacity < header->end + bytes) { capacity *= 2; }
+            if(MappedLinkedList_resize(self, capacity)) { return 0; }
+            header = MappedLinkedList_header(self);
+        }
+        offset = header->end;
+        header->end += bytes;
+    }
+    MappedNode* node = MappedLinkedList_node(self, offset);
+    node->size_class = (uint8_t)size_class;
+    node->tag = value->tag;
+    node->size = (uint32_t)value->size;
+    node->reserved = 0;
+    memcpy(node + 1, value->data, value->size);
+    return offset;
+}
+
+static void MappedLinkedList_free(MappedLinkedList* self, uint64_t offset)
+{
+    MappedLinkedList_cache_drop(self, offset);
+    MappedHeader* header = MappedLinkedList_header(self);
+    MappedNode* node = MappedLinkedList_node(self, offset);
+    node->prev = 0;
+    node->next = header->free[node->size_class];
+    header->free[node->size_class] = offset;
+}
+
+// Links the node at offset in after prev, or at the head if prev is 0
+static void MappedLinkedList_link(MappedLinkedList* self, uint64_t offset, uint64_t prev)
+{
+    MappedHeader* header = MappedLinkedList_header(self);
+    MappedNode* node = MappedLinkedList_node(self, offset);
+    uint64_t next = prev ? MappedLinkedList_node(self, prev)->next : header->head;
+    node->prev = prev;
+    node->next = next;
+    if(prev) { MappedLinkedList_node(self, prev)->next = offset; } else { header->head = offset; }
+    if(next) { MappedLinkedList_node(self, next)->prev = offset; } else { header->tail = offset; }
+    header->length += 1;
+}
+
+static void MappedLinkedList_unlink(MappedLinkedList* self, uint64_t offset)
+{
+    MappedHeader* header = MappedLinkedList_header(self);
+    MappedNode* node = MappedLinkedList_node(self, offset);
+    if(node->prev) { MappedLinkedList_node(self, node->prev)->next = node->next; } else { header->head = node->next; }
+    if(node->next) { MappedLinkedList_node(self, node->next)->prev = node->prev; } else { header->tail = node->prev; }
+    header->length -= 1;
+}
+
+// Internal Methods
+
+// Returns the node at index from the nearest of the cursor, head and tail and moves the cursor
+// there. Raises IndexError and returns 0 if the index is out of range.
+static uint64_t MappedLinkedList_locate(MappedLinkedList* self, Py_ssize_t index)
+{
+    Py_ssize_t length = MappedLinkedList_length(self);
+    if(index < 0) { index += length; }
+    if(index < 0 || index >= length)
+    {
+        PyErr_SetString(PyExc_IndexError, "Index out of bounds");
+        return 0;
+    }
+    MappedHeader* header = MappedLinkedList_header(self);
+    uint64_t offset = header->head;
+    Py_ssize_t position = 0;
+    if(length - 1 - index < index) { offset = header->tail; position = length - 1; }
+    if(self->cursor && labs(index - self->cursor_pos) < labs(index - position))
+    {
+        offset = self->cursor;
+        position = self->cursor_pos;
+    }
+    for(; position < index; position++) { offset = MappedLinkedList_node(self, offset)->next; }
+    for(; position > index; position--) { offset = MappedLinkedList_node(self, offset)->prev; }
+    self->cursor = offset;
+    self->cursor_pos = index;
+    return offset;
+}
+
+// Stores object so that it ends up at position, 0 <= position <= length
+static int MappedLinkedList_insert_at(MappedLinkedList* self, PyObject* object, Py_ssize_t position)
+{
+    if(MappedLinkedList_check_open(self)) { return -1; }
+    MappedValue value;
+    if(MappedValue_from_object(&value, object)) { return -1; }
+    uint64_t prev = 0;
+    if(position == MappedLinkedList_length(self)) { prev = MappedLinkedList_header(self)->tail; }
+    else if(position > 0)
+    {
+        prev = MappedLinkedList_locate(self, position - 1); if(!prev) { return -1; }
+    }
+    uint64_t offset = MappedLinkedList_alloc(self, &value); if(!offset) { return -1; }
+    MappedLinkedList_link(self, offset, prev);
+    MappedLinkedList_cache_store(self, offset, object);
+    self->cursor = offset;
+    self->cursor_pos = position;
+    self->mod_count += 1;
+    return 0;
+}
+
+// Removes the node at offset, which is at position, and moves the cursor to a neighbour
+static void MappedLinkedList_delete(MappedLinkedList* self, uint64_t offset, Py_ssize_t position)
+{
+    MappedNode* node = MappedLinkedList_node(self, offset);
+    if(node->next) { self->cursor = node->next; self->cursor_pos = position; }
+    else { self->cursor = node->prev; self->cursor_pos = position - 1; }
+    MappedLinkedList_unlink(self, offset);
+    MappedLinkedList_free(self, offset);
+    self->mod_count += 1;
+}
+
+// Initialization and deallocation
+
+static void MappedLinkedList_dealloc(PyObject* op)
+{
+    MappedLinkedList* self = (MappedLinkedList*)op;
+    if(self->file)
+    {
+        PyObject *type, *value, *traceback;
+        PyErr_Fetch(&type, &value, &traceback);
+        if(MappedLinkedList_close_file(self)) { PyErr_WriteUnraisable(op); }
+        PyErr_Restore(type, value, traceback);
+    }
+    Py_TYPE(self)->tp_free(self);
+}
+
+static PyObject* MappedLinkedList_new(PyTypeObject* type, PyObject* args, PyObject* kwds)
+{
+    MappedLinkedList* self = (MappedLinkedList*)type->tp_alloc(type, 0);
+    if(self)
+    {
+        self->file = NULL;
+        self->map = NULL;
+        self->cursor = 0;
+        self->cursor_pos = 0;
+        self->mod_count = 0;
+        memset(self->cache, 0, sizeof(self->cache));
+    }
+    return (PyObject*)self;
+}
+
+static PyObject* MappedLinkedList_extend(PyObject*, PyObject*, PyObject*);
+
+static int MappedLinkedList_init(PyObject* op, PyObject* args, PyObject* kwds)
+{
+    MappedLinkedList* self = (MappedLinkedList*)op;
+    static char* kwlist[] = {"path", "iterable", NULL};
+    PyObject* path;
+    PyObject* iterable = NULL;
+    if(!PyArg_ParseTupleAndKeywords(args, kwds, "O|O", kwlist, &path, &iterable)) { return -1; }
+    if(self->file && MappedLinkedList_close_file(self)) { return -1; }
+    if(MappedLinkedList_open(self, path)) { return -1; }
+    if(iterable)
+    {
+        PyObject* extend_args = PyTuple_Pack(1, iterable); if(!extend_args) { return -1; }
+        PyObject* rslt = MappedLinkedList_extend(op, extend_args, NULL);
+        Py_DECREF(extend_args);
+        if(!rslt) { return -1; }
+        Py_DECREF(rslt);
+    }
+    return 0;
+}
+
+// Methods
+
+static PyObject* MappedLinkedList_append(PyObject* op, PyObject* args, PyObject* kwds)
+{
+    MappedLinkedList* self = (MappedLinkedList*)op;
+    static char* kwlist[] = {"object", "forward", NULL};
+    PyObject* object;
+    int forward = 1;
+    if(!PyArg_ParseTupleAndKeywords(args, kwds, "O|i", kwlist, &object, &forward)) { return NULL; }
+    if(MappedLinkedList_check_open(self)) { return NULL; }
+    if(MappedLinkedList_insert_at(self, object, forward ? MappedLinkedList_length(self) : 0)) { return NULL; }
+    return Py_NewRef(Py_None);
+}
+
+static PyObject* MappedLinkedList_insert(PyObject* op, PyObject* args, PyObject* kwds)
+{
+    MappedLinkedList* self = (MappedLinkedList*)op;
+    static char* kwlist[] = {"object", "index", "forward", NULL};
+    PyObject* object;
+    Py_ssize_t index;
+    int forward = 1;
+    if(!PyArg_ParseTupleAndKeywords(args, kwds, "On|i", kwlist, &object, &index, &forward)) { return NULL; }
+    if(MappedLinkedList_check_open(self)) { return NULL; }
+    if(!MappedLinkedList_locate(self, index)) { return NULL; }
+    if(MappedLinkedList_insert_at(self, object, self->cursor_pos + (forward ? 1 : 0))) { return NULL; }
+    return Py_NewRef(Py_None);
+}
+
+// Items are stored one at a time as they are read, so an error keeps the items stored before it
+static PyObject* MappedLinkedList_extend(PyObject* op, PyObject* args, PyObject* kwds)
+{
+    MappedLinkedList* self = (MappedLinkedList*)op;
+    static char* kwlist[] = {"iterable", "forward", NULL};
+    PyObject* iterable;
+    int forward = 1;
+    if(!PyArg_ParseTupleAndKeywords(args, kwds, "O|i", kwlist, &iterable, &forward)) { return NULL; }
+    if(MappedLinkedList_check_open(self)) { return NULL; }
+    // Extending a list with itself reads a snapshot, its own iterator would see it change
+    PyObject* source = Py_Is(iterable, op) ? PySequence_List(op) : Py_NewRef(iterable); if(!source) { return NULL; }
+    PyObject* iterator = PyObject_GetIter(source);
+    Py_DECREF(source);
+    if(!iterator) { return NULL; }
+    PyObject* item;
+    while((item = PyIter_Next(iterator)))
+    {
+        Py_ssize_t position = forward && self->map ? MappedLinkedList_length(self) : 0;
+        int rslt = MappedLinkedList_insert_at(self, item, position);
+        Py_DECREF(item);
+        if(rslt) { Py_DECREF(iterator); return NULL; }
+    }
+    Py_DECREF(iterator);
+    if(PyErr_Occurred()) { return NULL; }
+    return Py_NewRef(Py_None);
+}
+
+static PyObject* MappedLinkedList_pop(PyObject* op, PyObject* args, PyObject* kwds)
+{
+    MappedLinkedList* self = (MappedLinkedList*)op;
+    static char* kwlist[] = {"index", NULL};
+    Py_ssize_t index = -1;
+    if(!PyArg_ParseTupleAndKeywords(args, kwds, "|n", kwlist, &index)) { return NULL; }
+    if(MappedLinkedList_check_open(self)) { return NULL; }
+    uint64_t offset = MappedLinkedList_locate(self, index); if(!offset) { return NULL; }
+    PyObject* popped = MappedLinkedList_value(self, offset); if(!popped) { return NULL; }
+    MappedLinkedList_delete(self, offset, self->cursor_pos);
+    return popped;
+}
+
+// Drops every node and shrinks the file back to the size of a new one
+static PyObject* MappedLinkedList_clear_method(PyObject* op)
+{
+    MappedLinkedList* self = (MappedLinkedList*)op;
+    if(MappedLinkedList_check_open(self)) { return NULL; }
+    MappedLinkedList_cache_clear(self);
+    MappedLinkedList_format(self);
+    self->cursor = 0;
+    self->cursor_pos = 0;
+    self->mod_count += 1;
+    if(self->view.len > MAPPED_MIN_SIZE && MappedLinkedList_resize(self, MAPPED_MIN_SIZE)) { return NULL; }
+    return Py_NewRef(Py_None);
+}
+
+static PyObject* MappedLinkedList_flush(PyObject* op)
+{
+    MappedLinkedList* self = (MappedLinkedList*)op;
+    if(MappedLinkedList_check_open(self)) { return NULL; }
+    return PyObject_CallMethod(self->map, "flush", NULL);
+}
+
+static PyObject* MappedLinkedList_close(PyObject* op)
+{
+    if(MappedLinkedList_close_file((MappedLinkedList*)op)) { return NULL; }
+    return Py_NewRef(Py_None);
+}
+
+static PyObject* MappedLinkedList_enter(PyObject* op)
+{
+    if(MappedLinkedList_check_open((MappedLinkedList*)op)) { return NULL; }
+    return Py_NewRef(op);
+}
+
+static PyObject* MappedLinkedList_exit(PyObject* op, PyObject* Py_UNUSED(args))
+{
+    return MappedLinkedList_close(op);
+}
+
+static PyObject* MappedLinkedList_get_closed(PyObject* op, void* closure)
+{
+    return PyBool_FromLong(((MappedLinkedList*)op)->map == NULL);
+}
+
+// Mapping Methods
+
+// Subscripts come here with the index as written, the sequence slots get negative indexes with the
+// length already added and would add it a second time
+static PyObject* MappedLinkedList_item(PyObject*, Py_ssize_t);
+static int MappedLinkedList_ass_item(PyObject*, Py_ssize_t, PyObject*);
+
+static PyObject* MappedLinkedList_subscript(PyObject* op, PyObject* item)
+{
+    if(!PyIndex_Check(item))
+    {
+        PyErr_SetString(PyExc_TypeError, "Index must be an integer");
+        return NULL;
+    }
+    Py_ssize_t index = PyNumber_AsSsize_t(item, PyExc_IndexError); if(index == -1 && PyErr_Occurred()) { return NULL; }
+    return MappedLinkedList_item(op, index);
+}
+
+static int MappedLinkedList_ass_subscript(PyObject* op, PyObject* item, PyObject* value)
+{
+    if(!PyIndex_Check(item))
+    {
+        PyErr_SetString(PyExc_TypeError, "Index must be an integer");
+        return -1;
+    }
+    Py_ssize_t index = PyNumber_AsSsize_t(item, PyExc_IndexError); if(index == -1 && PyErr_Occurred()) { return -1; }
+    return MappedLinkedList_ass_item(op, index, value);
+}
+
+// Sequence Methods
+
+static Py_ssize_t MappedLinkedList_len(PyObject* op)
+{
+    MappedLinkedList* self = (MappedLinkedList*)op;
+    if(MappedLinkedList_check_open(self)) { return -1; }
+    return MappedLinkedList_length(self);
+}
+
+static PyObject* MappedLinkedList_item(PyObject* op, Py_ssize_t index)
+{
+    MappedLinkedList* self = (MappedLinkedList*)op;
+    if(MappedLinkedList_check_open(self)) { return NULL; }
+    uint64_t offset = MappedLinkedList_locate(self, index); if(!offset) { return NULL; }
+    return MappedLinkedList_value(self, offset);
+}
+
+// A value that fits the size class of the node is written in place, others get a new node
+static int MappedLinkedList_ass_item(PyObject* op, Py_ssize_t index, PyObject* object)
+{
+    MappedLinkedList* self = (MappedLinkedList*)op;
+    if(MappedLinkedList_check_open(self)) { return -1; }
+    uint64_t offset = MappedLinkedList_locate(self, index); if(!offset) { return -1; }
+    Py_ssize_t position = self->cursor_pos;
+    if(!object) { MappedLinkedList_delete(self, offset, position); return 0; }
+    MappedValue value;
+    if(MappedValue_from_object(&value, object)) { return -1; }
+    MappedNode* node = MappedLinkedList_node(self, offset);
+    if(sizeof(MappedNode) + (uint64_t)value.size <= (uint64_t)MAPPED_MIN_NODE << node->size_class)
+    {
+        node->tag = value.tag;
+        node->size = (uint32_t)value.size;
+        memcpy(node + 1, value.data, value.size);
+        MappedLinkedList_cache_store(self, offset, object);
+        return 0;
+    }
+    uint64_t replacement = MappedLinkedList_alloc(self, &value); if(!replacement) { return -1; }
+    MappedLinkedList_link(self, replacement, offset);
+    MappedLinkedList_unlink(self, offset);
+    MappedLinkedList_free(self, offset);
+    MappedLinkedList_cache_store(self, replacement, object);
+    self->cursor = replacement;
+    self->cursor_pos = position;
+    self->mod_count += 1;
+    return 0;
+}
+
+// Iterator
+
+typedef struct
+{
+    PyObject_HEAD
+    MappedLinkedList* list;
+    uint64_t offset;
+    Py_ssize_t remaining;
+    size_t mod_count;
+    int forward;
+} MappedLinkedListIterator;
+
+// The lists hold no objects that could refer back to them, so iterators can't be part of a cycle
+static PyObject* MappedLinkedListIterator_new(MappedLinkedList* list, int forward)
+{
+    if(MappedLinkedList_check_open(list)) { return NULL; }
+    MappedLinkedListIterator* self = PyObject_New(MappedLinkedListIterator, &MappedLinkedListIteratorType);
+    if(!self) { return NULL; }
+    MappedHeader* header = MappedLinkedList_header(list);
+    self->list = (MappedLinkedList*)Py_NewRef((PyObject*)list);
+    self->offset = forward ? header->head : header->tail;
+    self->remaining = (Py_ssize_t)header->length;
+    self->mod_count = list->mod_count;
+    self->forward = forward;
+    return (PyObject*)self;
+}
+
+static void MappedLinkedListIterator_dealloc(PyObject* op)
+{
+    MappedLinkedListIterator* self = (MappedLinkedListIterator*)op;
+    Py_XDECREF(self->list);
+    PyObject_Del(self);
+}
+
+static PyObject* MappedLinkedListIterator_next(PyObject* op)
+{
+    MappedLinkedListIterator* self = (MappedLinkedListIterator*)op;
+    if(!self->list) { return NULL; }
+    if(self->list->mod_count != self->mod_count)
+    {
+        self->remaining = 0;
+        if(self->list->map) { PyErr_SetString(PyExc_RuntimeError, "MappedLinkedList changed during iteration"); }
+        else { MappedLinkedList_check_open(self->list); }
+        Py_CLEAR(self->list);
+        return NULL;
+    }
+    if(self->remaining == 0)
+    {
+        Py_CLEAR(self->list);
+        return NULL;
+    }
+    uint64_t offset = self->offset;
+    MappedNode* node = MappedLinkedList_node(self->list, offset);
+    self->offset = self->forward ? node->next : node->prev;
+    self->remaining -= 1;
+    return MappedLinkedList_value(self->list, offset);
+}
+
+static PyObject* MappedLinkedListIterator_length_hint(PyObject* op, PyObject* Py_UNUSED(dummy))
+{
+    MappedLinkedListIterator* self = (MappedLinkedListIterator*)op;
+    if(!self->list || self->list->mod_count != self->mod_count) { return PyLong_FromSsize_t(0); }
+    return PyLong_FromSsize_t(self->remaining);
+}
+
+static PyObject* MappedLinkedListIterator_next_unlocked(PyObject* op, PyObject* Py_UNUSED(dummy))
+{
+    return MappedLinkedListIterator_next(op);
+}
+
+static PyObject* MappedLinkedListIterator_next_locked(PyObject* op)
+{
+    PyObject** list = (PyObject**)&((MappedLinkedListIterator*)op)->list;
+    return DLLIterator_call_locked(op, list, MappedLinkedListIterator_next_unlocked);
+}
+
+static PyObject* MappedLinkedListIterator_length_hint_locked(PyObject* op, PyObject* Py_UNUSED(dummy))
+{
+    PyObject** list = (PyObject**)&((MappedLinkedListIterator*)op)->list;
+    return DLLIterator_call_locked(op, list, MappedLinkedListIterator_length_hint);
+}
+
+static PyObject* MappedLinkedList_iter(PyObject* op)
+{
+    return MappedLinkedListIterator_new((MappedLinkedList*)op, 1);
+}
+
+static PyObject* MappedLinkedList_reversed(PyObject* op, PyObject* Py_UNUSED(dummy))
+{
+    return MappedLinkedListIterator_new((MappedLinkedList*)op, 0);
+}
+
+static PyMethodDef MappedLinkedListIterator_methods[] = {
+    {"__length_hint__", (PyCFunction)MappedLinkedListIterator_length_hint_locked, METH_NOARGS,
+    "Private method returning an estimate of len(list(it))."},
+    {NULL, NULL, 0, NULL}
+};
+
+static PyTypeObject MappedLinkedListIteratorType =
+{
+    .ob_base = PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "py_doubly_linked_list.doubly_linked_list.MappedLinkedListIterator",
+    .tp_doc = PyDoc_STR("MappedLinkedList iterator"),
+    .tp_basicsize = sizeof(MappedLinkedListIterator),
+    .tp_itemsize = 0,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_dealloc = (destructor)MappedLinkedListIterator_dealloc,
+    .tp_iter = PyObject_SelfIter,
+    .tp_iternext = MappedLinkedListIterator_next_locked,
+    .tp_methods = MappedLinkedListIterator_methods
+};
+
+// Locked entry points
+
+DLL_LOCKED(int, MappedLinkedList_init, (PyObject* op, PyObject* args, PyObject* kwds), (op, args, kwds))
+DLL_LOCKED_KWARGS(MappedLinkedList_append)
+DLL_LOCKED_UNARY(MappedLinkedList_clear_method)
+DLL_LOCKED_UNARY(MappedLinkedList_close)
+DLL_LOCKED_UNARY(MappedLinkedList_enter)
+DLL_LOCKED_NOARGS(MappedLinkedList_exit)
+DLL_LOCKED_KWARGS(MappedLinkedList_extend)
+DLL_LOCKED_UNARY(MappedLinkedList_flush)
+DLL_LOCKED_KWARGS(MappedLinkedList_insert)
+DLL_LOCKED_KWARGS(MappedLinkedList_pop)
+DLL_LOCKED_NOARGS(MappedLinkedList_reversed)
+DLL_LOCKED_UNARY(MappedLinkedList_iter)
+DLL_LOCKED(PyObject*, MappedLinkedList_get_closed, (PyObject* op, void* closure), (op, closure))
+DLL_LOCKED(Py_ssize_t, MappedLinkedList_len, (PyObject* op), (op))
+DLL_LOCKED(PyObject*, MappedLinkedList_item, (PyObject* op, Py_ssize_t index), (op, index))
+DLL_LOCKED(int, MappedLinkedList_ass_item, (PyObject* op, Py_ssize_t index, PyObject* value), (op, index, value))
+DLL_LOCKED_BINARY(MappedLinkedList_subscript)
+DLL_LOCKED(int, MappedLinkedList_ass_subscript, (PyObject* op, PyObject* item, PyObject* value), (op, item, value))
+
+static PyMethodDef MappedLinkedList_methods[] = {
+    {"append", (PyCFunction)MappedLinkedList_append_locked, METH_VARARGS|METH_KEYWORDS,
+    "Append object to the end of the list. Set forward to false to append to the start."},
+    {"clear", (PyCFunction)MappedLinkedList_clear_method_locked, METH_NOARGS,
+    "Remove all items from the list and shrink the file back to its initial size."},
+    {"close", (PyCFunction)MappedLinkedList_close_locked, METH_NOARGS,
+    "Unmap and close the file. The list can't be used afterwards, reopen the file to get it back."},
+    {"extend", (PyCFunction)MappedLinkedList_extend_locked, METH_VARARGS|METH_KEYWORDS,
+    "Extend list by appending elements from the iterable. Set forward to false to extend from the start."},
+    {"flush", (PyCFunction)MappedLinkedList_flush_locked, METH_NOARGS,
+    "Write changes to the list through to the file on disk."},
+    {"insert", (PyCFunction)MappedLinkedList_insert_locked, METH_VARARGS|METH_KEYWORDS,
+     "Insert object after index. Set forward to false to insert before index."},
+    {"pop", (PyCFunction)MappedLinkedList_pop_locked, METH_VARARGS|METH_KEYWORDS,
+    "Remove and return item at index (default last).\nRaises IndexError if list is empty or index is out of range."},
+    {"__enter__", (PyCFunction)MappedLinkedList_enter_locked, METH_NOARGS,
+    "Return the list itself."},
+    {"__exit__", (PyCFunction)MappedLinkedList_exit_locked, METH_VARARGS,
+    "Close the list."},
+    {"__reversed__", (PyCFunction)MappedLinkedList_reversed_locked, METH_NOARGS,
+    "Return a reverse iterator over the list."},
+    {NULL, NULL, 0, NULL}
+};
+
+static PyGetSetDef MappedLinkedList_getset[] = {
+    {"closed", MappedLinkedList_get_closed_locked, NULL, "True once the list has been closed.", NULL},
+    {NULL}
+};
+
+static PyMappingMethods MappedLinkedList_mapping =
+{
+    .mp_subscript = MappedLinkedList_subscript_locked,
+    .mp_ass_subscript = MappedLinkedList_ass_subscript_locked
+};
+
+static PySequenceMethods MappedLinkedList_sequence =
+{
+    .sq_length = MappedLinkedList_len_locked,
+    .sq_item = MappedLinkedList_item_locked,
+    .sq_ass_item = MappedLinkedList_ass_item_locked
+};
+
+// Type Definition
+
+static PyTypeObject MappedLinkedListType =
+{
+    .ob_base = PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "py_doubly_linked_list.doubly_linked_list.MappedLinkedList",
+    .tp_doc = PyDoc_STR("MappedLinkedList class, a doubly linked list stored in a memory mapped file"),
+    .tp_basicsize = sizeof(MappedLinkedList),
+    .tp_itemsize = 0,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_new = (newfunc)MappedLinkedList_new,
+    .tp_init = MappedLinkedList_init_locked,
+    .tp_dealloc = (destructor)MappedLinkedList_dealloc,
+    .tp_iter = MappedLinkedList_iter_locked,
+    .tp_methods = MappedLinkedList_methods,
+    .tp_getset = MappedLinkedList_getset,
+    .tp_as_mapping = &MappedLinkedList_mapping,
+    .tp_as_sequence = &MappedLinkedList_sequence
+};
+
+// - - - - - LRUCache - - - - - //
+
+// Least recently used cache. Entries are DLLNodes chained from most to least recently used, with
+// the cache key kept in node->key and its hash in node->key_hash, and an open addressing table
+// maps keys to their nodes.
+
+#define LRU_MIN_TABLE 8
+#define LRU_PERTURB_SHIFT 5
+
+static DLLNode lru_dummy_node; // Marks deleted table slots
+#define LRU_DUMMY (&lru_dummy_node)
+
+typedef struct
+{
+    Py_hash_t hash;
+    DLLNode* node; // NULL for empty slots
+} LRUEntry;
+
+typedef struct
+{
+    PyObject_HEAD
+    DLLNode* head; // Most recently used
+    DLLNode* tail; // Least recently used
+    Py_ssize_t length;
+    Py_ssize_t maxsize; // -1 when unbounded
+    LRUEntry* table;
+    size_t mask;
+    Py_ssize_t fill; // Live and deleted slots
+    Py_ssize_t hits;
+    Py_ssize_t misses;
+    Py_ssize_t evictions;
+    PyObject* on_evict;
+} LRUCache;
+
+static PyTypeObject LRUCacheType;
+
+// Table helpers
+
+// Returns the slot holding key, -1 if it is not in the table or -2 on error
+static Py_ssize_t LRUCache_lookup(LRUCache* self, PyObject* key, Py_hash_t hash)
+{
+    LRUEntry* table;
+    size_t perturb, i;
+restart:
+    table = self->table;
+    perturb = (size_t)hash;
+    i = (size_t)hash & self->mask;
+    for(;;)
+    {
+        DLLNode* node = table[i].node;
+        if(!node) { return -1; }
+        if(node != LRU_DUMMY)
+        {
+            if(node->key == key) { return i; }
+            if(table[i].hash == hash)
+            {
+                PyObject* node_key = Py_NewRef(node->key);
+                int rslt = PyObject_RichCompareBool(node_key, key, Py_EQ);
+                Py_DECREF(node_key);
+                if(rslt == -1) { return -2; }
+                // The comparison ran python code, start over if it changed the table
+                if(table != self->table || table[i].node != node) { goto restart; }
+                if(rslt) { return i; }
+            }
+        }
+        perturb >>= LRU_PERTURB_SHIFT;
+        i = (i*5 + perturb + 1) & self->mask;
+    }
+}
+
+// Returns the slot holding node, found by identity so no python code runs
+static Py_ssize_t LRUCache_node_slot(LRUCache* self, DLLNode* node, Py_hash_t hash)
+{
+    size_t perturb = (size_t)hash;
+    size_t i = (size_t)hash & self->mask;
+    while(self->table[i].node != node)
+    {
+        perturb >>= LRU_PERTURB_SHIFT;
+        i = (i*5 + perturb + 1) & self->mask;
+    }
+    return i;
+}
+
+// Returns the first empty or deleted slot for hash
+static Py_ssize_t LRUCache_free_slot(LRUEntry* table, size_t mask, Py_hash_t hash)
+{
+    size_t perturb = (size_t)hash;
+    size_t i = (size_t)hash & mask;
+    while(table[i].node && table[i].node != LRU_DUMMY)
+    {
+        perturb >>= LRU_PERTURB_SHIFT;
+        i = (i*5 + perturb + 1) & mask;
+    }
+    return i;
+}
+
+// Rebuilds the table with room for used entries, dropping deleted slots
+static int LRUCache_resize(LRUCache* self, Py_ssize_t used)
+{
+    size_t size = LRU_MIN_TABLE;
+    while(size * 2 <= (size_t)used * 3) { size <<= 1; }
+    LRUEntry* table = PyMem_Calloc(size, sizeof(LRUEntry));
+    if(!table) { PyErr_NoMemory(); return -1; }
+    LRUEntry* old_table = self->table;
+    for(size_t i = 0; old_table && i <= self->mask; i++)
+    {
+        if(old_table[i].node && old_table[i].node != LRU_DUMMY)
+        {
+            table[LRUCache_free_slot(table, size - 1, old_table[i].hash)] = old_table[i];
+        }
+    }
+    PyMem_Free(old_table);
+    self->table = table;
+    self->mask = size - 1;
+    self->fill = self->length;
+    return 0;
+}
+
+// Chain helpers
+
+static void LRUCache_unlink(LRUCache* self, DLLNode* node)
+{
+    if(node->prev) { node->prev->next = node->next; } else { self->head = node->next; }
+    if(node->next) { node->next->prev = node->prev; } else { self->tail = node->prev; }
+    node->next = NULL;
+    node->prev = NULL;
+}
+
+static void LRUCache_push_front(LRUCache* self, DLLNode* node)
+{
+    node->prev = NULL;
+    node->next = self->head;
+    if(self->head) { self->head->prev = node; } else { self->tail = node; }
+    self->head = node;
+}
+
+static void LRUCache_move_to_front(LRUCache* self, DLLNode* node)
+{
+    if(node == self->head) { return; }
+    LRUCache_unlink(self, node);
+    LRUCache_push_front(self, node);
+}
+
+// Removes the entry in slot from the table and chain, the caller owns the returned node
+static DLLNode* LRUCache_take(LRUCache* self, Py_ssize_t slot)
+{
+    DLLNode* node = self->table[slot].node;
+    self->table[slot].node = LRU_DUMMY;
+    LRUCache_unlink(self, node);
+    self->length -= 1;
+    return node;
+}
+
+// Drops the least recently used entry. Its slot is found from the stored hash, so nothing can
+// fail before on_evict runs.
+static int LRUCache_evict(LRUCache* self)
+{
+    DLLNode* node = self->tail;
+    LRUCache_take(self, LRUCache_node_slot(self, node, node->key_hash));
+    self->evictions += 1;
+    int rslt = 0;
+    if(self->on_evict)
+    {
+        PyObject* callback = Py_NewRef(self->on_evict);
+        PyObject* result = PyObject_CallFunctionObjArgs(callback, node->key, node->value, NULL);
+        Py_DECREF(callback);
+        if(!result) { rslt = -1; }
+        Py_XDECREF(result);
+    }
+    DLLNode_dealloc(node);
+    return rslt;
+}
+
+// Looks key up and marks it as most recently used. Returns a borrowed value, NULL with no error set on a miss
+static PyObject* LRUCache_get_item(LRUCache* self, PyObject* key)
+{
+    Py_hash_t hash = PyObject_Hash(key); if(hash == -1) { return NULL; }
+    Py_ssize_t slot = LRUCache_lookup(self, key, hash);
+    if(slot == -2) { return NULL; }
+    if(slot == -1)
+    {
+        self->misses += 1;
+        return NULL;
+    }
+    self->hits += 1;
+    DLLNode* node = self->table[slot].node;
+    LRUCache_move_to_front(self, node);
+    return node->value;
+}
+
+static int LRUCache_put_item(LRUCache* self, PyObject* key, PyObject* value)
+{
+    Py_hash_t hash = PyObject_Hash(key); if(hash == -1) { return -1; }
+    if(self->maxsize == 0) { return 0; }
+    Py_ssize_t slot = LRUCache_lookup(self, key, hash);
+    if(slot == -2) { return -1; }
+    if(slot >= 0)
+    {
+        // Move first, releasing the old value can run python code
+        DLLNode* node = self->table[slot].node;
+        LRUCache_move_to_front(self, node);
+        Py_SETREF(node->value, Py_NewRef(value));
+        return 0;
+    }
+    if((size_t)(self->fill + 1) * 3 >= (self->mask + 1) * 2)
+    {
+        // Grow while filling up, a full bounded cache only needs its deleted slots cleared
+        Py_ssize_t used = self->length + 1;
+        if(self->maxsize < 0 || used < self->maxsize) { used *= 2; }
+        if(LRUCache_resize(self, used)) { return -1; }
+    }
+    DLLNode* node = DLLNode_new(); if(!node) { return -1; }
+    Py_SETREF(node->value, Py_NewRef(value));
+    node->key = Py_NewRef(key);
+    node->key_hash = hash;
+    slot = LRUCache_free_slot(self->table, self->mask, hash);
+    if(!self->table[slot].node) { self->fill += 1; }
+    self->table[slot].hash = hash;
+    self->table[slot].node = node;
+    LRUCache_push_front(self, node);
+    self->length += 1;
+    if(self->maxsize >= 0 && self->length > self->maxsize) { return LRUCache_evict(self); }
+    return 0;
+}
+
+static int LRUCache_del_item(LRUCache* self, PyObject* key)
+{
+    Py_hash_t hash = PyObject_Hash(key); if(hash == -1) { return -1; }
+    Py_ssize_t slot = LRUCache_lookup(self, key, hash);
+    if(slot == -2) { return -1; }
+    if(slot == -1) { PyErr_SetObject(PyExc_KeyError, key); return -1; }
+    DLLNode_dealloc(LRUCache_take(self, slot));
+    return 0;
+}
+
+// Initialization and deallocation
+
+static PyObject* LRUCache_new(PyTypeObject* type, PyObject* args, PyObject* kwds)
+{
+    LRUCache* self = (LRUCache*)type->tp_alloc(type, 0);
+    if(self)
+    {
+        self->head = NULL;
+        self->tail = NULL;
+        self->length = 0;
+        self->maxsize = -1;
+        self->table = NULL;
+        self->mask = 0;
+        self->fill = 0;
+        self->hits = 0;
+        self->misses = 0;
+        self->evictions = 0;
+        self->on_evict = NULL;
+        if(LRUCache_resize(self, 0)) { Py_DECREF(self); return NULL; }
+    }
+    return (PyObject*)self;
+}
+
+static int LRUCache_init(PyObject* op, PyObject* args, PyObject* kwds)
+{
+    LRUCache* self = (LRUCache*)op;
+    static char* kwlist[] = {"maxsize", "on_evict", NULL};
+    PyObject* maxsize;
+    PyObject* on_evict = NULL;
+    if(!PyArg_ParseTupleAndKeywords(args, kwds, "O|O", kwlist, &maxsize, &on_evict)) { return -1; }
+    if(Py_IsNone(maxsize)) { self->maxsize = -1; }
+    else
+    {
+        Py_ssize_t size = PyLong_AsSsize_t(maxsize); if(size == -1 && PyErr_Occurred()) { return -1; }
+        if(size < 0) { PyErr_SetString(PyExc_ValueError, "maxsize must be at least 0 or None"); return -1; }
+        self->maxsize = size;
+    }
+    if(on_evict && Py_IsNone(on_evict)) { on_evict = NULL; }
+    if(on_evict && !PyCallable_Check(on_evict)) { PyErr_SetString(PyExc_TypeError, "on_evict must be a callable"); return -1; }
+    Py_XSETREF(self->on_evict, Py_XNewRef(on_evict));
+    return 0;
+}
+
+static void LRUCache_dealloc(PyObject* op)
+{
+    LRUCache* self = (LRUCache*)op;
+    PyObject_GC_UnTrack(op);
+    Py_TRASHCAN_BEGIN(op, LRUCache_dealloc)
+    if(self->head) { DLLNode_dealloc_chain(self->head); }
+    PyMem_Free(self->table);
+    Py_XDECREF(self->on_evict);
+    Py_TYPE(self)->tp_free(self);
+    Py_TRASHCAN_END
+}
+
+static int LRUCache_traverse(PyObject* op, visitproc visit, void* arg)
+{
+    LRUCache* self = (LRUCache*)op;
+    for(DLLNode* node = self->head; node; node = node->next)
+    {
+        Py_VISIT(node->key);
+        Py_VISIT(node->value);
+    }
+    Py_VISIT(self->on_evict);
+    return 0;
+}
+
+// Drops every entry without calling on_evict. The table is emptied in place since this can't fail.
+static int LRUCache_clear(PyObject* op)
+{
+    LRUCache* self = (LRUCache*)op;
+    DLLNode* head = self->head;
+    self->head = NULL;
+    self->tail = NULL;
+    self->length = 0;
+    memset(self->table, 0, (self->mask + 1) * sizeof(LRUEntry));
+    self->fill = 0;
+    Py_CLEAR(self->on_evict);
+    if(head) { DLLNode_dealloc_chain(head); }
+    return 0;
+}
+
+// Methods
+
+static PyObject* LRUCache_get(PyObject* op, PyObject* args, PyObject* kwds)
+{
+    LRUCache* self = (LRUCache*)op;
+    static char* kwlist[] = {"key", "default", NULL};
+    PyObject* key;
+    PyObject* default_value = Py_None;
+    if(!PyArg_ParseTupleAndKeywords(args, kwds, "O|O", kwlist, &key, &default_value)) { return NULL; }
+    PyObject* value = LRUCache_get_item(self, key);
+    if(!value)
+    {
+        if(PyErr_Occurred()) { return NULL; }
+        return Py_NewRef(default_value);
+    }
+    return Py_NewRef(value);
+}
+
+static PyObject* LRUCache_put(PyObject* op, PyObject* args, PyObject* kwds)
+{
+    static char* kwlist[] = {"key", "value", NULL};
+    PyObject* key;
+    PyObject* value;
+    if(!PyArg_ParseTupleAndKeywords(args, kwds, "OO", kwlist, &key, &value)) { return NULL; }
+    if(LRUCache_put_item((LRUCache*)op, key, value)) { return NULL; }
+    return Py_NewRef(Py_None);
+}
+
+static PyObject* LRUCache_peek(PyObject* op, PyObject* args, PyObject* kwds)
+{
+    LRUCache* self = (LRUCache*)op;
+    static char* kwlist[] = {"key", "default", NULL};
+    PyObject* key;
+    PyObject* default_value = Py_None;
+    if(!PyArg_ParseTupleAndKeywords(args, kwds, "O|O", kwlist, &key, &default_value)) { return NULL; }
+    Py_hash_t hash = PyObject_Hash(key); if(hash == -1) { return NULL; }
+    Py_ssize_t slot = LRUCache_lookup(self, key, hash);
+    if(slot == -2) { return NULL; }
+    if(slot == -1) { return Py_NewRef(default_value); }
+    return Py_NewRef(self->table[slot].node->value);
+}
+
+static PyObject* LRUCache_pop(PyObject* op, PyObject* args, PyObject* kwds)
+{
+    LRUCache* self = (LRUCache*)op;
+    static char* kwlist[] = {"key", "default", NULL};
+    PyObject* key;
+    PyObject* default_value = NULL;
+    if(!PyArg_ParseTupleAndKeywords(args, kwds, "O|O", kwlist, &key, &default_value)) { return NULL; }
+    Py_hash_t hash = PyObject_Hash(key); if(hash == -1) { return NULL; }
+    Py_ssize_t slot = LRUCache_lookup(self, key, hash);
+    if(slot == -2) { return NULL; }
+    if(slot == -1)
+    {
+        if(default_value) { return Py_NewRef(default_value); }
+        PyErr_SetObject(PyExc_KeyError, key);
+        return NULL;
+    }
+    DLLNode* node = LRUCache_take(self, slot);
+    PyObject* value = Py_NewRef(node->value);
+    DLLNode_dealloc(node);
+    return value;
+}
+
+// The empty table is allocated before anything is detached, so a MemoryError leaves the cache whole
+static PyObject* LRUCache_clear_method(PyObject* op, PyObject* Py_UNUSED(dummy))
+{
+    LRUCache* self = (LRUCache*)op;
+    LRUEntry* table = PyMem_Calloc(LRU_MIN_TABLE, sizeof(LRUEntry));
+    if(!table) { PyErr_NoMemory(); return NULL; }
+    DLLNode* head = self->head;
+    self->head = NULL;
+    self->tail = NULL;
+    self->length = 0;
+    PyMem_Free(self->table);
+    self->table = table;
+    self->mask = LRU_MIN_TABLE - 1;
+    self->fill = 0;
+    if(head) { DLLNode_dealloc_chain(head); }
+    return Py_NewRef(Py_None);
+}
+
+// Builds a list from most to least recently used, item selects keys (0), values (1) or pairs (2)
+static PyObject* LRUCache_collect(LRUCache* self, int item)
+{
+    PyObject* list = PyList_New(self->length); if(!list) { return NULL; }
+    Py_ssize_t i = 0;
+    for(DLLNode* node = self->head; node; node = node->next)
+    {
+        PyObject* entry;
+        if(item == 0) { entry = Py_NewRef(node->key); }
+        else if(item == 1) { entry = Py_NewRef(node->value); }
+        else
+        {
+            entry = PyTuple_Pack(2, node->key, node->value);
+            if(!entry) { Py_DECREF(list); return NULL; }
+        }
+        PyList_SET_ITEM(list, i++, entry);
+    }
+    return list;
+}
+
+static PyObject* LRUCache_keys(PyObject* op, PyObject* Py_UNUSED(dummy))
+{
+    return LRUCache_collect((LRUCache*)op, 0);
+}
+
+static PyObject* LRUCache_values(PyObject* op, PyObject* Py_UNUSED(dummy))
+{
+    return LRUCache_collect((LRUCache*)op, 1);
+}
+
+static PyObject* LRUCache_items(PyObject* op, PyObject* Py_UNUSED(dummy))
+{
+    return LRUCache_collect((LRUCache*)op, 2);
+}
+
+static PyObject* LRUCache_get_maxsize(PyObject* op, void* closure)
+{
+    LRUCache* self = (LRUCache*)op;
+    if(self->maxsize < 0) { return Py_NewRef(Py_None); }
+    return PyLong_FromSsize_t(self->maxsize);
+}
+
+static PyObject* LRUCache_get_on_evict(PyObject* op, void* closure)
+{
+    LRUCache* self = (LRUCache*)op;
+    return Py_NewRef(self->on_evict ? self->on_evict : Py_None);
+}
+
+static int LRUCache_set_on_evict(PyObject* op, PyObject* value, void* closure)
+{
+    LRUCache* self = (LRUCache*)op;
+    if(value && Py_IsNone(value)) { value = NULL; }
+    if(value && !PyCallable_Check(value)) { PyErr_SetString(PyExc_TypeError, "on_evict must be a callable"); return -1; }
+    Py_XSETREF(self->on_evict, Py_XNewRef(value));
+    return 0;
+}
+
+// Mapping Methods
+
+static Py_ssize_t LRUCache_len(PyObject* op)
+{
+    return ((LRUCache*)op)->length;
+}
+
+static PyObject* LRUCache_subscript(PyObject* op, PyObject* key)
+{
+    PyObject* value = LRUCache_get_item((LRUCache*)op, key);
+    if(!value)
+    {
+        if(!PyErr_Occurred()) { PyErr_SetObject(PyExc_KeyError, key); }
+        return NULL;
+    }
+    return Py_NewRef(value);
+}
+
+static int LRUCache_ass_subscript(PyObject* op, PyObject* key, PyObject* value)
+{
+    if(!value) { return LRUCache_del_item((LRUCache*)op, key); }
+    return LRUCache_put_item((LRUCache*)op, key, value);
+}
+
+// Checks membership without counting a hit or changing the order
+static int LRUCache_contains(PyObject* op, PyObject* key)
+{
+    LRUCache* self = (LRUCache*)op;
+    Py_hash_t hash = PyObject_Hash(key); if(hash == -1) { return -1; }
+    Py_ssize_t slot = LRUCache_lookup(self, key, hash);
+    if(slot == -2) { return -1; }
+    return slot >= 0;
+}
+
+// __Methods__
+
+static PyObject* LRUCache_repr(PyObject* op)
+{
+    LRUCache* self = (LRUCache*)op;
+    if(self->maxsize < 0) { return PyUnicode_FromFormat("LRUCache(maxsize=None, currsize=%zd)", self->length); }
+    return PyUnicode_FromFormat("LRUCache(maxsize=%zd, currsize=%zd)", self->maxsize, self->length);
+}
+
+// Locked entry points
+
+DLL_LOCKED(int, LRUCache_init, (PyObject* op, PyObject* args, PyObject* kwds), (op, args, kwds))
+DLL_LOCKED_KWARGS(LRUCache_get)
+DLL_LOCKED_KWARGS(LRUCache_put)
+DLL_LOCKED_KWARGS(LRUCache_peek)
+DLL_LOCKED_KWARGS(LRUCache_pop)
+DLL_LOCKED_NOARGS(LRUCache_clear_method)
+DLL_LOCKED_NOARGS(LRUCache_keys)
+DLL_LOCKED_NOARGS(LRUCache_values)
+DLL_LOCKED_NOARGS(LRUCache_items)
+DLL_LOCKED(PyObject*, LRUCache_get_maxsize, (PyObject* op, void* closure), (op, closure))
+DLL_LOCKED(PyObject*, LRUCache_get_on_evict, (PyObject* op, void* closure), (op, closure))
+DLL_LOCKED(int, LRUCache_set_on_evict, (PyObject* op, PyObject* value, void* closure), (op, value, closure))
+DLL_LOCKED(Py_ssize_t, LRUCache_len, (PyObject* op), (op))
+DLL_LOCKED_BINARY(LRUCache_subscript)
+DLL_LOCKED(int, LRUCache_ass_subscript, (PyObject* op, PyObject* key, PyObject* value), (op, key, value))
+DLL_LOCKED(int, LRUCache_contains, (PyObject* op, PyObject* key), (op, key))
+DLL_LOCKED_UNARY(LRUCache_repr)
+
+static PyMethodDef LRUCache_methods[] = {
+    {"get", (PyCFunction)LRUCache_get_locked, METH_VARARGS|METH_KEYWORDS,
+    "Return the value for key and mark it as most recently used, or default if key is not cached."},
+    {"put", (PyCFunction)LRUCache_put_locked, METH_VARARGS|METH_KEYWORDS,
+    "Cache value under key as the most recently used entry, evicting the least recently used entry if the cache is full."},
+    {"peek", (PyCFunction)LRUCache_peek_locked, METH_VARARGS|METH_KEYWORDS,
+    "Return the value for key without changing the order or the counters, or default if key is not cached."},
+    {"pop", (PyCFunction)LRUCache_pop_locked, METH_VARARGS|METH_KEYWORDS,
+    "Remove key and return its value, or default if given.\nRaises KeyError if key is not cached and no default is given."},
+    {"clear", (PyCFunction)LRUCache_clear_method_locked, METH_NOARGS,
+    "Remove all entries from the cache. The counters are kept."},
+    {"keys", (PyCFunction)LRUCache_keys_locked, METH_NOARGS,
+    "Return a list of the cached keys from most to least recently used."},
+    {"values", (PyCFunction)LRUCache_values_locked, METH_NOARGS,
+    "Return a list of the cached values from most to least recently used."},
+    {"items", (PyCFunction)LRUCache_items_locked, METH_NOARGS,
+    "Return a list of (key, value) pairs from most to least recently used."},
+    {NULL, NULL, 0, NULL}
+};
+
+static PyMemberDef LRUCache_members[] = {
+    {"hits", T_PYSSIZET, offsetof(LRUCache, hits), READONLY, "Number of lookups that found their key."},
+    {"misses", T_PYSSIZET, offsetof(LRUCache, misses), READONLY, "Number of lookups that did not find their key."},
+    {"evictions", T_PYSSIZET, offsetof(LRUCache, evictions), READONLY, "Number of entries evicted to make room."},
+    {NULL}
+};
+
+static PyGetSetDef LRUCache_getset[] = {
+    {"maxsize", LRUCache_get_maxsize_locked, NULL, "Maximum number of entries, None if unbounded.", NULL},
+    {"on_evict", LRUCache_get_on_evict_locked, LRUCache_set_on_evict_locked,
+    "Callable invoked with (key, value) for every evicted entry, or None.", NULL},
+    {NULL}
+};
+
+static PyMappingMethods LRUCache_map =
+{
+    .mp_length = LRUCache_len_locked,
+    .mp_subscript = LRUCache_subscript_locked,
+    .mp_ass_subscript = LRUCache_ass_subscript_locked
+};
+
+static PySequenceMethods LRUCache_sequence =
+{
+    .sq_contains = LRUCache_contains_locked
+};
+
+// Type Definition
+
+static PyTypeObject LRUCacheType =
+{
+    .ob_base = PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "py_doubly_linked_list.doubly_linked_list.LRUCache",
+    .tp_doc = PyDoc_STR("Least recently used cache backed by a doubly linked list and a hash table"),
+    .tp_basicsize = sizeof(LRUCache),
+    .tp_itemsize = 0,
+    .tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC,
+    .tp_new = (newfunc)LRUCache_new,
+    .tp_init = LRUCache_init_locked,
+    .tp_dealloc = (destructor)LRUCache_dealloc,
+    .tp_traverse = LRUCache_traverse,
+    .tp_clear = LRUCache_clear,
+    .tp_repr = LRUCache_repr_locked,
+    .tp_methods = LRUCache_methods,
+    .tp_members = LRUCache_members,
+    .tp_getset = LRUCache_getset,
+    .tp_as_sequence = &LRUCache_sequence,
+    .tp_as_mapping = &LRUCache_map
+};
+
+// - - - - - LinkedQueue - - - - - //
+
+// FIFO queue for passing items between threads. Items are DLLNodes appended at the tail and taken
+// from the head. Blocked callers wait on a PyThread lock with the GIL released, the locks are used
+// as wake up signals like queue.SimpleQueue does: a waiter acquires the lock and checks again, and
+// whoever changes the queue releases it so the next waiter can check. not_empty wakes getters and
+// not_full wakes putters of a bounded queue.
+
+typedef struct
+{
+    PyObject_HEAD
+    DLLNode* head; // Oldest item, taken first
+    DLLNode* tail;
+    Py_ssize_t length;
+    Py_ssize_t maxsize; // 0 when unbounded
+    PyThread_type_lock not_empty;
+    PyThread_type_lock not_full;
+    int not_empty_held; // Set while a waiter holds not_empty
+    int not_full_held;
+} LinkedQueue;
+
+static PyTypeObject LinkedQueueType;
+
+static PyObject* queue_empty_error; // queue.Empty
+static PyObject* queue_full_error; // queue.Full
+
+// Internal Methods
+
+// Releases lock if a waiter holds it so the next waiter can check the queue
+static void LinkedQueue_wake(PyThread_type_lock lock, int* held)
+{
+    if(*held)
     {
-        (cursor->next)->prev = cursor->prev;
-        self->cursor = cursor->next;
-        if(cursor->prev == NULL) { self->head = cursor->next; }
-        else { (cursor->prev)->next = cursor->next; }
+        PyThread_release_lock(lock);
+        *held = 0;
     }
-    DLLNode_dealloc(cursor);
-    return 0;
 }
 
-static int DoublyLinkedList_append_iterator(PyObject* op, PyObject* iterable, int forward)
+// Converts block and timeout into microseconds to wait, -1 to wait forever
+static int LinkedQueue_timeout(int block, PyObject* timeout, PY_TIMEOUT_T* microseconds)
 {
-    DoublyLinkedList* self = (DoublyLinkedList*)op;
-    PyObject* iterator = PyObject_GetIter(iterable); if(!iterator) { return -1; }
-    if(forward)
-    { 
-        self->cursor = self->tail; self->cursor_pos = self->length-1;
-        if(self->cursor_pos<0) { self->cursor_pos=0; }
-    }
-    else { self->cursor = self->head; self->cursor_pos = 0; }
-    PyObject* item;
-    while((item = PyIter_Next(iterator)) != NULL)
-    {
-        if(DoublyLinkedList_cursor_insert((PyObject*)self, item, forward)) { return -1; }
-        Py_DECREF(item);
-    }
-    if(PyErr_Occurred())
+    *microseconds = 0;
+    if(!block) { return 0; }
+    *microseconds = -1;
+    if(!timeout || Py_IsNone(timeout)) { return 0; }
+    double seconds = PyFloat_AsDouble(timeout); if(seconds == -1 && PyErr_Occurred()) { return -1; }
+    if(seconds < 0)
     {
-        Py_XDECREF(iterator);
+        PyErr_SetString(PyExc_ValueError, "'timeout' must be a non-negative number");
         return -1;
     }
-    Py_XDECREF(iterator);
+    double limit = (double)PY_TIMEOUT_MAX;
+    *microseconds = seconds * 1e6 >= limit ? PY_TIMEOUT_MAX - 1 : (PY_TIMEOUT_T)(seconds * 1e6);
     return 0;
 }
 
-static PyObject* DoublyLinkedList_rich_compare(PyObject* self, PyObject* other, int op)
+// Blocks until ready returns true or the timeout runs out. Returns 1 once ready, 0 on timeout and
+// -1 if a signal handler raised.
+static int LinkedQueue_wait(LinkedQueue* self, int (*ready)(LinkedQueue*), PyThread_type_lock lock, int* held, PY_TIMEOUT_T microseconds)
 {
-    if(op == Py_NE)
+    PyTime_t deadline = 0;
+    if(microseconds > 0)
+    {
+        PyTime_t now;
+        if(PyTime_Monotonic(&now)) { return -1; }
+        deadline = now + (PyTime_t)microseconds * 1000;
+    }
+    while(!ready(self))
     {
-        PyObject* result = DoublyLinkedList_rich_compare(self, other, Py_EQ);
-        if(result == Py_False)
+        PyLockStatus rslt = PyThread_acquire_lock_timed(lock, 0, 0);
+        if(rslt == PY_LOCK_FAILURE && microseconds != 0)
         {
-            Py_DECREF(Py_False);
-            Py_RETURN_TRUE;
+            Py_BEGIN_ALLOW_THREADS
+            rslt = PyThread_acquire_lock_timed(lock, microseconds, 1);
+            Py_END_ALLOW_THREADS
         }
-        else if(result == Py_True)
+        if(rslt == PY_LOCK_INTR)
         {
-            Py_DECREF(Py_True);
-            Py_RETURN_FALSE;
+            if(Py_MakePendingCalls() < 0) { return -1; }
+        }
+        else if(rslt == PY_LOCK_FAILURE) { return 0; }
+        else { *held = 1; }
+        if(microseconds > 0)
+        {
+            PyTime_t now;
+            if(PyTime_Monotonic(&now)) { return -1; }
+            microseconds = (PY_TIMEOUT_T)((deadline - now) / 1000);
+            if(microseconds <= 0 && !ready(self)) { return 0; }
         }
-        return NULL;
-    }
-    if(op != Py_EQ)
-    {
-        return Py_NotImplemented;
     }
-    PyObject* iterator = PyObject_GetIter(other);
-    if(!iterator) { return Py_False; }
-    DLLNode* temp_node = ((DoublyLinkedList*)self)->head;
-    PyObject* temp_iter;
-    while(temp_node)
+    return 1;
+}
+
+static int LinkedQueue_has_items(LinkedQueue* self)
+{
+    return self->length > 0;
+}
+
+static int LinkedQueue_has_room(LinkedQueue* self)
+{
+    return self->maxsize <= 0 || self->length < self->maxsize;
+}
+
+static int LinkedQueue_put_item(LinkedQueue* self, PyObject* item, int block, PyObject* timeout)
+{
+    PY_TIMEOUT_T microseconds;
+    if(LinkedQueue_timeout(block, timeout, &microseconds)) { return -1; }
+    int rslt = LinkedQueue_wait(self, LinkedQueue_has_room, self->not_full, &self->not_full_held, microseconds);
+    if(rslt == -1) { return -1; }
+    if(rslt == 0) { PyErr_SetNone(queue_full_error); return -1; }
+    DLLNode* node = DLLNode_new(); if(!node) { return -1; }
+    Py_SETREF(node->value, Py_NewRef(item));
+    node->prev = self->tail;
+    if(self->tail) { self->tail->next = node; } else { self->head = node; }
+    self->tail = node;
+    self->length += 1;
+    LinkedQueue_wake(self->not_full, &self->not_full_held);
+    LinkedQueue_wake(self->not_empty, &self->not_empty_held);
+    return 0;
+}
+
+// Takes up to count items off the head once there is at least one, returns them as a detached chain
+static DLLNode* LinkedQueue_take(LinkedQueue* self, Py_ssize_t count, int block, PyObject* timeout, Py_ssize_t* taken)
+{
+    PY_TIMEOUT_T microseconds;
+    if(LinkedQueue_timeout(block, timeout, &microseconds)) { return NULL; }
+    int rslt = LinkedQueue_wait(self, LinkedQueue_has_items, self->not_empty, &self->not_empty_held, microseconds);
+    if(rslt == -1) { return NULL; }
+    if(rslt == 0) { PyErr_SetNone(queue_empty_error); return NULL; }
+    if(count > self->length) { count = self->length; }
+    DLLNode* first = self->head;
+    DLLNode* last = first;
+    for(Py_ssize_t i = 1; i < count; i++) { last = last->next; }
+    self->head = last->next;
+    if(self->head) { self->head->prev = NULL; } else { self->tail = NULL; }
+    last->next = NULL;
+    self->length -= count;
+    *taken = count;
+    LinkedQueue_wake(self->not_empty, &self->not_empty_held);
+    LinkedQueue_wake(self->not_full, &self->not_full_held);
+    return first;
+}
+
+// Initialization and deallocation
+
+static PyObject* LinkedQueue_new(PyTypeObject* type, PyObject* args, PyObject* kwds)
+{
+    LinkedQueue* self = (LinkedQueue*)type->tp_alloc(type, 0);
+    if(self)
     {
-        temp_iter = PyIter_Next(iterator);
-        if(!temp_iter)
+        self->head = NULL;
+        self->tail = NULL;
+        self->length = 0;
+        self->maxsize = 0;
+        self->not_empty_held = 0;
+        self->not_full_held = 0;
+        self->not_empty = PyThread_allocate_lock();
+        self->not_full = PyThread_allocate_lock();
+        if(!self->not_empty || !self->not_full)
         {
-            if(PyErr_Occurred())
-            {
-                Py_XDECREF(iterator);
-                return NULL;
-            }
-            Py_RETURN_FALSE;
+            Py_DECREF(self);
+            PyErr_SetString(PyExc_MemoryError, "can't allocate lock");
+            return NULL;
         }
-        int rslt = PyObject_RichCompareBool(temp_node->value, temp_iter, Py_EQ); if(rslt == -1) { return NULL; }
-        if(!rslt) { Py_RETURN_FALSE; }
-        temp_node = temp_node->next;
     }
-    temp_iter = PyIter_Next(iterator);
-    if(temp_iter)
+    return (PyObject*)self;
+}
+
+static int LinkedQueue_init(PyObject* op, PyObject* args, PyObject* kwds)
+{
+    LinkedQueue* self = (LinkedQueue*)op;
+    static char* kwlist[] = {"maxsize", NULL};
+    Py_ssize_t maxsize = 0;
+    if(!PyArg_ParseTupleAndKeywords(args, kwds, "|n", kwlist, &maxsize)) { return -1; }
+    self->maxsize = maxsize;
+    return 0;
+}
+
+static void LinkedQueue_dealloc(PyObject* op)
+{
+    LinkedQueue* self = (LinkedQueue*)op;
+    PyObject_GC_UnTrack(op);
+    Py_TRASHCAN_BEGIN(op, LinkedQueue_dealloc)
+    if(self->head) { DLLNode_dealloc_chain(self->head); }
+    if(self->not_empty)
     {
-        Py_RETURN_FALSE;
+        LinkedQueue_wake(self->not_empty, &self->not_empty_held);
+        PyThread_free_lock(self->not_empty);
     }
-    else if(PyErr_Occurred())
+    if(self->not_full)
     {
-        Py_XDECREF(iterator);
-        return NULL;
+        LinkedQueue_wake(self->not_full, &self->not_full_held);
+        PyThread_free_lock(self->not_full);
     }
-    Py_RETURN_TRUE;
+    Py_TYPE(self)->tp_free(self);
+    Py_TRASHCAN_END
 }
 
-// Mapping Methods
-
-static PyObject* DoublyLinkedList_subscript(PyObject* op, PyObject* slice){
-    DoublyLinkedList* self = (DoublyLinkedList*)op;
-    if(PySlice_Check(slice))
-    {
-        Py_ssize_t start, stop, step;
-        DoublyLinkedList* list_slice = (DoublyLinkedList*)DoublyLinkedList_new(&DoublyLinkedListType, NULL, NULL); if(!list_slice) { return NULL; }
-        DLLNode* temp;
-        if(PySlice_Unpack(slice, &start, &stop, &step) == -1) { return NULL; }
-        if(start < 0) { start = self->length + start; }
-        if(stop < 0) { stop = self->length + stop; } if(stop > self->length) { stop = self->length; }
-        if(step > 0)
-        {
-            for(Py_ssize_t i = start; i < stop; i+=step)
-            {
-                if(DoublyLinkedList_locate((PyObject*)self, i)) { return NULL; }
-                temp = self->cursor;
-                if(DoublyLinkedList_cursor_insert((PyObject*)list_slice, temp->value, 1)) { return NULL; }
-            }
-        }
-        if(step < 0)
-        {
-            for(Py_ssize_t i = start; i > stop; i+=step)
-            {
-                if(DoublyLinkedList_locate((PyObject*)self, i)) { return NULL; }
-                temp = self->cursor;
-                if(DoublyLinkedList_cursor_insert((PyObject*)list_slice, temp->value, 1)) { return NULL; }
-            }
-        }
-        return (PyObject*)list_slice;
-    }
-    else if(PyLong_Check(slice))
+static int LinkedQueue_traverse(PyObject* op, visitproc visit, void* arg)
+{
+    for(DLLNode* node = ((LinkedQueue*)op)->head; node; node = node->next)
     {
-        Py_ssize_t index = PyLong_AsSsize_t(slice); if(index == -1 && PyErr_Occurred()) { return NULL; }
-        if(DoublyLinkedList_locate((PyObject*)self, index)) { return NULL; }
-        DLLNode* cursor = self->cursor;
-        return Py_NewRef(cursor->value);
+        Py_VISIT(node->value);
     }
-    else { PyErr_SetString(PyExc_TypeError, "Index must be an integer or slice"); return NULL; }
+    return 0;
 }
 
-// Sequence Methods 
+static int LinkedQueue_clear(PyObject* op)
+{
+    LinkedQueue* self = (LinkedQueue*)op;
+    DLLNode* head = self->head;
+    self->head = NULL;
+    self->tail = NULL;
+    self->length = 0;
+    if(head) { DLLNode_dealloc_chain(head); }
+    return 0;
+}
 
-static Py_ssize_t DoublyLinkedList_len(PyObject* op, PyObject* args, PyObject* kwds)
+// Methods
+
+static PyObject* LinkedQueue_put(PyObject* op, PyObject* args, PyObject* kwds)
 {
-    DoublyLinkedList* self = (DoublyLinkedList*)op;
-    return self->length;
+    static char* kwlist[] = {"item", "block", "timeout", NULL};
+    PyObject* item;
+    int block = 1;
+    PyObject* timeout = Py_None;
+    // Skip argument parsing for the common put(item)
+    if(!kwds && PyTuple_GET_SIZE(args) == 1) { item = PyTuple_GET_ITEM(args, 0); }
+    else if(!PyArg_ParseTupleAndKeywords(args, kwds, "O|pO", kwlist, &item, &block, &timeout)) { return NULL; }
+    if(LinkedQueue_put_item((LinkedQueue*)op, item, block, timeout)) { return NULL; }
+    return Py_NewRef(Py_None);
 }
 
-static PyObject* DoublyLinkedList_item(PyObject* op, Py_ssize_t index)
+static PyObject* LinkedQueue_put_nowait(PyObject* op, PyObject* item)
 {
-    DoublyLinkedList* self = (DoublyLinkedList*)op;
-    if(DoublyLinkedList_locate((PyObject*)self, index)) { return NULL; }
-    DLLNode* cursor = self->cursor;
-    return Py_NewRef(cursor->value);
+    if(LinkedQueue_put_item((LinkedQueue*)op, item, 0, NULL)) { return NULL; }
+    return Py_NewRef(Py_None);
 }
 
-static int DoublyLinkedList_ass_item(PyObject* op, Py_ssize_t index, PyObject* value)
+static PyObject* LinkedQueue_get_item(LinkedQueue* self, int block, PyObject* timeout)
 {
-    DoublyLinkedList* self = (DoublyLinkedList*)op;
-    if(DoublyLinkedList_locate((PyObject*)self, index)) { return -1; }
-    if(!value)
-    {
-        if(DoublyLinkedList_cursor_delete((PyObject*)self)) { return -1; }
-        return 0;
-    }
-    DLLNode* cursor = self->cursor;
-    Py_SETREF(cursor->value, Py_NewRef(value));
-    return 0;
+    Py_ssize_t taken;
+    DLLNode* node = LinkedQueue_take(self, 1, block, timeout, &taken); if(!node) { return NULL; }
+    PyObject* item = node->value; // The reference moves to the caller
+    node->value = NULL;
+    DLLNode_dealloc(node);
+    return item;
 }
 
-static PyObject* DoublyLinkedList_concat(PyObject* op, PyObject* concat)
+static PyObject* LinkedQueue_get(PyObject* op, PyObject* args, PyObject* kwds)
 {
-    PyObject* new_list = DoublyLinkedList_new(&DoublyLinkedListType, NULL, NULL); if(new_list == NULL) { return NULL; }
-    if(DoublyLinkedList_append_iterator(new_list, op, 1)) { return NULL; }
-    if(DoublyLinkedList_append_iterator(new_list, concat, 1)) { return NULL; }
-    return new_list;
+    static char* kwlist[] = {"block", "timeout", NULL};
+    int block = 1;
+    PyObject* timeout = Py_None;
+    if((kwds || PyTuple_GET_SIZE(args)) && !PyArg_ParseTupleAndKeywords(args, kwds, "|pO", kwlist, &block, &timeout)) { return NULL; }
+    return LinkedQueue_get_item((LinkedQueue*)op, block, timeout);
 }
 
-static PyObject* DoublyLinkedList_inplace_concat(PyObject* op, PyObject* concat)
+static PyObject* LinkedQueue_get_nowait(PyObject* op, PyObject* Py_UNUSED(dummy))
 {
-    if(DoublyLinkedList_append_iterator(op, concat, 1)) { return NULL; }
-    return Py_NewRef(op);
+    return LinkedQueue_get_item((LinkedQueue*)op, 0, NULL);
 }
 
-static int DoublyLinkedList_contains(PyObject* op, PyObject* value)
+static PyObject* LinkedQueue_get_many(PyObject* op, PyObject* args, PyObject* kwds)
 {
-    DoublyLinkedList* self = (DoublyLinkedList*)op;
-    DLLNode* temp = self->head;
-    for(Py_ssize_t i = 0; i<self->length; i++)
+    LinkedQueue* self = (LinkedQueue*)op;
+    static char* kwlist[] = {"n", "block", "timeout", NULL};
+    Py_ssize_t count;
+    int block = 1;
+    PyObject* timeout = Py_None;
+    if(!PyArg_ParseTupleAndKeywords(args, kwds, "n|pO", kwlist, &count, &block, &timeout)) { return NULL; }
+    if(count < 1)
     {
-        if(temp->value==value) { return 1; }
-        temp = temp->next;
+        PyErr_SetString(PyExc_ValueError, "n must be at least 1");
+        return NULL;
     }
-    return 0;
+    Py_ssize_t taken = 0;
+    DLLNode* first = LinkedQueue_take(self, count, block, timeout, &taken); if(!first) { return NULL; }
+    PyObject* items = PyList_New(taken);
+    if(!items)
+    {
+        // Put the items back at the head so nothing is lost
+        DLLNode* last = first;
+        while(last->next) { last = last->next; }
+        last->next = self->head;
+        if(self->head) { self->head->prev = last; } else { self->tail = last; }
+        self->head = first;
+        self->length += taken;
+        return NULL;
+    }
+    Py_ssize_t i = 0;
+    for(DLLNode* node = first; node; node = node->next)
+    {
+        PyList_SET_ITEM(items, i++, node->value);
+        node->value = NULL;
+    }
+    DLLNode_dealloc_chain(first);
+    return items;
 }
 
-// __Methods__
+static PyObject* LinkedQueue_qsize(PyObject* op, PyObject* Py_UNUSED(dummy))
+{
+    return PyLong_FromSsize_t(((LinkedQueue*)op)->length);
+}
 
-static PyObject* DoublyLinkedList_str(PyObject* op, PyObject* Py_UNUSED(dummy))
+static PyObject* LinkedQueue_empty(PyObject* op, PyObject* Py_UNUSED(dummy))
 {
-    DoublyLinkedList* self = (DoublyLinkedList*)op;
-    if(self->length == 0) { return PyUnicode_FromString("[]"); }
-    PyObject* string = PyUnicode_FromString("["); if(!string) { return NULL; }
-    PyObject* new_string;
-    DLLNode* temp = self->head;
-    for(Py_ssize_t i = 1; i < self->length; i++)
-    {
-        PyObject* node_str = DLLNode_repr(temp); if(!node_str) { return NULL; }
-        PyObject* format_node_str = PyUnicode_FromFormat("%U, ", node_str); if(!format_node_str) { return NULL; }
-        new_string = PyUnicode_Concat(string, format_node_str); if(!new_string) { return NULL; }
-        Py_DECREF(node_str); Py_DECREF(format_node_str); Py_DECREF(string);
-        string = new_string;
-        temp = temp->next;
-    }
-    new_string = PyUnicode_Concat(string, PyUnicode_FromFormat("%U]", DLLNode_repr(temp)));
-    Py_DECREF(string);
-    string = new_string;
-    return string;
+    return PyBool_FromLong(((LinkedQueue*)op)->length == 0);
 }
 
-static PyMethodDef DoublyLinkedList_methods[] = {
-    {"append", (PyCFunction)DoublyLinkedList_append, METH_VARARGS|METH_KEYWORDS,
-    "Append object to the end of the list. Set forward to false to append to the start."},
-    {"clear", (PyCFunction)DoublyLinkedList_clear_method, METH_NOARGS,
-    "Remove all items from the list."},
-    {"copy", (PyCFunction)DoublyLinkedList_copy, METH_NOARGS,
-    "Return a shallow copy of the list."},
-    {"count", (PyCFunction)DoublyLinkedList_count, METH_VARARGS|METH_KEYWORDS,
-    "Return number of occurrences of value in the list."},
-    {"extend", (PyCFunction)DoublyLinkedList_extend, METH_VARARGS|METH_KEYWORDS,
-    "Extend list by appending elements from the iterable. Set forward to false to extend from the start."},
-    {"index", (PyCFunction)DoublyLinkedList_index, METH_VARARGS|METH_KEYWORDS,
-    "Return first index of value.\nRaises ValueError if the value is not present."},
-    {"insert", (PyCFunction)DoublyLinkedList_insert, METH_VARARGS|METH_KEYWORDS,
-     "Insert object after index. Set forward to false to insert before index."},
-    {"pop", (PyCFunction)DoublyLinkedList_pop, METH_VARARGS|METH_KEYWORDS,
-    "Remove and return item at index (default last).\nRaises IndexError if list is empty or index is out of range."},
-    {"remove", (PyCFunction)DoublyLinkedList_remove, METH_VARARGS|METH_KEYWORDS,
-    "Remove first occurence of value.\nRaises ValueError if the value is not present."},
-    {"reverse", (PyCFunction)DoublyLinkedList_reverse, METH_NOARGS,
-    "Reverse the order of the list."},
-    {"sort", (PyCFunction)DoublyLinkedList_sort, METH_VARARGS|METH_KEYWORDS,
-    "In-place sort in ascending order, equal objects are not swapped. Key can be applied to values and the list will be sorted based on the result of applying the key. Reverse will reverse the sort order."},
+static PyObject* LinkedQueue_full(PyObject* op, PyObject* Py_UNUSED(dummy))
+{
+    return PyBool_FromLong(!LinkedQueue_has_room((LinkedQueue*)op));
+}
+
+static PyObject* LinkedQueue_get_maxsize(PyObject* op, void* closure)
+{
+    return PyLong_FromSsize_t(((LinkedQueue*)op)->maxsize);
+}
+
+static Py_ssize_t LinkedQueue_len(PyObject* op)
+{
+    return ((LinkedQueue*)op)->length;
+}
+
+static PyObject* LinkedQueue_repr(PyObject* op)
+{
+    LinkedQueue* self = (LinkedQueue*)op;
+    return PyUnicode_FromFormat("LinkedQueue(maxsize=%zd, qsize=%zd)", self->maxsize, self->length);
+}
+
+// Locked entry points. Waiting releases the GIL, which also suspends the critical section.
+
+DLL_LOCKED(int, LinkedQueue_init, (PyObject* op, PyObject* args, PyObject* kwds), (op, args, kwds))
+DLL_LOCKED_KWARGS(LinkedQueue_put)
+DLL_LOCKED_BINARY(LinkedQueue_put_nowait)
+DLL_LOCKED_KWARGS(LinkedQueue_get)
+DLL_LOCKED_NOARGS(LinkedQueue_get_nowait)
+DLL_LOCKED_KWARGS(LinkedQueue_get_many)
+DLL_LOCKED_NOARGS(LinkedQueue_qsize)
+DLL_LOCKED_NOARGS(LinkedQueue_empty)
+DLL_LOCKED_NOARGS(LinkedQueue_full)
+DLL_LOCKED(PyObject*, LinkedQueue_get_maxsize, (PyObject* op, void* closure), (op, closure))
+DLL_LOCKED(Py_ssize_t, LinkedQueue_len, (PyObject* op), (op))
+DLL_LOCKED_UNARY(LinkedQueue_repr)
+
+static PyMethodDef LinkedQueue_methods[] = {
+    {"put", (PyCFunction)LinkedQueue_put_locked, METH_VARARGS|METH_KEYWORDS,
+    "Put item at the end of the queue. If the queue is full, block until there is room, at most timeout seconds if given.\nRaises queue.Full if there is no room in time or block is false."},
+    {"put_nowait", (PyCFunction)LinkedQueue_put_nowait_locked, METH_O,
+    "Put item at the end of the queue without blocking.\nRaises queue.Full if the queue is full."},
+    {"get", (PyCFunction)LinkedQueue_get_locked, METH_VARARGS|METH_KEYWORDS,
+    "Remove and return the item at the front of the queue. If the queue is empty, block until an item is put, at most timeout seconds if given.\nRaises queue.Empty if no item arrives in time or block is false."},
+    {"get_nowait", (PyCFunction)LinkedQueue_get_nowait_locked, METH_NOARGS,
+    "Remove and return the item at the front of the queue without blocking.\nRaises queue.Empty if the queue is empty."},
+    {"get_many", (PyCFunction)LinkedQueue_get_many_locked, METH_VARARGS|METH_KEYWORDS,
+    "Remove and return a list of up to n items from the front of the queue. Blocks like get until at least one item is available."},
+    {"qsize", (PyCFunction)LinkedQueue_qsize_locked, METH_NOARGS,
+    "Return the number of items in the queue."},
+    {"empty", (PyCFunction)LinkedQueue_empty_locked, METH_NOARGS,
+    "Return True if the queue is empty."},
+    {"full", (PyCFunction)LinkedQueue_full_locked, METH_NOARGS,
+    "Return True if the queue has maxsize items."},
     {NULL, NULL, 0, NULL}
 };
 
-static PyMappingMethods DoublyLinkedList_map =
-{
-    .mp_subscript = DoublyLinkedList_subscript
+static PyGetSetDef LinkedQueue_getset[] = {
+    {"maxsize", LinkedQueue_get_maxsize_locked, NULL, "Maximum number of items, 0 or less if unbounded.", NULL},
+    {NULL}
 };
 
-static PySequenceMethods DoublyLinkedList_sequence =
+static PySequenceMethods LinkedQueue_sequence =
 {
-    .sq_length = (lenfunc)DoublyLinkedList_len,
-    .sq_item = DoublyLinkedList_item,
-    .sq_ass_item = DoublyLinkedList_ass_item,
-    .sq_concat = DoublyLinkedList_concat,
-    .sq_inplace_concat = DoublyLinkedList_inplace_concat,
-    .sq_contains = DoublyLinkedList_contains
+    .sq_length = LinkedQueue_len_locked
 };
 
 // Type Definition
 
-static PyTypeObject DoublyLinkedListType =
+static PyTypeObject LinkedQueueType =
 {
     .ob_base = PyVarObject_HEAD_INIT(NULL, 0)
-    .tp_name = "py_doubly_linked_list.doubly_linked_list.DoublyLinkedList",
-    .tp_doc = PyDoc_STR("DoublyLinkedList class"),
-    .tp_basicsize = sizeof(DoublyLinkedList),
+    .tp_name = "py_doubly_linked_list.doubly_linked_list.LinkedQueue",
+    .tp_doc = PyDoc_STR("Thread safe FIFO queue backed by a doubly linked list"),
+    .tp_basicsize = sizeof(LinkedQueue),
     .tp_itemsize = 0,
-    .tp_flags = Py_TPFLAGS_DEFAULT,
-    .tp_new = (newfunc)DoublyLinkedList_new,
-    .tp_init = (initproc)DoublyLinkedList_init,
-    .tp_dealloc = (destructor)DoublyLinkedList_dealloc,
-    .tp_str = (reprfunc)DoublyLinkedList_str,
-    .tp_richcompare = (richcmpfunc)DoublyLinkedList_rich_compare,
-    .tp_methods = DoublyLinkedList_methods,
-    .tp_as_sequence = &DoublyLinkedList_sequence,
-    .tp_as_mapping = &DoublyLinkedList_map
+    .tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC,
+    .tp_new = (newfunc)LinkedQueue_new,
+    .tp_init = LinkedQueue_init_locked,
+    .tp_dealloc = (destructor)LinkedQueue_dealloc,
+    .tp_traverse = LinkedQueue_traverse,
+    .tp_clear = LinkedQueue_clear,
+    .tp_repr = LinkedQueue_repr_locked,
+    .tp_methods = LinkedQueue_methods,
+    .tp_getset = LinkedQueue_getset,
+    .tp_as_sequence = &LinkedQueue_sequence
+};
+
+// Module Functions
+
+static PyObject* module_shrink_node_pool(PyObject* module, PyObject* Py_UNUSED(dummy))
+{
+#ifdef DLL_NODE_CACHE
+    DLLNodeCache_flush();
+#endif
+    DLL_MUTEX_LOCK(node_pool_mutex);
+    Py_ssize_t released = DLLNodePool_shrink();
+    DLL_MUTEX_UNLOCK(node_pool_mutex);
+    return PyLong_FromSsize_t(released);
+}
+
+static PyObject* module_node_pool_stats(PyObject* module, PyObject* Py_UNUSED(dummy))
+{
+#ifdef DLL_NODE_CACHE
+    DLLNodeCache_flush();
+#endif
+    DLL_MUTEX_LOCK(node_pool_mutex);
+    Py_ssize_t slabs = node_pool.slab_count;
+    Py_ssize_t free_count = node_pool.free_count;
+    Py_ssize_t deferred = deferred_nodes.count;
+    DLL_MUTEX_UNLOCK(node_pool_mutex);
+    Py_ssize_t capacity = slabs * DLL_SLAB_NODES;
+    return Py_BuildValue("{s:n,s:n,s:n,s:n,s:n}",
+                         "slabs", slabs,
+                         "capacity", capacity,
+                         "in_use", capacity - free_count,
+                         "free", free_count,
+                         "deferred", deferred);
+}
+
+static PyObject* module_stats(PyObject* module, PyObject* Py_UNUSED(dummy))
+{
+#ifdef DLL_STATS
+    return Py_BuildValue("{s:n,s:n,s:n,s:n,s:n,s:n,s:n,s:n,s:n,s:n,s:n,s:n,s:n}",
+                         "locate_cursor", DLL_STAT_LOAD(dll_stats.locate_cursor),
+                         "locate_finger", DLL_STAT_LOAD(dll_stats.locate_finger),
+                         "locate_head", DLL_STAT_LOAD(dll_stats.locate_head),
+                         "locate_tail", DLL_STAT_LOAD(dll_stats.locate_tail),
+                         "locate_index", DLL_STAT_LOAD(dll_stats.locate_index),
+                         "steps_cursor", DLL_STAT_LOAD(dll_stats.steps_cursor),
+                         "steps_finger", DLL_STAT_LOAD(dll_stats.steps_finger),
+                         "steps_head", DLL_STAT_LOAD(dll_stats.steps_head),
+                         "steps_tail", DLL_STAT_LOAD(dll_stats.steps_tail),
+                         "node_allocs", DLL_STAT_LOAD(dll_stats.node_allocs),
+                         "node_frees", DLL_STAT_LOAD(dll_stats.node_frees),
+                         "sort_comparisons", DLL_STAT_LOAD(dll_stats.sort_comparisons),
+                         "peak_length", DLL_STAT_LOAD(dll_stats.peak_length));
+#else
+    PyErr_SetString(PyExc_RuntimeError, "stats are only collected when the extension is built with DLL_STATS defined");
+    return NULL;
+#endif
+}
+
+static PyObject* module_reset_stats(PyObject* module, PyObject* Py_UNUSED(dummy))
+{
+#ifdef DLL_STATS
+    // Every counter is a Py_ssize_t, cleared one by one so concurrent adds stay atomic
+    Py_ssize_t* counters = (Py_ssize_t*)&dll_stats;
+    for(size_t i = 0; i < sizeof(dll_stats) / sizeof(Py_ssize_t); i++) { DLL_STAT_STORE(counters[i], 0); }
+#endif
+    return Py_NewRef(Py_None);
+}
+
+static PyObject* module_release_deferred(PyObject* module, PyObject* args, PyObject* kwds)
+{
+    static char* kwlist[] = {"budget", NULL};
+    PyObject* budget_arg = Py_None;
+    if(!PyArg_ParseTupleAndKeywords(args, kwds, "|O", kwlist, &budget_arg)) { return NULL; }
+    Py_ssize_t budget = -1;
+    if(!Py_IsNone(budget_arg))
+    {
+        budget = PyLong_AsSsize_t(budget_arg); if(budget == -1 && PyErr_Occurred()) { return NULL; }
+        if(budget < 0) { PyErr_SetString(PyExc_ValueError, "budget must be at least 0 or None"); return NULL; }
+    }
+    return PyLong_FromSsize_t(DLLNode_release_deferred(budget));
+}
+
+static PyMethodDef doubly_linked_list_module_methods[] = {
+    {"shrink_node_pool", (PyCFunction)module_shrink_node_pool, METH_NOARGS,
+    "Release node pool slabs that have no live nodes in them back to the system. Returns the number of bytes released."},
+    {"node_pool_stats", (PyCFunction)module_node_pool_stats, METH_NOARGS,
+    "Return a dict with the number of slabs, node capacity, nodes in use and free nodes of the shared node pool, and the number of nodes waiting in release_deferred."},
+    {"stats", (PyCFunction)module_stats, METH_NOARGS,
+    "Return a dict of the hot path counters: locate calls and nodes walked from the cursor, head and tail, locate calls answered by the index, node allocations and frees, sort comparisons and the peak list length. Raises RuntimeError unless built with DLL_STATS defined."},
+    {"reset_stats", (PyCFunction)module_reset_stats, METH_NOARGS,
+    "Reset every counter returned by stats to zero."},
+    {"release_deferred", (PyCFunction)module_release_deferred, METH_VARARGS|METH_KEYWORDS,
+    "Release up to budget nodes given up by clear(deferred=True), all of them if budget is None. Returns the number of nodes still waiting."},
+    {NULL, NULL, 0, NULL}
 };
 
+static void doubly_linked_list_module_free(void* module)
+{
+    DLLNode_release_deferred(-1);
+    DLL_MUTEX_LOCK(node_pool_mutex);
+    DLLNodePool_shrink();
+    DLL_MUTEX_UNLOCK(node_pool_mutex);
+}
+
 static int doubly_linked_list_module_exec(PyObject *m)
 {
     if (PyType_Ready(&DoublyLinkedListType) < 0) { return -1; }
+    if (PyType_Ready(&DoublyLinkedListIteratorType) < 0) { return -1; }
+    if (PyType_Ready(&NodeHandleType) < 0) { return -1; }
+    if (PyType_Ready(&CursorType) < 0) { return -1; }
+    if (PyType_Ready(&LRUCacheType) < 0) { return -1; }
+    if (PyType_Ready(&UnrolledLinkedListType) < 0) { return -1; }
+    if (PyType_Ready(&UnrolledLinkedListIteratorType) < 0) { return -1; }
+    if (PyType_Ready(&LinkedQueueType) < 0) { return -1; }
+    if (PyType_Ready(&DoublyLinkedListI64Type) < 0) { return -1; }
+    if (PyType_Ready(&DoublyLinkedListF64Type) < 0) { return -1; }
+    if (PyType_Ready(&TypedLinkedListIteratorType) < 0) { return -1; }
+    if (PyType_Ready(&MappedLinkedListType) < 0) { return -1; }
+    if (PyType_Ready(&MappedLinkedListIteratorType) < 0) { return -1; }
+    if (!queue_empty_error)
+    {
+        // Raise the queue module's exceptions so callers can handle both queues the same way
+        PyObject* queue_module = PyImport_ImportModule("queue"); if(!queue_module) { return -1; }
+        queue_empty_error = PyObject_GetAttrString(queue_module, "Empty");
+        queue_full_error = PyObject_GetAttrString(queue_module, "Full");
+        Py_DECREF(queue_module);
+        if(!queue_empty_error || !queue_full_error) { Py_CLEAR(queue_empty_error); Py_CLEAR(queue_full_error); return -1; }
+    }
     Py_INCREF(&DoublyLinkedListType);
     if (PyModule_AddObject(m, "DoublyLinkedList", (PyObject*)&DoublyLinkedListType) < 0)
     {
         Py_DECREF(&DoublyLinkedListType);
-        Py_DECREF(m);
+        return -1;
+    }
+    Py_INCREF(&NodeHandleType);
+    if (PyModule_AddObject(m, "NodeHandle", (PyObject*)&NodeHandleType) < 0)
+    {
+        Py_DECREF(&NodeHandleType);
+        return -1;
+    }
+    Py_INCREF(&CursorType);
+    if (PyModule_AddObject(m, "Cursor", (PyObject*)&CursorType) < 0)
+    {
+        Py_DECREF(&CursorType);
+        return -1;
+    }
+    Py_INCREF(&LRUCacheType);
+    if (PyModule_AddObject(m, "LRUCache", (PyObject*)&LRUCacheType) < 0)
+    {
+        Py_DECREF(&LRUCacheType);
+        return -1;
+    }
+    Py_INCREF(&UnrolledLinkedListType);
+    if (PyModule_AddObject(m, "UnrolledLinkedList", (PyObject*)&UnrolledLinkedListType) < 0)
+    {
+        Py_DECREF(&UnrolledLinkedListType);
+        return -1;
+    }
+    Py_INCREF(&LinkedQueueType);
+    if (PyModule_AddObject(m, "LinkedQueue", (PyObject*)&LinkedQueueType) < 0)
+    {
+        Py_DECREF(&LinkedQueueType);
+        return -1;
+    }
+    Py_INCREF(&DoublyLinkedListI64Type);
+    if (PyModule_AddObject(m, "DoublyLinkedListI64", (PyObject*)&DoublyLinkedListI64Type) < 0)
+    {
+        Py_DECREF(&DoublyLinkedListI64Type);
+        return -1;
+    }
+    Py_INCREF(&DoublyLinkedListF64Type);
+    if (PyModule_AddObject(m, "DoublyLinkedListF64", (PyObject*)&DoublyLinkedListF64Type) < 0)
+    {
+        Py_DECREF(&DoublyLinkedListF64Type);
+        return -1;
+    }
+    Py_INCREF(&MappedLinkedListType);
+    if (PyModule_AddObject(m, "MappedLinkedList", (PyObject*)&MappedLinkedListType) < 0)
+    {
+        Py_DECREF(&MappedLinkedListType);
         return -1;
     }
     return 0;
@@ -776,6 +9505,9 @@ static PyModuleDef_Slot py_doubly_linked_list_module_slots[] =
 {
     {Py_mod_exec, doubly_linked_list_module_exec},
     {Py_mod_multiple_interpreters, Py_MOD_MULTIPLE_INTERPRETERS_NOT_SUPPORTED},
+#if PY_MINOR_VERSION >= 13
+    {Py_mod_gil, Py_MOD_GIL_NOT_USED},
+#endif
     {0, NULL}
 };
 
@@ -794,7 +9526,9 @@ static struct PyModuleDef py_doubly_linked_list_module =
 	PyModuleDef_HEAD_INIT,
 	"py_doubly_linked_list.doubly_linked_list",
 	"A library implementing a doubly linked list for python",
-	.m_slots = py_doubly_linked_list_module_slots
+	.m_methods = doubly_linked_list_module_methods,
+	.m_slots = py_doubly_linked_list_module_slots,
+	.m_free = doubly_linked_list_module_free
 };
 
 PyMODINIT_FUNC PyInit_doubly_linked_list(void)
@@ -1 +1 @@
-from .doubly_linked_list import DoublyLinkedList
\ No newline at end of file
+from .doubly_linked_list import DoublyLinkedList, UnrolledLinkedList, DoublyLinkedListI64, DoublyLinkedListF64, MappedLinkedList, NodeHandle, Cursor, LRUCache, LinkedQueue, shrink_node_pool, node_pool_stats, release_deferred, stats, reset_stats
\ No newline at end of file
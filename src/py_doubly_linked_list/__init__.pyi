@@ -1,19 +1,79 @@
-from typing import Iterable, TypeVar, overload
+from typing import Any, Generic, Iterable, Iterator, TypeAlias, TypeVar, overload
+from typing_extensions import Self
 from collections.abc import Callable, MutableSequence
-from _typeshed import SupportsRichComparison, SupportsRichComparisonT, _T
+from _typeshed import SupportsRead, SupportsRichComparison, SupportsRichComparisonT, SupportsWrite, _T
+from os import PathLike
 import sys
 
 _S = TypeVar("_S")
+_K = TypeVar("_K")
+_V = TypeVar("_V")
+_N = TypeVar("_N", int, float)
+_M: TypeAlias = None | bool | int | float | bytes | str
+
+class NodeHandle(Generic[_T]):
+    """Handle to a single node of a DoublyLinkedList"""
+    value: _T
+    """The item stored in the node. Raises ValueError if the node was removed from its list."""
+    @property
+    def valid(self) -> bool:
+        """True while the node is still part of its list."""
+        ...
+
+class Cursor(Generic[_T]):
+    """Position in a DoublyLinkedList for O(1) navigation and editing"""
+    value: _T
+    """The item at the cursor. Raises IndexError at the end of the list."""
+    @property
+    def pos(self) -> int:
+        """Index of the cursor, the length of the list at its end. O(1) through inserts, deletes, extend and splice anywhere in the list. After bulk changes like sort, reverse or slice assignment it is looked up again, in O(log n) for indexed lists and otherwise by walking to the nearest end of the list or known position, O(n) in the worst case."""
+        ...
+    @property
+    def valid(self) -> bool:
+        """False once the item at the cursor was removed by something other than the cursor."""
+        ...
+    def next(self) -> None:
+        """Move to the next item, or to the end of the list from the last item.  
+        Raises IndexError at the end of the list."""
+        ...
+    def prev(self) -> None:
+        """Move to the previous item, or to the last item from the end of the list.  
+        Raises IndexError at the first item."""
+        ...
+    def insert_before(self, object: _T) -> None:
+        """Insert object before the cursor, the cursor stays on its item. At the end of the list object is appended."""
+        ...
+    def insert_after(self, object: _T) -> None:
+        """Insert object after the cursor, the cursor stays on its item.  
+        Raises IndexError at the end of the list."""
+        ...
+    def delete(self) -> _T:
+        """Remove and return the item at the cursor and move to the next item.  
+        Raises IndexError at the end of the list."""
+        ...
 
 class DoublyLinkedList(MutableSequence[_T]):
     @overload
-    def __init__(self) -> None: ...
-    def __init__(self, iterable: Iterable[_T], /) -> None: ...
+    def __init__(self, *, indexed: bool = False, hashed: bool = False) -> None: ...
+    @overload
+    def __init__(self, iterable: Iterable[_T], /, *, indexed: bool = False, hashed: bool = False) -> None: ...
+    @property
+    def indexed(self) -> bool:
+        """True if the list keeps a skip list index for O(log n) positional access."""
+        ...
+    @property
+    def hashed(self) -> bool:
+        """True if the list keeps a hash index for O(1) membership, count and remove."""
+        ...
     def append(self, object: _T, forward: bool = True) -> None:
         """Append object to the end of the list. Set forward to false to append to the start."""
         ...
-    def clear(self) -> None:
-        """Remove all items from the list."""
+    def append_node(self, object: _T, forward: bool = True) -> NodeHandle[_T]:
+        """Append object like append and return a NodeHandle for it."""
+        ...
+    def clear(self, *, deferred: bool = False) -> None:
+        """Remove all items from the list.  
+        With deferred=True the nodes are only detached in O(1) and their items are released by release_deferred."""
         ...
     def copy(self) -> DoublyLinkedList[_T]:
         """Return a shallow copy of the list."""
@@ -21,6 +81,13 @@ class DoublyLinkedList(MutableSequence[_T]):
     def count(self, value: _T) -> int:
         """Return number of occurrences of value in the list."""
         ...
+    def cursor(self, index: int = 0) -> Cursor[_T]:
+        """Return a Cursor at index for O(1) navigation and editing, at the end of the list if index is its length.  
+        Raises IndexError if the index is out of range."""
+        ...
+    def dump(self, file: SupportsWrite[bytes], chunk_size: int = 1024, *, protocol: int = -1) -> None:
+        """Write the list to a binary file in frames of up to chunk_size pickled items, so only one frame is held in memory at a time."""
+        ...
     def extend(self, iterable: Iterable[_T], forward: bool = True) -> None:
         """Extend list by appending elements from the iterable. Set forward to false to extend from the start."""
         ...
@@ -31,6 +98,26 @@ class DoublyLinkedList(MutableSequence[_T]):
     def insert(self, object: _T, index: int, forward: bool = True) -> None:
         """Insert object after index. Set forward to false to insert before index."""
         ...
+    def insert_node(self, object: _T, index: int, forward: bool = True) -> NodeHandle[_T]:
+        """Insert object like insert and return a NodeHandle for it."""
+        ...
+    def insert_after(self, node: NodeHandle[_T], object: _T) -> NodeHandle[_T]:
+        """Insert object directly after node in O(1) and return a NodeHandle for it."""
+        ...
+    def insert_before(self, node: NodeHandle[_T], object: _T) -> NodeHandle[_T]:
+        """Insert object directly before node in O(1) and return a NodeHandle for it."""
+        ...
+    @classmethod
+    def load(cls, file: SupportsRead[bytes]) -> DoublyLinkedList[Any]:
+        """Read a list written by dump from a binary file, one frame at a time."""
+        ...
+    def move_to_end(self, node: NodeHandle[_T], forward: bool = True) -> None:
+        """Move node to the end of the list in O(1). Set forward to false to move it to the start."""
+        ...
+    def node_at(self, index: int) -> NodeHandle[_T]:
+        """Return a NodeHandle for the item at index.  
+        Raises IndexError if the index is out of range."""
+        ...
     def pop(self, index: int = -1) -> _T:
         """Remove and return item at index (default last).  
         Raises IndexError if list is empty or index is out of range."""
@@ -39,6 +126,13 @@ class DoublyLinkedList(MutableSequence[_T]):
         """Remove first occurence of value.  
         Raises ValueError if the value is not present."""
         ...
+    def remove_node(self, node: NodeHandle[_T]) -> _T:
+        """Remove node from the list in O(1) and return its value.  
+        Raises ValueError if the node was already removed or belongs to another list."""
+        ...
+    def repr_limited(self, max_items: int) -> str:
+        """Return the repr of the list with at most max_items items written out, followed by the number left out."""
+        ...
     def reverse(self) -> None:
         """Reverse the order of the list."""
         ...
@@ -50,7 +144,323 @@ class DoublyLinkedList(MutableSequence[_T]):
     def sort(self, key: Callable[[_T], SupportsRichComparison], reverse: bool = False) -> None:
         """In-place sort in ascending order, equal objects are not swapped. Key can be applied to values and the list will be sorted based on the result of applying the key. Reverse will reverse the sort order."""
         ...
+    def splice(self, other: DoublyLinkedList[_T], index: int | None = None, forward: bool = True) -> None:
+        """Move every node of other to the end of the list without copying, leaving other empty. With an index the nodes are moved after index, or before it if forward is false."""
+        ...
+    def split(self, index: int) -> DoublyLinkedList[_T]:
+        """Detach the items from index to the end into a new list without copying and return it.\nRaises IndexError if index is out of range."""
+        ...
+    def __iter__(self) -> Iterator[_T]:
+        """Iterate over the list from head to tail, raises RuntimeError if the list changes during iteration."""
+        ...
+    def __reversed__(self) -> Iterator[_T]:
+        """Return a reverse iterator over the list."""
+        ...
+    def __lt__(self, value: DoublyLinkedList[_T] | list[_T] | tuple[_T, ...], /) -> bool: ...
+    def __le__(self, value: DoublyLinkedList[_T] | list[_T] | tuple[_T, ...], /) -> bool: ...
+    def __gt__(self, value: DoublyLinkedList[_T] | list[_T] | tuple[_T, ...], /) -> bool: ...
+    def __ge__(self, value: DoublyLinkedList[_T] | list[_T] | tuple[_T, ...], /) -> bool: ...
     @overload
     def __add__(self, value: Iterable[_T], /) -> DoublyLinkedList[_T]: ...
     @overload
-    def __add__(self, value: Iterable[_S], /) -> DoublyLinkedList[_T | _S]: ...
\ No newline at end of file
+    def __add__(self, value: Iterable[_S], /) -> DoublyLinkedList[_T | _S]: ...
+    def __mul__(self, value: int, /) -> DoublyLinkedList[_T]:
+        """Return a new list with the items repeated value times, keeping the indexed and hashed settings."""
+        ...
+    def __rmul__(self, value: int, /) -> DoublyLinkedList[_T]: ...
+    def __imul__(self, value: int, /) -> Self:
+        """Append value - 1 copies of the items, or clear the list if value is less than 1."""
+        ...
+
+
+class UnrolledLinkedList(MutableSequence[_T]):
+    """DoublyLinkedList storing up to block_size items per node for faster scans.\nItems live inside blocks rather than nodes of their own, so it deliberately has no splice, split, node handles (append_node, insert_node, insert_before, insert_after, remove_node, move_to_end, node_at), cursor, the indexed and hashed modes, dump/load and repetition with *."""
+    @overload
+    def __init__(self, *, block_size: int = 32) -> None: ...
+    @overload
+    def __init__(self, iterable: Iterable[_T], /, *, block_size: int = 32) -> None: ...
+    @property
+    def block_size(self) -> int:
+        """Number of items each block can hold."""
+        ...
+    def append(self, object: _T, forward: bool = True) -> None:
+        """Append object to the end of the list. Set forward to false to append to the start."""
+        ...
+    def clear(self) -> None:
+        """Remove all items from the list."""
+        ...
+    def copy(self) -> UnrolledLinkedList[_T]:
+        """Return a shallow copy of the list."""
+        ...
+    def count(self, value: _T) -> int:
+        """Return number of occurrences of value in the list."""
+        ...
+    def extend(self, iterable: Iterable[_T], forward: bool = True) -> None:
+        """Extend list by appending elements from the iterable. Set forward to false to extend from the start."""
+        ...
+    def index(self, value: _T, start: int = 0, stop: int = sys.maxsize) -> int:
+        """Return first index of value.\nRaises ValueError if the value is not present."""
+        ...
+    def insert(self, object: _T, index: int, forward: bool = True) -> None:
+        """Insert object after index. Set forward to false to insert before index."""
+        ...
+    def pop(self, index: int = -1) -> _T:
+        """Remove and return item at index (default last).\nRaises IndexError if list is empty or index is out of range."""
+        ...
+    def remove(self, value: _T, start: int = 0, stop: int = sys.maxsize) -> None:
+        """Remove first occurence of value between start and stop.\nRaises ValueError if the value is not present."""
+        ...
+    def repr_limited(self, max_items: int) -> str:
+        """Return the repr of the list with at most max_items items written out, followed by the number left out."""
+        ...
+    def reverse(self) -> None:
+        """Reverse the order of the list."""
+        ...
+    @overload
+    def sort(self: UnrolledLinkedList[SupportsRichComparisonT], key: None = None, reverse: bool = False) -> None:
+        """In-place sort in ascending order, equal objects are not swapped. Reverse will reverse the sort order."""
+        ...
+    @overload
+    def sort(self, key: Callable[[_T], SupportsRichComparison], reverse: bool = False) -> None:
+        """In-place sort in ascending order, equal objects are not swapped. Key can be applied to values and the list will be sorted based on the result of applying the key. Reverse will reverse the sort order."""
+        ...
+    def __iter__(self) -> Iterator[_T]:
+        """Iterate over the list from head to tail, raises RuntimeError if the list changes during iteration."""
+        ...
+    def __reversed__(self) -> Iterator[_T]:
+        """Return a reverse iterator over the list."""
+        ...
+    def __lt__(self, value: UnrolledLinkedList[_T] | list[_T] | tuple[_T, ...], /) -> bool: ...
+    def __le__(self, value: UnrolledLinkedList[_T] | list[_T] | tuple[_T, ...], /) -> bool: ...
+    def __gt__(self, value: UnrolledLinkedList[_T] | list[_T] | tuple[_T, ...], /) -> bool: ...
+    def __ge__(self, value: UnrolledLinkedList[_T] | list[_T] | tuple[_T, ...], /) -> bool: ...
+    @overload
+    def __add__(self, value: Iterable[_T], /) -> UnrolledLinkedList[_T]: ...
+    @overload
+    def __add__(self, value: Iterable[_S], /) -> UnrolledLinkedList[_T | _S]: ...
+
+class _TypedLinkedList(MutableSequence[_N]):
+    """Shared interface of DoublyLinkedListI64 and DoublyLinkedListF64.\nValues live unboxed inside blocks rather than nodes of their own, so they deliberately have no splice, split, node handles (append_node, insert_node, insert_before, insert_after, remove_node, move_to_end, node_at), cursor, the indexed and hashed modes, dump/load and repetition with *."""
+    @overload
+    def __init__(self, *, block_size: int = 256) -> None: ...
+    @overload
+    def __init__(self, iterable: Iterable[_N], /, *, block_size: int = 256) -> None: ...
+    @property
+    def block_size(self) -> int:
+        """Number of values each block can hold."""
+        ...
+    def append(self, object: _N, forward: bool = True) -> None:
+        """Append object to the end of the list. Set forward to false to append to the start."""
+        ...
+    def clear(self) -> None:
+        """Remove all items from the list."""
+        ...
+    def copy(self) -> Self:
+        """Return a shallow copy of the list."""
+        ...
+    def count(self, value: object) -> int:
+        """Return number of occurrences of value in the list."""
+        ...
+    def extend(self, iterable: Iterable[_N], forward: bool = True) -> None:
+        """Extend list by appending elements from the iterable. Set forward to false to extend from the start."""
+        ...
+    def index(self, value: object, start: int = 0, stop: int = sys.maxsize) -> int:
+        """Return first index of value.\nRaises ValueError if the value is not present."""
+        ...
+    def insert(self, object: _N, index: int, forward: bool = True) -> None:
+        """Insert object after index. Set forward to false to insert before index."""
+        ...
+    def max(self) -> _N:
+        """Return the largest value.\nRaises ValueError if the list is empty."""
+        ...
+    def min(self) -> _N:
+        """Return the smallest value.\nRaises ValueError if the list is empty."""
+        ...
+    def pop(self, index: int = -1) -> _N:
+        """Remove and return item at index (default last).\nRaises IndexError if list is empty or index is out of range."""
+        ...
+    def remove(self, value: object, start: int = 0, stop: int = sys.maxsize) -> None:
+        """Remove first occurence of value between start and stop.\nRaises ValueError if the value is not present."""
+        ...
+    def repr_limited(self, max_items: int) -> str:
+        """Return the repr of the list with at most max_items items written out, followed by the number left out."""
+        ...
+    def reverse(self) -> None:
+        """Reverse the order of the list."""
+        ...
+    def sort(self, key: Callable[[_N], SupportsRichComparison] | None = None, reverse: bool = False) -> None:
+        """In-place sort in ascending order, equal values are not swapped. Key can be applied to values and the list will be sorted based on the result of applying the key. Reverse will reverse the sort order."""
+        ...
+    def sum(self) -> _N:
+        """Return the sum of the values, exact for DoublyLinkedListI64."""
+        ...
+    def __iter__(self) -> Iterator[_N]:
+        """Iterate over the list from head to tail, raises RuntimeError if the list changes during iteration."""
+        ...
+    def __reversed__(self) -> Iterator[_N]:
+        """Return a reverse iterator over the list."""
+        ...
+    def __lt__(self, value: _TypedLinkedList[int] | _TypedLinkedList[float] | list[_N] | tuple[_N, ...], /) -> bool: ...
+    def __le__(self, value: _TypedLinkedList[int] | _TypedLinkedList[float] | list[_N] | tuple[_N, ...], /) -> bool: ...
+    def __gt__(self, value: _TypedLinkedList[int] | _TypedLinkedList[float] | list[_N] | tuple[_N, ...], /) -> bool: ...
+    def __ge__(self, value: _TypedLinkedList[int] | _TypedLinkedList[float] | list[_N] | tuple[_N, ...], /) -> bool: ...
+    def __add__(self, value: Iterable[_N], /) -> Self: ...
+    def __buffer__(self, flags: int, /) -> memoryview:
+        """Export a read-only copy of the values. The list can't be changed while the buffer is held."""
+        ...
+
+class DoublyLinkedListI64(_TypedLinkedList[int]):
+    """Linked list of 64 bit integers stored unboxed in blocks."""
+
+class DoublyLinkedListF64(_TypedLinkedList[float]):
+    """Linked list of doubles stored unboxed in blocks."""
+
+class MappedLinkedList:
+    """Doubly linked list of None, bool, int, float, bytes and str values stored in a memory mapped file"""
+    def __init__(self, path: str | bytes | PathLike[str] | PathLike[bytes], iterable: Iterable[_M] | None = None) -> None: ...
+    @property
+    def closed(self) -> bool:
+        """True once the list has been closed."""
+        ...
+    def append(self, object: _M, forward: bool = True) -> None:
+        """Append object to the end of the list. Set forward to false to append to the start."""
+        ...
+    def clear(self) -> None:
+        """Remove all items from the list and shrink the file back to its initial size."""
+        ...
+    def close(self) -> None:
+        """Unmap and close the file. The list can't be used afterwards, reopen the file to get it back."""
+        ...
+    def extend(self, iterable: Iterable[_M], forward: bool = True) -> None:
+        """Extend list by appending elements from the iterable. Set forward to false to extend from the start."""
+        ...
+    def flush(self) -> None:
+        """Write changes to the list through to the file on disk."""
+        ...
+    def insert(self, object: _M, index: int, forward: bool = True) -> None:
+        """Insert object after index. Set forward to false to insert before index."""
+        ...
+    def pop(self, index: int = -1) -> _M:
+        """Remove and return item at index (default last).  
+        Raises IndexError if list is empty or index is out of range."""
+        ...
+    def __len__(self) -> int: ...
+    def __getitem__(self, index: int) -> _M: ...
+    def __setitem__(self, index: int, value: _M) -> None: ...
+    def __delitem__(self, index: int) -> None: ...
+    def __iter__(self) -> Iterator[_M]:
+        """Return an iterator over the list."""
+        ...
+    def __reversed__(self) -> Iterator[_M]:
+        """Return a reverse iterator over the list."""
+        ...
+    def __enter__(self) -> Self: ...
+    def __exit__(self, *args: object) -> None: ...
+
+def shrink_node_pool() -> int:
+    """Release node pool slabs that have no live nodes in them back to the system. Returns the number of bytes released."""
+    ...
+def node_pool_stats() -> dict[str, int]:
+    """Return a dict with the number of slabs, node capacity, nodes in use and free nodes of the shared node pool, and the number of nodes waiting in release_deferred."""
+    ...
+def stats() -> dict[str, int]:
+    """Return a dict of the hot path counters: locate calls and nodes walked from the cursor, head and tail, locate calls answered by the index, node allocations and frees, sort comparisons and the peak list length.  
+    Raises RuntimeError unless built with DLL_STATS defined."""
+    ...
+def reset_stats() -> None:
+    """Reset every counter returned by stats to zero."""
+    ...
+def release_deferred(budget: int | None = None) -> int:
+    """Release up to budget nodes given up by clear(deferred=True), all of them if budget is None. Returns the number of nodes still waiting."""
+    ...
+
+class LRUCache(Generic[_K, _V]):
+    """Least recently used cache backed by a doubly linked list and a hash table"""
+    hits: int
+    """Number of lookups that found their key."""
+    misses: int
+    """Number of lookups that did not find their key."""
+    evictions: int
+    """Number of entries evicted to make room."""
+    on_evict: Callable[[_K, _V], object] | None
+    """Callable invoked with (key, value) for every evicted entry, or None."""
+    def __init__(self, maxsize: int | None, on_evict: Callable[[_K, _V], object] | None = None) -> None: ...
+    @property
+    def maxsize(self) -> int | None:
+        """Maximum number of entries, None if unbounded."""
+        ...
+    @overload
+    def get(self, key: _K) -> _V | None: ...
+    @overload
+    def get(self, key: _K, default: _S) -> _V | _S:
+        """Return the value for key and mark it as most recently used, or default if key is not cached."""
+        ...
+    def put(self, key: _K, value: _V) -> None:
+        """Cache value under key as the most recently used entry, evicting the least recently used entry if the cache is full."""
+        ...
+    @overload
+    def peek(self, key: _K) -> _V | None: ...
+    @overload
+    def peek(self, key: _K, default: _S) -> _V | _S:
+        """Return the value for key without changing the order or the counters, or default if key is not cached."""
+        ...
+    @overload
+    def pop(self, key: _K) -> _V: ...
+    @overload
+    def pop(self, key: _K, default: _S) -> _V | _S:
+        """Remove key and return its value, or default if given.  
+        Raises KeyError if key is not cached and no default is given."""
+        ...
+    def clear(self) -> None:
+        """Remove all entries from the cache. The counters are kept."""
+        ...
+    def keys(self) -> list[_K]:
+        """Return a list of the cached keys from most to least recently used."""
+        ...
+    def values(self) -> list[_V]:
+        """Return a list of the cached values from most to least recently used."""
+        ...
+    def items(self) -> list[tuple[_K, _V]]:
+        """Return a list of (key, value) pairs from most to least recently used."""
+        ...
+    def __len__(self) -> int: ...
+    def __contains__(self, key: object) -> bool: ...
+    def __getitem__(self, key: _K) -> _V: ...
+    def __setitem__(self, key: _K, value: _V) -> None: ...
+    def __delitem__(self, key: _K) -> None: ...
+class LinkedQueue(Generic[_T]):
+    """Thread safe FIFO queue backed by a doubly linked list"""
+    def __init__(self, maxsize: int = 0) -> None: ...
+    @property
+    def maxsize(self) -> int:
+        """Maximum number of items, 0 or less if unbounded."""
+        ...
+    def put(self, item: _T, block: bool = True, timeout: float | None = None) -> None:
+        """Put item at the end of the queue. If the queue is full, block until there is room, at most timeout seconds if given.  
+        Raises queue.Full if there is no room in time or block is false."""
+        ...
+    def put_nowait(self, item: _T) -> None:
+        """Put item at the end of the queue without blocking.  
+        Raises queue.Full if the queue is full."""
+        ...
+    def get(self, block: bool = True, timeout: float | None = None) -> _T:
+        """Remove and return the item at the front of the queue. If the queue is empty, block until an item is put, at most timeout seconds if given.  
+        Raises queue.Empty if no item arrives in time or block is false."""
+        ...
+    def get_nowait(self) -> _T:
+        """Remove and return the item at the front of the queue without blocking.  
+        Raises queue.Empty if the queue is empty."""
+        ...
+    def get_many(self, n: int, block: bool = True, timeout: float | None = None) -> list[_T]:
+        """Remove and return a list of up to n items from the front of the queue. Blocks like get until at least one item is available."""
+        ...
+    def qsize(self) -> int:
+        """Return the number of items in the queue."""
+        ...
+    def empty(self) -> bool:
+        """Return True if the queue is empty."""
+        ...
+    def full(self) -> bool:
+        """Return True if the queue has maxsize items."""
+        ...
+    def __len__(self) -> int: ...
\ No newline at end of file
@@ -1,6 +1,16 @@
-from py_doubly_linked_list import DoublyLinkedList
+from py_doubly_linked_list import DoublyLinkedList, UnrolledLinkedList, DoublyLinkedListI64, DoublyLinkedListF64, MappedLinkedList, NodeHandle, Cursor, LRUCache, LinkedQueue, shrink_node_pool, node_pool_stats, release_deferred, stats, reset_stats
 
+import array
+import copy
+import gc
+import io
+import os
+import pickle
+import queue
+import subprocess
 import sys
+import tempfile
+import threading
 import weakref
 
 class DummyClass():
@@ -38,6 +48,39 @@ def test_dereferencing():
     test_list.clear()
     assert reference() is None
 
+def test_pop_references():
+    value = DummyClass(0)
+    refcount = sys.getrefcount(value)
+    for settings in ({}, {"indexed": True}, {"hashed": True}):
+        test_list = DoublyLinkedList([value] * 10, **settings)
+        for index in (0, -1, 4, 0, -1):
+            assert test_list.pop(index) is value
+        try:
+            test_list.pop(5)
+            assert False
+        except IndexError:
+            pass
+        assert sys.getrefcount(value) == refcount + 5
+        del test_list
+        assert sys.getrefcount(value) == refcount
+
+def test_index_bounds():
+    values = [1, 2, 3, 1, 2, 3]
+    for settings in ({}, {"indexed": True}, {"hashed": True}):
+        test_list = DoublyLinkedList(values, **settings)
+        for value in (1, 3, 9):
+            for start in (-10, -6, -4, -1, 0, 2, 5, 6, 10):
+                for stop in (-10, -5, -1, 0, 3, 6, 10):
+                    try:
+                        expected = values.index(value, start, stop)
+                    except ValueError:
+                        expected = None
+                    try:
+                        assert test_list.index(value, start, stop) == expected
+                    except ValueError:
+                        assert expected is None
+        assert test_list.index(3, -2) == 5 and list(test_list) == values
+
 def test_sort():
     test_list = DoublyLinkedList([1,5,3,8,6,7,4,2])
     test_list.sort()
@@ -45,6 +88,155 @@ def test_sort():
     test_list.sort(lambda x : x * -1)
     assert list(test_list) == [8,7,6,5,4,3,2,1]
 
+def test_sort_stable():
+    pairs = [(value % 7, index) for index, value in enumerate(range(1000, 0, -3))]
+    test_list = DoublyLinkedList(pairs)
+    test_list.sort(key=lambda pair : pair[0])
+    assert list(test_list) == sorted(pairs, key=lambda pair : pair[0])
+    test_list.sort(key=lambda pair : pair[0], reverse=True)
+    assert list(test_list) == sorted(pairs, key=lambda pair : pair[0], reverse=True)
+    assert test_list[-1] == sorted(pairs, key=lambda pair : pair[0], reverse=True)[-1]
+    test_list = DoublyLinkedList(list(range(500)) + list(range(500, 0, -1)))
+    test_list.sort()
+    assert list(test_list) == sorted(list(range(500)) + list(range(500, 0, -1)))
+
+def test_sort_error():
+    test_list = DoublyLinkedList([3, 1, "a", 2] * 50)
+    try:
+        test_list.sort()
+        assert False
+    except TypeError:
+        pass
+    assert len(test_list) == 200
+    assert sorted(test_list, key=str) == sorted([3, 1, "a", 2] * 50, key=str)
+
+def test_iteration():
+    test_list = DoublyLinkedList(range(100))
+    test_list.insert(-1, 50, False)
+    expected = list(range(50)) + [-1] + list(range(50, 100))
+    assert list(test_list) == expected
+    assert list(reversed(test_list)) == expected[::-1]
+    iterator = iter(test_list)
+    assert iterator.__length_hint__() == 101
+    next(iterator)
+    test_list.pop()
+    try:
+        next(iterator)
+        assert False
+    except RuntimeError:
+        pass
+    iterator = reversed(DoublyLinkedList([DummyClass(1)]))
+    assert next(iterator).id == 1
+    assert list(iterator) == []
+
+def test_node_handles():
+    test_list = DoublyLinkedList()
+    handles = [test_list.append_node(i) for i in range(5)]
+    assert isinstance(handles[0], NodeHandle)
+    assert test_list.remove_node(handles[2]) == 2
+    assert not handles[2].valid
+    test_list.insert_after(handles[0], "a")
+    front = test_list.insert_before(handles[0], "b")
+    assert list(test_list) == ["b", 0, "a", 1, 3, 4]
+    test_list.move_to_end(front)
+    test_list.move_to_end(handles[4], False)
+    assert list(test_list) == [4, 0, "a", 1, 3, "b"]
+    assert [test_list[i] for i in range(6)] == [4, 0, "a", 1, 3, "b"]
+    test_list.reverse()
+    assert handles[1].value == 1 and test_list[2] == 1
+    assert test_list.node_at(2) is handles[1]
+    try:
+        test_list.remove_node(handles[2])
+        assert False
+    except ValueError:
+        pass
+    try:
+        DoublyLinkedList([1]).remove_node(handles[0])
+        assert False
+    except ValueError:
+        pass
+    del test_list
+    assert handles[0].valid and handles[0].value == 0
+    item = DummyClass(1)
+    reference = weakref.ref(item)
+    test_list = DoublyLinkedList([0, item])
+    handle = test_list.node_at(1)
+    del test_list, item
+    assert reference() is not None and handle.value is reference()
+    del handle
+    assert reference() is None
+
+def test_lru_cache():
+    evicted = []
+    cache = LRUCache(3, on_evict=lambda key, value : evicted.append((key, value)))
+    for i in range(4):
+        cache[i] = str(i)
+    assert evicted == [(0, "0")]
+    assert cache.get(1) == "1"
+    cache.put(4, "4")
+    assert evicted == [(0, "0"), (2, "2")]
+    assert cache.keys() == [4, 1, 3]
+    assert cache.get(0, "missing") == "missing"
+    assert (cache.hits, cache.misses, cache.evictions) == (1, 1, 2)
+    assert 3 in cache and 0 not in cache
+    assert cache.pop(3) == "3"
+    del cache[1]
+    assert len(cache) == 1 and cache[4] == "4"
+    try:
+        cache[0]
+        assert False
+    except KeyError:
+        pass
+    unbounded = LRUCache(None)
+    for i in range(10000):
+        unbounded[str(i)] = i
+    assert len(unbounded) == 10000 and unbounded["1234"] == 1234
+
+    # Eviction uses the hash stored on insert, a key that can't be hashed again still leaves
+    class OneHash:
+        hashed = False
+        def __hash__(self):
+            if self.hashed:
+                raise RuntimeError("hashed twice")
+            self.hashed = True
+            return 1
+    evicted = []
+    cache = LRUCache(1, on_evict=lambda key, value: evicted.append(value))
+    cache[OneHash()] = "first"
+    cache["second"] = "second"
+    assert len(cache) == 1 and evicted == ["first"] and cache.keys() == ["second"]
+    cache = LRUCache(100)
+    for i in range(100):
+        cache[i] = i
+    cache.clear()
+    assert len(cache) == 0 and 5 not in cache and cache.keys() == []
+    for i in range(50):
+        cache[i] = -i
+    assert len(cache) == 50 and cache[49] == -49
+
+def test_indexed():
+    test_list = DoublyLinkedList(range(1000), indexed=True)
+    reference = list(range(1000))
+    assert test_list.indexed and not DoublyLinkedList().indexed
+    for i in range(0, 1000, 7):
+        assert test_list[i] == reference[i]
+    for i in range(100):
+        position = (i * 389) % len(reference)
+        test_list.insert(-i, position)
+        reference.insert(position + 1, -i)
+        assert test_list.pop((i * 211) % len(reference)) == reference.pop((i * 211) % len(reference))
+    handle = test_list.node_at(500)
+    test_list.move_to_end(handle, False)
+    reference.insert(0, reference.pop(500))
+    test_list.reverse()
+    reference.reverse()
+    assert [test_list[i] for i in range(len(reference))] == reference
+    test_list.sort()
+    reference.sort()
+    assert [test_list[i] for i in range(0, len(reference), 3)] == reference[::3]
+    assert test_list.copy().indexed
+    assert sys.getsizeof(test_list) > sys.getsizeof(DoublyLinkedList(reference))
+
 def test_rich_compare():
     test_list = DoublyLinkedList([1,2,3,4]) 
     test_list2 = DoublyLinkedList([1,2,3,4])
@@ -56,10 +248,1127 @@ def test_rich_compare():
     assert test_list != test_list3
     assert test_list != test_list4
     assert test_list4 != test_list
+    assert test_list == (1, 2, 3, 4)
+    assert test_list == range(1, 5)
+    assert test_list != range(1, 6)
+    values = [[], [1], [1, 2], [2], [1, 2.5], [2**70], [-2**70, 0], ["a", "b"], ["b"], [True, 1.0]]
+    for a in values:
+        for b in values:
+            try:
+                expected = [a == b, a != b, a < b, a <= b, a > b, a >= b]
+            except TypeError:
+                continue
+            for other in (DoublyLinkedList(b), b, tuple(b)):
+                x = DoublyLinkedList(a)
+                assert [x == other, x != other, x < other, x <= other, x > other, x >= other] == expected, (a, b)
+    try:
+        test_list < range(5)
+        assert False
+    except TypeError:
+        pass
+    nan = DoublyLinkedList([float("nan")])
+    assert nan == nan and nan != DoublyLinkedList([float("nan")])
+    class Mutator:
+        def __eq__(self, other):
+            test_list2.append(5)
+            return True
+    try:
+        test_list2 == [Mutator()] * 4
+        assert False
+    except RuntimeError:
+        pass
+    strs = DoublyLinkedList(["a", "é", "\U0001F600", "a", 2**70, 1.5, 3])
+    assert strs.count("a") == 2 and strs.index("\U0001F600") == 2 and strs.index(2**70) == 4
+    assert 1.5 in strs and 3.0 in strs and "b" not in strs
+
+def test_contains():
+    test_list = DoublyLinkedList([DummyClass(1), [1, 2], "abc", 2**70, 1.5])
+    assert [1, 2] in test_list and "ab" + "c" in test_list and 2**70 in test_list
+    assert 1.5 in test_list and 3 / 2 in test_list and test_list[0] in test_list
+    assert DummyClass(1) not in test_list and [1] not in test_list and 1.5 not in DoublyLinkedList()
+    nan = float("nan")
+    assert nan in DoublyLinkedList([nan]) and float("nan") not in DoublyLinkedList([nan])
+
+    class Mutator:
+        def __eq__(self, other):
+            test_list.append(5)
+            return False
+    try:
+        Mutator() in test_list
+        assert False
+    except RuntimeError:
+        pass
+    class Failing:
+        def __eq__(self, other):
+            raise ValueError
+    try:
+        Failing() in test_list
+        assert False
+    except ValueError:
+        pass
+
+def test_node_pool():
+    test_list = DoublyLinkedList(range(10000))
+    capacity = node_pool_stats()["capacity"]
+    in_use = node_pool_stats()["in_use"]
+    for i in range(5000):
+        test_list.pop()
+    assert node_pool_stats()["in_use"] == in_use - 5000
+    test_list.extend(range(5000))
+    assert list(test_list) == list(range(5000)) + list(range(5000))
+    test_list.clear()
+    del test_list
+    assert shrink_node_pool() > 0
+    stats = node_pool_stats()
+    assert stats["capacity"] < capacity
+    assert stats["capacity"] - stats["free"] == stats["in_use"]
+    # Nodes cached by a thread on free-threaded builds go back to the pool when it exits
+    def churn():
+        thread_list = DoublyLinkedList()
+        for i in range(1000):
+            thread_list.append(i)
+            if i % 3:
+                thread_list.pop(0)
+    in_use = node_pool_stats()["in_use"]
+    threads = [threading.Thread(target=churn) for i in range(4)]
+    for thread in threads:
+        thread.start()
+    for thread in threads:
+        thread.join()
+    assert node_pool_stats()["in_use"] == in_use
+
+def test_unrolled():
+    for block_size in (4, 7, 32):
+        test_list = UnrolledLinkedList(range(100), block_size=block_size)
+        model = list(range(100))
+        assert test_list.block_size == block_size
+        for i in range(0, 200, 3):
+            test_list.insert(-i, i % len(model))
+            model.insert(i % len(model) + 1, -i)
+            test_list.insert(i, 0, False)
+            model.insert(0, i)
+        assert list(test_list) == model
+        for i in range(0, 150):
+            assert test_list.pop((i * 7) % len(model)) == model.pop((i * 7) % len(model))
+        assert list(test_list) == model
+        assert list(reversed(test_list)) == model[::-1]
+        assert list(test_list[3:50:4]) == model[3:50:4]
+        assert list(test_list[::-3]) == model[::-3]
+        assert test_list.index(model[40], 10) == model.index(model[40], 10)
+        assert test_list.count(model[5]) == model.count(model[5])
+        test_list.reverse()
+        model.reverse()
+        assert test_list == model
+        test_list.sort(key=lambda x: -x)
+        model.sort(key=lambda x: -x)
+        assert test_list == model
+        test_list.sort(abs, True)
+        model.sort(key=abs, reverse=True)
+        assert test_list == model
+        test_list.sort(None)
+        model.sort()
+        assert test_list == model
+        del test_list[5]
+        del model[5]
+        test_list[-1] = "end"
+        model[-1] = "end"
+        assert str(test_list) == str(model)
+        for index in (-len(model) - 1, len(model)):
+            for access in (lambda: test_list.__setitem__(index, 0), lambda: test_list.__delitem__(index)):
+                try:
+                    access()
+                    assert False
+                except IndexError:
+                    pass
+        assert str(test_list) == str(model)
+        assert test_list.copy() + [1] == model + [1]
+        test_list.clear()
+        assert len(test_list) == 0 and list(test_list) == []
+    try:
+        UnrolledLinkedList(block_size=1)
+        assert False
+    except ValueError:
+        pass
+    test_list = UnrolledLinkedList(range(10), block_size=4)
+    test_list.extend(test_list)
+    test_list += test_list
+    test_list.extend(test_list, False)
+    assert list(test_list) == list(range(9, -1, -1)) * 4 + list(range(10)) * 4
+    assert test_list + test_list == list(test_list) * 2
+    values = [[], [1], [1, 2], [2], [1, 2.5], ["a"], list(range(20)), list(range(19)) + [30]]
+    for a in values:
+        for b in values:
+            try:
+                expected = [a == b, a != b, a < b, a <= b, a > b, a >= b]
+            except TypeError:
+                continue
+            for other in (UnrolledLinkedList(b, block_size=4), b, tuple(b)):
+                x = UnrolledLinkedList(a, block_size=4)
+                assert [x == other, x != other, x < other, x <= other, x > other, x >= other] == expected, (a, b)
+    try:
+        UnrolledLinkedList([1]) < range(2)
+        assert False
+    except TypeError:
+        pass
+    for bad in ((1,), (None, False, None)):
+        try:
+            UnrolledLinkedList([2, 1]).sort(*bad)
+            assert False
+        except TypeError:
+            pass
+    assert sys.getsizeof(UnrolledLinkedList(range(1000))) < sys.getsizeof(DoublyLinkedList(range(1000)))
+    for block_size in (4, 5):
+        for start in (None, 0, 3, 9, -6, 40):
+            for stop in (None, 2, 11, -1, 30):
+                for step in (None, 1, 2, -3):
+                    for size in (0, 1, 6, 13):
+                        test_list = UnrolledLinkedList(range(30), block_size=block_size)
+                        model = list(range(30))
+                        index = slice(start, stop, step)
+                        del test_list[index]
+                        del model[index]
+                        assert test_list == model
+                        values = [f"v{i}" for i in range(size)]
+                        try:
+                            model[index] = values
+                        except ValueError:
+                            try:
+                                test_list[index] = values
+                                assert False
+                            except ValueError:
+                                pass
+                        else:
+                            test_list[index] = values
+                        assert test_list == model and len(test_list) == len(model)
+                        test_list.append("end")
+                        test_list.insert(0, 0, False)
+                        assert test_list == [0] + model + ["end"]
+    test_list = UnrolledLinkedList(range(10), block_size=4)
+    test_list[2:5] = test_list
+    assert test_list == [0, 1] + list(range(10)) + [5, 6, 7, 8, 9]
+    try:
+        test_list[1:3] = 5
+        assert False
+    except TypeError:
+        pass
+    test_list = UnrolledLinkedList([3, 1, 3, 3, 2, 3], block_size=4)
+    test_list.remove(3, 1, 5)
+    assert test_list == [3, 1, 3, 2, 3]
+    test_list.remove(3, -2)
+    assert test_list == [3, 1, 3, 2]
+    try:
+        test_list.remove(1, 2, 4)
+        assert False
+    except ValueError:
+        pass
+
+def test_splice_split():
+    for indexed in (False, True):
+        test_list = DoublyLinkedList(range(10), indexed=indexed)
+        other = DoublyLinkedList(range(100, 105))
+        handle = other.node_at(2)
+        test_list.splice(other, 3)
+        model = list(range(4)) + list(range(100, 105)) + list(range(4, 10))
+        assert list(test_list) == model
+        assert len(other) == 0 and list(other) == []
+        assert test_list.remove_node(handle) == 102
+        model.remove(102)
+        tail = test_list.split(-4)
+        assert list(test_list) == model[:-4] and list(tail) == model[-4:]
+        assert tail.indexed == indexed
+        assert [tail[i] for i in range(len(tail))] == model[-4:]
+        test_list.splice(tail, 0, False)
+        assert list(test_list) == model[-4:] + model[:-4]
+        test_list.splice(DoublyLinkedList([1, 2]), forward=False)
+        assert list(reversed(test_list)) == ([1, 2] + model[-4:] + model[:-4])[::-1]
+        assert list(test_list.split(len(test_list))) == []
+        try:
+            test_list.splice(test_list)
+            assert False
+        except ValueError:
+            pass
+        try:
+            test_list.split(len(test_list) + 1)
+            assert False
+        except IndexError:
+            pass
+
+def test_slices():
+    for indexed in (False, True):
+        test_list = DoublyLinkedList(range(20), indexed=indexed)
+        model = list(range(20))
+        for s in (slice(2, 15, 3), slice(None, None, -2), slice(-3, 2, -4), slice(5, 100), slice(30, 40)):
+            assert list(test_list[s]) == model[s]
+        test_list[3:7] = ["a", "b"]
+        model[3:7] = ["a", "b"]
+        assert list(test_list) == model
+        test_list[0:0] = range(3)
+        model[0:0] = range(3)
+        test_list[len(model):] = [-1]
+        model[len(model):] = [-1]
+        assert list(test_list) == model
+        test_list[::-3] = range(len(model[::-3]))
+        model[::-3] = range(len(model[::-3]))
+        assert list(test_list) == model
+        del test_list[1::4]
+        del model[1::4]
+        assert list(test_list) == model
+        del test_list[-2:2:-5]
+        del model[-2:2:-5]
+        assert list(test_list) == model
+        test_list[2:] = test_list
+        model[2:] = model
+        assert list(test_list) == model
+        assert list(reversed(test_list)) == model[::-1]
+        assert [test_list[i] for i in range(len(model))] == model
+        handle = test_list.node_at(4)
+        del test_list[3:6]
+        assert not handle.valid
+        try:
+            test_list[::2] = [1]
+            assert False
+        except ValueError:
+            pass
+
+def test_bulk_extend():
+    for indexed in (False, True):
+        test_list = DoublyLinkedList(indexed=indexed)
+        model = []
+        for source in (list, tuple, DoublyLinkedList, iter, lambda items: (item for item in items)):
+            test_list.extend(source(range(50)))
+            model.extend(range(50))
+            test_list.extend(source(range(5)), False)
+            model[0:0] = [4, 3, 2, 1, 0]
+        assert list(test_list) == model
+        assert [test_list[i] for i in range(len(model))] == model
+        test_list.extend(test_list)
+        model.extend(model)
+        assert list(test_list) == model
+    def failing():
+        yield 1
+        yield 2
+        raise KeyError
+    test_list = DoublyLinkedList([0])
+    try:
+        test_list.extend(failing())
+        assert False
+    except KeyError:
+        pass
+    assert list(test_list) == [0, 1, 2]
+
+def test_threads():
+    shared = DoublyLinkedList(indexed=True)
+    cache = LRUCache(64)
+    unrolled = UnrolledLinkedList()
+    other = DoublyLinkedList()
+    errors = []
+    def worker(seed):
+        try:
+            work(seed)
+        except Exception as error:
+            errors.append(error)
+    def work(seed):
+        handles = []
+        for i in range(2000):
+            shared.append(i)
+            handles.append(shared.append_node(-i, False))
+            unrolled.append(i)
+            cache[(seed, i % 100)] = i
+            cache.get((seed, (i * 7) % 100))
+            if i % 3 == 0:
+                shared.pop()
+                unrolled.pop(0)
+            if i % 5 == 0:
+                shared.remove_node(handles.pop())
+            if i % 50 == 0:
+                other.extend(range(10))
+                shared.splice(other)
+                len(shared[::7])
+                try:
+                    list(reversed(shared))
+                except RuntimeError:
+                    pass # Other threads changed the list while iterating
+    threads = [threading.Thread(target=worker, args=(seed,)) for seed in range(8)]
+    for thread in threads:
+        thread.start()
+    for thread in threads:
+        thread.join()
+    assert errors == []
+    per_thread = 2000 * 2 - 667 - 400 + 40 * 10
+    assert len(shared) == 8 * per_thread == len(list(shared))
+    assert [shared[i] for i in range(0, len(shared), 101)] == list(shared)[::101]
+    assert len(unrolled) == 8 * (2000 - 667)
+    assert len(cache) == 64 and len(other) == 0
+
+def test_threads_sequence_fast():
+    source = list(range(100))
+    target = DoublyLinkedList(range(10))
+    errors = []
+    def worker(seed):
+        try:
+            for i in range(2000):
+                if seed % 2:
+                    source.append(i)
+                    source.pop(0)
+                    source.extend(range(5))
+                    del source[-5:]
+                else:
+                    target.extend(source)
+                    target[0:len(target)] = source
+                    try:
+                        target[::2] = source
+                    except ValueError:
+                        pass # The source was being resized
+        except Exception as error:
+            errors.append(error)
+    threads = [threading.Thread(target=worker, args=(seed,)) for seed in range(4)]
+    for thread in threads:
+        thread.start()
+    for thread in threads:
+        thread.join()
+    assert errors == []
+    assert len(source) == 100 and 100 <= len(target) <= 105
+
+def test_linked_queue():
+    q = LinkedQueue(maxsize=3)
+    for i in range(3):
+        q.put_nowait(i)
+    assert q.full() and len(q) == 3 and q.maxsize == 3
+    try:
+        q.put(3, timeout=0.01)
+        assert False
+    except queue.Full:
+        pass
+    assert q.get() == 0
+    assert q.get_many(5) == [1, 2]
+    assert q.empty()
+    try:
+        q.get_nowait()
+        assert False
+    except queue.Empty:
+        pass
+    try:
+        q.get(timeout=-1)
+        assert False
+    except ValueError:
+        pass
+    results = []
+    def consumer():
+        while True:
+            items = q.get_many(10)
+            results.extend(items)
+            if None in items:
+                q.put(None) # Pass the sentinel on to the other consumer
+                return
+    threads = [threading.Thread(target=consumer) for i in range(2)]
+    for thread in threads:
+        thread.start()
+    for i in range(10000):
+        q.put(i)
+    q.put(None)
+    for thread in threads:
+        thread.join()
+    assert sorted(item for item in results if item is not None) == list(range(10000))
+    assert q.get_nowait() is None and q.empty()
+
+def test_gc():
+    gc.collect()
+    in_use = node_pool_stats()["in_use"]
+    owner = DummyClass(0)
+    test_list = DoublyLinkedList(range(1_000_000))
+    test_list.append(owner)
+    owner.list = test_list
+    handle = test_list.node_at(10)
+    owner.handle = handle
+    owner.iterator = iter(test_list)
+    reference = weakref.ref(owner)
+    del owner, test_list, handle
+    gc.collect()
+    assert reference() is None
+    assert node_pool_stats()["in_use"] == in_use
+    for make in (lambda: UnrolledLinkedList(range(1_000_000)), lambda: LinkedQueue(), lambda: LRUCache(None)):
+        owner = DummyClass(0)
+        container = make()
+        if isinstance(container, UnrolledLinkedList):
+            container.append(owner)
+            owner.iterator = reversed(container)
+        elif isinstance(container, LinkedQueue):
+            container.put(owner)
+        else:
+            container[owner] = container
+            container.on_evict = lambda key, value: owner
+        owner.container = container
+        reference = weakref.ref(owner)
+        del owner, container
+        gc.collect()
+        assert reference() is None
+    # The collector has to see the detached chain of a running sort
+    test_list = DoublyLinkedList(DummyClass(i) for i in range(1000))
+    def key(item):
+        if item.id % 100 == 0:
+            gc.collect()
+        return -item.id
+    test_list.sort(key=key)
+    assert [item.id for item in test_list] == list(range(999, -1, -1))
+
+def test_deferred_release():
+    release_deferred()
+    test_list = DoublyLinkedList(DummyClass(i) for i in range(100_000))
+    reference = weakref.ref(test_list[-1])
+    handle = test_list.node_at(5)
+    test_list.clear(deferred=True)
+    assert len(test_list) == 0 and not handle.valid
+    assert node_pool_stats()["deferred"] == 100_000
+    test_list.extend(range(10))
+    assert list(test_list) == list(range(10))
+    assert release_deferred(30_000) == 70_000
+    assert reference() is not None
+    assert release_deferred(0) == 70_000
+    assert release_deferred() == 0
+    assert reference() is None
+    # Deeply nested lists are released without recursing once per level
+    nested = DoublyLinkedList()
+    for i in range(200_000):
+        nested = DoublyLinkedList([nested])
+    del nested
+
+def test_stats():
+    # The DLL_STATS environment variable marks a build with the counters, which must not skip this
+    reset_stats()
+    try:
+        stats()
+    except RuntimeError as error:
+        assert str(error) == "stats are only collected when the extension is built with DLL_STATS defined"
+        assert not os.environ.get("DLL_STATS")
+        return
+    test_list = DoublyLinkedList(range(100))
+    test_list.append(100)
+    test_list[50]
+    test_list[51]
+    test_list[2]
+    test_list[98]
+    test_list.sort(reverse=True)
+    counters = stats()
+    assert counters["node_allocs"] == 101
+    assert counters["peak_length"] == 101
+    assert counters["locate_cursor"] >= 1 and counters["steps_cursor"] >= 1
+    assert counters["locate_head"] >= 1 and counters["locate_tail"] >= 1
+    assert counters["sort_comparisons"] >= 100
+    del test_list
+    assert stats()["node_frees"] == 101
+    reset_stats()
+    assert all(value == 0 for value in stats().values())
+    # Threads building lists at once lose no counts
+    def build():
+        for i in range(20):
+            DoublyLinkedList(range(500))
+    threads = [threading.Thread(target=build) for i in range(4)]
+    for thread in threads:
+        thread.start()
+    for thread in threads:
+        thread.join()
+    counters = stats()
+    assert counters["node_allocs"] == counters["node_frees"] == 4 * 20 * 500
+    assert counters["peak_length"] == 500
+    reset_stats()
+
+def test_fingers():
+    # Interleaved work in several regions, checked against a list doing the same
+    test_list = DoublyLinkedList(range(1000))
+    model = list(range(1000))
+    regions = [100, 400, 700, 950]
+    for step in range(400):
+        region = regions[step % 4] + step % 7
+        assert test_list[region] == model[region]
+        if step % 3 == 0:
+            test_list.insert(-step, region, False)
+            model.insert(region, -step)
+        elif step % 3 == 1:
+            assert test_list.pop(region) == model.pop(region)
+        else:
+            test_list[region + 1] = step
+            model[region + 1] = step
+        test_list.append(step)
+        model.append(step)
+        assert test_list[-1] == model[-1]
+    assert list(test_list) == model
+    # Changes that aren't made through the cursor must not leave fingers pointing at the wrong node
+    test_list[100], test_list[800]
+    test_list.reverse()
+    model.reverse()
+    assert test_list[100] == model[100] and test_list[800] == model[800]
+    del test_list[50:150]
+    del model[50:150]
+    assert test_list[100] == model[100] and test_list[700] == model[700]
+    handle = test_list.node_at(600)
+    test_list[200], test_list[900]
+    test_list.insert_before(handle, "x")
+    model.insert(600, "x")
+    assert test_list[200] == model[200] and test_list[900] == model[900]
+    test_list.sort(key=str)
+    model.sort(key=str)
+    assert test_list[300] == model[300] and list(test_list) == model
+
+def test_typed_lists():
+    ints = DoublyLinkedListI64(range(-500, 500), block_size=8)
+    model = list(range(-500, 500))
+    ints.insert(7, 10, False); model.insert(10, 7)
+    ints.append(2**63 - 1); model.append(2**63 - 1)
+    ints.append(-2**63, False); model.insert(0, -2**63)
+    assert ints.pop(3) == model.pop(3)
+    del ints[100]; del model[100]
+    ints[5] = 42; model[5] = 42
+    ints.remove(0); model.remove(0)
+    assert ints == model and list(reversed(ints)) == model[::-1] and ints[10:400:7] == model[10:400:7]
+    assert ints.count(7) == model.count(7) == 2 and ints.count(7.0) == 2 and ints.count(7.5) == 0 and ints.count("7") == 0
+    assert ints.index(42) == 5 and ints.index(7, 20) == model.index(7, 20) and 2**70 not in ints
+    assert ints.sum() == sum(model) and ints.min() == -2**63 and ints.max() == 2**63 - 1
+    ints.sort(reverse=True); model.sort(reverse=True)
+    assert ints == model
+    ints.sort(key=abs); model.sort(key=abs)
+    assert ints == model and str(ints) == str(model)
+    for index in (-len(model) - 1, len(model)):
+        for access in (lambda: ints.__setitem__(index, 0), lambda: ints.__delitem__(index)):
+            try:
+                access()
+                assert False
+            except IndexError:
+                pass
+    assert ints == model
+    try:
+        ints.append(2**63)
+        assert False
+    except OverflowError:
+        pass
+    try:
+        ints.append(1.5)
+        assert False
+    except TypeError:
+        pass
+    floats = DoublyLinkedListF64(array.array("d", [0.5, -1.5, 2.25]))
+    floats.extend([1, 2**53])
+    assert floats == [0.5, -1.5, 2.25, 1.0, 2.0**53] and floats.count(2**53) == 1 and floats.count(2**53 + 1) == 0
+    assert floats.sum() == sum(floats) and floats.min() == -1.5 and floats.max() == 2.0**53
+    assert DoublyLinkedListF64([float("nan"), 1.0]).min() != 1.0 and DoublyLinkedListF64([1.0, float("nan")]).min() == 1.0
+    # The buffer is a read-only copy and the list can't change while it is held
+    view = memoryview(floats)
+    assert view.format == "d" and view.readonly and view.tolist() == list(floats)
+    try:
+        floats.append(1.0)
+        assert False
+    except BufferError:
+        pass
+    view.release()
+    floats.append(1.0)
+    assert memoryview(DoublyLinkedListI64(range(3))).cast("B").cast("q").tolist() == [0, 1, 2]
+    copy = floats.copy()
+    copy.extend(copy)
+    assert len(copy) == 2 * len(floats) and type(copy) is DoublyLinkedListF64
+    nan = float("nan")
+    values = [[], [1], [1, 2], [2], [-2**63, 5], [2**63 - 1], [1.5], [nan], [1, nan], list(range(20)), list(range(19)) + [30]]
+    for a in values:
+        for b in values:
+            # Typed lists store raw values, so a nan is never the same object as another
+            fresh = [item if item == item else float("nan") for item in b]
+            expected = [a == fresh, a != fresh, a < fresh, a <= fresh, a > fresh, a >= fresh]
+            typed = [cls(v, block_size=4) for cls in (DoublyLinkedListI64, DoublyLinkedListF64) for v in (a, b)
+                     if (all(type(item) is int for item in a + b) if cls is DoublyLinkedListI64 else all(abs(item) < 2**53 or item != item for item in a + b))]
+            for x, y in zip(typed[::2], typed[1::2]):
+                for other in (y, b, tuple(b)):
+                    assert [x == other, x != other, x < other, x <= other, x > other, x >= other] == expected, (type(x), a, b)
+    assert DoublyLinkedListI64([1, 2]) < DoublyLinkedListF64([1, 2.5]) and DoublyLinkedListF64([3]) >= DoublyLinkedListI64([2, 9])
+    try:
+        DoublyLinkedListI64([1]) < range(2)
+        assert False
+    except TypeError:
+        pass
+    copy = DoublyLinkedListI64(range(5), block_size=4)
+    copy.extend(copy, False)
+    copy.extend(DoublyLinkedListI64([7, 8]), False)
+    assert copy == [8, 7, 4, 3, 2, 1, 0, 0, 1, 2, 3, 4]
+    try:
+        DoublyLinkedListI64().max()
+        assert False
+    except ValueError:
+        pass
+    for cls in (DoublyLinkedListI64, DoublyLinkedListF64):
+        for start in (None, 0, 3, -6, 40):
+            for stop in (None, 2, 11, -1):
+                for step in (None, 1, 2, -3):
+                    for size in (0, 1, 6, 13):
+                        typed = cls(range(30), block_size=4)
+                        model = list(range(30))
+                        index = slice(start, stop, step)
+                        del typed[index]
+                        del model[index]
+                        assert typed == model
+                        values = list(range(100, 100 + size))
+                        try:
+                            model[index] = values
+                        except ValueError:
+                            try:
+                                typed[index] = cls(values)
+                                assert False
+                            except ValueError:
+                                pass
+                        else:
+                            typed[index] = values if size % 2 else cls(values)
+                        assert typed == model and len(typed) == len(model)
+                        typed.append(-1)
+                        typed.append(-2, False)
+                        assert typed == [-2] + model + [-1]
+    typed = DoublyLinkedListI64(range(10), block_size=4)
+    typed[2:5] = typed
+    assert typed == [0, 1] + list(range(10)) + [5, 6, 7, 8, 9]
+    # A value that can't be converted leaves the list as it was
+    for bad in ([1, "a"], [1, 2**63], 5):
+        try:
+            typed[1:3] = bad
+            assert False
+        except (TypeError, OverflowError):
+            pass
+    assert typed == [0, 1] + list(range(10)) + [5, 6, 7, 8, 9]
+    view = memoryview(typed)
+    for change in (lambda: typed.__setitem__(slice(0, 2), [1]), lambda: typed.__delitem__(slice(0, 2))):
+        try:
+            change()
+            assert False
+        except BufferError:
+            pass
+    view.release()
+    typed = DoublyLinkedListF64([3, 1, 3, 3, 2, 3], block_size=4)
+    typed.remove(3, 1, 5)
+    assert typed == [3, 1, 3, 2, 3]
+    typed.remove(3.0, -2)
+    assert typed == [3, 1, 3, 2]
+    try:
+        typed.remove(1, 2, 4)
+        assert False
+    except ValueError:
+        pass
+
+def test_pickle():
+    lists = [DoublyLinkedList([1, "a", None, (2, 3)]), DoublyLinkedList(range(3000), indexed=True), UnrolledLinkedList(range(100), block_size=8),
+             DoublyLinkedListI64(range(-5, 5)), DoublyLinkedListF64([0.5, -1.5], block_size=16), DoublyLinkedList()]
+    for protocol in range(pickle.HIGHEST_PROTOCOL + 1):
+        for lst in lists:
+            restored = pickle.loads(pickle.dumps(lst, protocol))
+            assert type(restored) is type(lst)
+            assert list(restored) == list(lst)
+    assert pickle.loads(pickle.dumps(lists[1])).indexed
+    assert pickle.loads(pickle.dumps(lists[2])).block_size == 8
+    nested = DoublyLinkedList([[1], [2]])
+    deep = copy.deepcopy(nested)
+    assert deep == nested and deep[0] is not nested[0]
+    cyclic = DoublyLinkedList([1])
+    cyclic.append(cyclic)
+    restored = pickle.loads(pickle.dumps(cyclic))
+    assert restored[1] is restored
+
+    file = io.BytesIO()
+    lists[1].dump(file, chunk_size=100)
+    file.seek(0)
+    restored = DoublyLinkedList.load(file)
+    assert restored.indexed and list(restored) == list(range(3000))
+    file = io.BytesIO()
+    DoublyLinkedList().dump(file)
+    file.seek(0)
+    assert DoublyLinkedList.load(file) == DoublyLinkedList()
+    for data in (b"", b"not a dump", b"PDLL\x01\x00\x00\x00\x05\x00\x00\x00\x00\x00\x00\x00ab"):
+        try:
+            DoublyLinkedList.load(io.BytesIO(data))
+            assert False
+        except (EOFError, ValueError):
+            pass
+    try:
+        lists[0].dump(io.BytesIO(), chunk_size=0)
+        assert False
+    except ValueError:
+        pass
+
+    class Mutator:
+        def __reduce__(self):
+            lst.append(1)
+            return (int, (1,))
+    lst = DoublyLinkedList([Mutator(), 2])
+    try:
+        lst.dump(io.BytesIO())
+        assert False
+    except RuntimeError:
+        pass
+
+def test_mapped():
+    directory = tempfile.mkdtemp()
+    path = os.path.join(directory, "list.dll")
+    values = [None, True, False, -2**63, 2**63 - 1, 0.5, b"bytes", "str \u00e9", "x" * 1000]
+    with MappedLinkedList(path, values) as lst:
+        assert list(lst) == values
+        assert list(reversed(lst)) == values[::-1]
+        lst.append("first", False)
+        lst.insert(1, 0)
+        lst.insert(2, 0, False)
+        assert lst.pop(0) == 2
+        assert lst.pop() == "x" * 1000
+        assert lst.pop(1) == 1
+        lst[0] = b"y" * 100
+        del lst[-1]
+        assert list(lst) == [b"y" * 100, None, True, False, -2**63, 2**63 - 1, 0.5, b"bytes"]
+        assert lst[-8] == b"y" * 100
+        for index in (-9, -10, 8):
+            for access in (lambda: lst[index], lambda: lst.__setitem__(index, 9), lambda: lst.__delitem__(index)):
+                try:
+                    access()
+                    assert False
+                except IndexError:
+                    pass
+        assert list(lst) == [b"y" * 100, None, True, False, -2**63, 2**63 - 1, 0.5, b"bytes"]
+        for bad in ([], 2**64, 1j):
+            try:
+                lst.append(bad)
+                assert False
+            except (TypeError, OverflowError):
+                pass
+        iterator = iter(lst)
+        lst.append(1)
+        try:
+            next(iterator)
+            assert False
+        except RuntimeError:
+            pass
+    assert lst.closed
+    try:
+        len(lst)
+        assert False
+    except ValueError:
+        pass
+
+    lst = MappedLinkedList(path)
+    assert list(lst) == [b"y" * 100, None, True, False, -2**63, 2**63 - 1, 0.5, b"bytes", 1]
+    lst.clear()
+    lst.extend(range(100000))
+    assert lst[50000] == 50000 and len(lst) == 100000
+    for i in range(1000):
+        assert lst.pop(0) == i
+    lst.close()
+    lst = MappedLinkedList(path)
+    assert len(lst) == 99000 and lst[0] == 1000 and lst[-1] == 99999
+    lst.close()
+
+    bad = os.path.join(directory, "bad")
+    with open(bad, "wb") as file:
+        file.write(b"x" * 1000)
+    try:
+        MappedLinkedList(bad)
+        assert False
+    except ValueError:
+        pass
+    os.remove(path)
+    os.remove(bad)
+    os.rmdir(directory)
+
+def test_repr():
+    lst = DoublyLinkedList([1, "a", None])
+    assert str(lst) == "[1, 'a', None]"
+    assert repr(lst) == "DoublyLinkedList([1, 'a', None])"
+    assert repr(DoublyLinkedList([1], indexed=True)) == "DoublyLinkedList([1], indexed=True)"
+    assert str(DoublyLinkedList()) == "[]"
+    lst.append(lst)
+    assert str(lst) == "[1, 'a', None, [...]]"
+    assert lst.repr_limited(2) == "DoublyLinkedList([1, 'a', ... (2 more)])"
+    assert lst.repr_limited(0) == "DoublyLinkedList([... (4 more)])"
+    assert DoublyLinkedList(range(100000)).repr_limited(3) == "DoublyLinkedList([0, 1, 2, ... (99997 more)])"
+    assert repr(UnrolledLinkedList([1, 2], block_size=8)) == "UnrolledLinkedList([1, 2], block_size=8)"
+    assert str(UnrolledLinkedList([1, 2])) == "[1, 2]"
+    assert repr(DoublyLinkedListI64([1, 2])) == "DoublyLinkedListI64([1, 2])"
+    assert DoublyLinkedListF64(range(5)).repr_limited(1) == "DoublyLinkedListF64([0.0, ... (4 more)])"
+    try:
+        lst.repr_limited(-1)
+        assert False
+    except ValueError:
+        pass
+
+    class Mutator:
+        def __repr__(self):
+            lst.append(1)
+            return "mutator"
+    lst = DoublyLinkedList([Mutator(), 2])
+    try:
+        repr(lst)
+        assert False
+    except RuntimeError:
+        pass
+
+def test_hashed():
+    values = [i % 50 for i in range(500)] + ["a", "b", 2.0, None]
+    lst = DoublyLinkedList(values, hashed=True)
+    model = list(values)
+    assert lst.hashed and not DoublyLinkedList().hashed
+    assert 49 in lst and 50 not in lst and "a" in lst and None in lst
+    assert lst.count(2) == model.count(2) and lst.index(2.0) == model.index(2.0)
+    for step in range(300):
+        value = (step * 7) % 60
+        if step % 3 == 0 and value in model:
+            lst.remove(value)
+            model.remove(value)
+        elif step % 3 == 1:
+            lst.insert(value, step % len(model))
+            model.insert(step % len(model) + 1, value)
+        else:
+            lst[step % len(model)] = value
+            model[step % len(model)] = value
+        assert lst.count(value) == model.count(value)
+        assert (value in lst) == (value in model)
+    assert list(lst) == model
+    # Bulk changes only mark the table stale
+    lst.sort(key=str)
+    model.sort(key=str)
+    del lst[::3]
+    del model[::3]
+    lst[10:20] = ["x"] * 5
+    model[10:20] = ["x"] * 5
+    assert lst.count("x") == 5 and lst.index("x") == model.index("x") and lst.index(model[40]) == model.index(model[40])
+    tail = lst.split(50)
+    assert tail.hashed and tail.count(model[60]) == model[50:].count(model[60])
+    lst.splice(tail)
+    assert list(lst) == model and lst.count(model[0]) == model.count(model[0])
+    node = lst.node_at(3)
+    node.value = "node"
+    assert "node" in lst and lst.index("node") == 3
+    # Equal items stay in list order, so index and remove find the first one
+    for indexed in (False, True):
+        lst = DoublyLinkedList([i % 3 for i in range(30)], hashed=True, indexed=indexed)
+        model = [i % 3 for i in range(30)]
+        assert lst.count(0) == 10
+        lst.insert(0, 15)
+        model.insert(16, 0)
+        lst.append(1, False)
+        model.insert(0, 1)
+        lst.reverse()
+        model.reverse()
+        lst.move_to_end(lst.node_at(len(model) - 1), False)
+        model.insert(0, model.pop())
+        lst.move_to_end(lst.node_at(5))
+        model.append(model.pop(5))
+        while model:
+            value = model[len(model) // 2]
+            assert lst.index(value) == model.index(value) and lst.count(value) == model.count(value)
+            lst.remove(value)
+            model.remove(value)
+            assert list(lst) == model
+        assert 0 not in lst and lst.count(1) == 0
+    # Unhashable items fall back to comparing every item
+    lst = DoublyLinkedList([1, [2], 3], hashed=True, indexed=True)
+    assert [2] in lst and 3 in lst and lst.index(3) == 2
+    lst.remove([2])
+    assert list(lst) == [1, 3] and lst.count(3) == 1
+    assert repr(lst) == "DoublyLinkedList([1, 3], indexed=True, hashed=True)"
+    copied = pickle.loads(pickle.dumps(lst))
+    assert copied.hashed and copied.indexed and 3 in copied and lst.copy().hashed
+
+    class Mutator:
+        def __hash__(self):
+            lst.append(1)
+            return 0
+    lst = DoublyLinkedList([1, 2], hashed=True)
+    try:
+        lst.append(Mutator())
+        assert False
+    except RuntimeError:
+        pass
+    assert list(lst) == [1, 2, 1]
+
+    class EqualMutator:
+        def __hash__(self):
+            return hash(1)
+        def __eq__(self, other):
+            lst.pop()
+            return True
+    lst = DoublyLinkedList([1, 2], hashed=True)
+    try:
+        lst.append(EqualMutator())
+        assert False
+    except RuntimeError:
+        pass
+    assert list(lst) == [1]
+
+def test_repeat():
+    items = [1, "a", None, DummyClass(3)]
+    test_list = DoublyLinkedList(items)
+    for times in (-2, 0, 1, 3):
+        assert list(test_list * times) == items * times
+        assert list(times * test_list) == items * times
+    assert list(DoublyLinkedList() * 5) == []
+    value = DummyClass(0)
+    refcount = sys.getrefcount(value)
+    repeated = DoublyLinkedList([value]) * 1000
+    assert sys.getrefcount(value) == refcount + 1000 and repeated[999] is value
+    del repeated
+    assert sys.getrefcount(value) == refcount
+    alias = test_list
+    test_list *= 3
+    assert alias is test_list and list(test_list) == items * 3 and test_list[-1] is items[-1]
+    test_list *= 0
+    assert list(alias) == []
+    hashed = DoublyLinkedList([1, 2, 2], hashed=True, indexed=True) * 2
+    assert hashed.hashed and hashed.indexed and hashed.count(2) == 4 and hashed[4] == 2
+    test_list = DoublyLinkedList(range(10))
+    try:
+        test_list *= 10**12
+        assert False
+    except MemoryError:
+        pass
+    try:
+        test_list * sys.maxsize
+        assert False
+    except MemoryError:
+        pass
+    assert list(test_list) == list(range(10))
+    # A repeat that runs out of memory part way gives back only the slabs it grew
+    script = """if True:
+        import resource
+        from py_doubly_linked_list import DoublyLinkedList, node_pool_stats
+        kept = DoublyLinkedList(range(1000))
+        slabs = node_pool_stats()["slabs"]
+        resource.setrlimit(resource.RLIMIT_AS, (1 << 30, 1 << 30))
+        try:
+            DoublyLinkedList(range(10)) * 10**8
+            assert False
+        except MemoryError:
+            pass
+        assert node_pool_stats()["slabs"] == slabs and list(kept) == list(range(1000))
+    """
+    if sys.platform.startswith("linux"):
+        subprocess.run([sys.executable, "-c", script], check=True)
+
+def test_cursor():
+    test_list = DoublyLinkedList("abcde")
+    cursor = test_list.cursor(1)
+    assert isinstance(cursor, Cursor) and cursor.value == "b" and cursor.pos == 1
+    cursor.next()
+    cursor.insert_before("x")
+    cursor.insert_after("y")
+    assert cursor.value == "c" and cursor.pos == 3
+    assert list(test_list) == ["a", "b", "x", "c", "y", "d", "e"]
+    assert cursor.delete() == "c" and cursor.value == "y"
+    cursor.value = "z"
+    cursor.prev()
+    assert cursor.value == "x" and test_list[3] == "z"
+    end = test_list.cursor(len(test_list))
+    assert end.pos == 6
+    try:
+        end.value
+        assert False
+    except IndexError:
+        pass
+    end.insert_before("f")
+    end.prev()
+    assert end.value == "f" and end.pos == 6 and test_list[-1] == "f"
+    assert end.delete() == "f" and end.pos == 6
+    other = test_list.cursor(-1)
+    test_list.insert("w", 0, False)
+    test_list.pop(4)
+    assert cursor.value == "x" and cursor.pos == 3 and other.value == "e" and other.pos == 5
+    test_list.remove("x")
+    assert not cursor.valid
+    try:
+        cursor.next()
+        assert False
+    except ValueError:
+        pass
+    try:
+        test_list.cursor(7)
+        assert False
+    except IndexError:
+        pass
+    indexed = DoublyLinkedList(range(100), indexed=True, hashed=True)
+    cursors = [indexed.cursor(i) for i in range(0, 100, 10)]
+    indexed.sort(reverse=True)
+    assert [c.pos for c in cursors] == [99 - i for i in range(0, 100, 10)]
+    for c in cursors:
+        c.delete()
+    assert 50 not in indexed and len(indexed) == 90 and indexed[0] == 99
+    empty = DoublyLinkedList()
+    cursor = empty.cursor()
+    for i in range(3):
+        cursor.insert_before(i)
+    assert list(empty) == [0, 1, 2] and cursor.pos == 3
+    # Positions are looked up again after other changes, walking out from the node
+    plain = DoublyLinkedList(DummyClass(i) for i in range(1000))
+    cursors = [plain.cursor(i) for i in range(0, 1000, 37)]
+    for step in range(20):
+        plain.insert(DummyClass(-step), (step * 131) % len(plain))
+        plain.pop((step * 71) % len(plain))
+        plain[(step * 313) % len(plain)]
+        if step % 7 == 0:
+            plain.reverse()
+        items = list(plain)
+        assert all(c.pos == items.index(c.value) for c in cursors if c.valid)
+    # Inserts and deletes anywhere shift the positions of all cursors, checked against a list doing the same
+    for indexed in (False, True):
+        shifted = DoublyLinkedList(range(50), indexed=indexed)
+        model = list(range(50))
+        cursors = [shifted.cursor(i) for i in range(0, 51, 5)]
+        targets = [model[i] if i < 50 else None for i in range(0, 51, 5)]
+        for step in range(300):
+            at = (step * 37) % (len(model) + 1)
+            if step % 3 == 0 and len(model) > 10:
+                at %= len(model)
+                assert shifted.pop(at) == model.pop(at)
+            elif step % 5 == 0:
+                shifted.extend([1000 + step, 2000 + step])
+                model.extend([1000 + step, 2000 + step])
+            elif step % 4 == 0:
+                shifted.remove(model[at % len(model)])
+                model.remove(model[at % len(model)])
+            else:
+                at %= len(model)
+                shifted.insert(-step, at, False)
+                model.insert(at, -step)
+            if step % 50 == 0:
+                # Through a cursor that is still valid, the end cursor always is
+                mover = next(i for i, c in enumerate(cursors) if c.valid)
+                cursors[mover].insert_before(3000 + step)
+                target = targets[mover]
+                model.insert(len(model) if target is None else model.index(target), 3000 + step)
+            for c, target in zip(cursors, targets):
+                if target is None:
+                    assert c.pos == len(model)
+                elif target in model:
+                    assert c.valid and c.pos == model.index(target) and c.value == target
+                else:
+                    assert not c.valid
 
 if __name__ == "__main__":
     test_indexing()
     test_length()
     test_dereferencing()
+    test_pop_references()
+    test_index_bounds()
     test_sort()
-    test_rich_compare()
\ No newline at end of file
+    test_sort_stable()
+    test_sort_error()
+    test_iteration()
+    test_node_handles()
+    test_lru_cache()
+    test_indexed()
+    test_rich_compare()
+    test_contains()
+    test_node_pool()
+    test_unrolled()
+    test_splice_split()
+    test_slices()
+    test_bulk_extend()
+    test_threads()
+    test_threads_sequence_fast()
+    test_linked_queue()
+    test_gc()
+    test_deferred_release()
+    test_stats()
+    test_fingers()
+    test_typed_lists()
+    test_pickle()
+    test_mapped()
+    test_repr()
+    test_hashed()
+    test_repeat()
+    test_cursor()